@@ -86,7 +86,7 @@ static void reset_channel(struct channel *);
 static bool check_device_type(struct disk *);
 static void identify_ata_device(struct disk *);
 
-static void select_sector(struct disk *, disk_sector_t);
+static void select_sector(struct disk *, disk_sector_t, size_t cnt);
 static void issue_pio_command(struct channel *, uint8_t command);
 static void input_sector(struct channel *, void *);
 static void output_sector(struct channel *, const void *);
@@ -230,21 +230,49 @@ disk_sector_t disk_size(struct disk *d)
    내부적으로 디스크에 대한 액세스를 동기화하므로 외부의 디스크별
    잠금이 필요하지 않습니다. */
 void disk_read(struct disk *d, disk_sector_t sec_no, void *buffer)
+{
+	ASSERT(buffer != NULL);
+
+	disk_read_multiple(d, sec_no, &buffer, 1);
+}
+
+/* Reads the CNT sectors starting at SEC_NO from disk D, with a
+   single command, into SECTORS[0] through SECTORS[CNT - 1], each
+   of which must have room for DISK_SECTOR_SIZE bytes.  CNT must
+   be between 1 and DISK_MULTIPLE_MAX.
+   Internally synchronizes accesses to disks, so external
+   per-disk locking is unneeded. */
+/* 디스크 D에서 SEC_NO부터 CNT개의 섹터를 명령 하나로 SECTORS[0]부터
+   SECTORS[CNT - 1]까지로 읽습니다. 각 버퍼에는 DISK_SECTOR_SIZE
+   바이트를 위한 공간이 있어야 합니다. CNT는 1 이상 DISK_MULTIPLE_MAX
+   이하여야 합니다.
+   내부적으로 디스크에 대한 액세스를 동기화하므로 외부의 디스크별
+   잠금이 필요하지 않습니다. */
+void disk_read_multiple(struct disk *d, disk_sector_t sec_no,
+						void *const sectors[], size_t cnt)
 {
 	struct channel *c;
+	size_t i;
 
 	ASSERT(d != NULL);
-	ASSERT(buffer != NULL);
+	ASSERT(cnt >= 1 && cnt <= DISK_MULTIPLE_MAX);
 
 	c = d->channel;
 	lock_acquire(&c->lock);
-	select_sector(d, sec_no);
+	select_sector(d, sec_no, cnt);
 	issue_pio_command(c, CMD_READ_SECTOR_RETRY);
-	sema_down(&c->completion_wait);
-	if (!wait_while_busy(d))
-		PANIC("%s: disk read failed, sector=%" PRDSNu, d->name, sec_no);
-	input_sector(c, buffer);
-	d->read_cnt++;
+
+	/* The disk interrupts once per sector, when it is ready. */
+	/* 디스크는 섹터마다 준비되면 한 번씩 인터럽트를 겁니다. */
+	for (i = 0; i < cnt; i++)
+	{
+		sema_down(&c->completion_wait);
+		if (!wait_while_busy(d))
+			PANIC("%s: disk read failed, sector=%" PRDSNu,
+				  d->name, sec_no + (disk_sector_t)i);
+		input_sector(c, sectors[i]);
+	}
+	d->read_cnt += cnt;
 	lock_release(&c->lock);
 }
 
@@ -254,21 +282,50 @@ void disk_read(struct disk *d, disk_sector_t sec_no, void *buffer)
    Internally synchronizes accesses to disks, so external
    per-disk locking is unneeded. */
 void disk_write(struct disk *d, disk_sector_t sec_no, const void *buffer)
+{
+	ASSERT(buffer != NULL);
+
+	disk_write_multiple(d, sec_no, &buffer, 1);
+}
+
+/* Writes SECTORS[0] through SECTORS[CNT - 1], each of which must
+   contain DISK_SECTOR_SIZE bytes, to the CNT sectors starting at
+   SEC_NO on disk D, with a single command.  CNT must be between 1
+   and DISK_MULTIPLE_MAX.  Returns after the disk has acknowledged
+   receiving all the data.
+   Internally synchronizes accesses to disks, so external
+   per-disk locking is unneeded. */
+/* SECTORS[0]부터 SECTORS[CNT - 1]까지를 명령 하나로 디스크 D의 SEC_NO부터
+   CNT개의 섹터에 씁니다. 각 버퍼는 DISK_SECTOR_SIZE 바이트를 담고
+   있어야 합니다. CNT는 1 이상 DISK_MULTIPLE_MAX 이하여야 합니다.
+   디스크가 모든 데이터를 받았다고 확인한 뒤에 반환합니다.
+   내부적으로 디스크에 대한 액세스를 동기화하므로 외부의 디스크별
+   잠금이 필요하지 않습니다. */
+void disk_write_multiple(struct disk *d, disk_sector_t sec_no,
+						 const void *const sectors[], size_t cnt)
 {
 	struct channel *c;
+	size_t i;
 
 	ASSERT(d != NULL);
-	ASSERT(buffer != NULL);
+	ASSERT(cnt >= 1 && cnt <= DISK_MULTIPLE_MAX);
 
 	c = d->channel;
 	lock_acquire(&c->lock);
-	select_sector(d, sec_no);
+	select_sector(d, sec_no, cnt);
 	issue_pio_command(c, CMD_WRITE_SECTOR_RETRY);
-	if (!wait_while_busy(d))
-		PANIC("%s: disk write failed, sector=%" PRDSNu, d->name, sec_no);
-	output_sector(c, buffer);
-	sema_down(&c->completion_wait);
-	d->write_cnt++;
+
+	/* The disk interrupts once per sector, after taking it. */
+	/* 디스크는 섹터마다 받은 뒤에 한 번씩 인터럽트를 겁니다. */
+	for (i = 0; i < cnt; i++)
+	{
+		if (!wait_while_busy(d))
+			PANIC("%s: disk write failed, sector=%" PRDSNu,
+				  d->name, sec_no + (disk_sector_t)i);
+		output_sector(c, sectors[i]);
+		sema_down(&c->completion_wait);
+	}
+	d->write_cnt += cnt;
 	lock_release(&c->lock);
 }
 
@@ -434,19 +491,23 @@ print_ata_string(char *string, size_t size)
 }
 
 /* Selects device D, waiting for it to become ready, and then
-   writes SEC_NO to the disk's sector selection registers.  (We
-   use LBA mode.) */
+   writes SEC_NO and CNT to the disk's sector selection
+   registers.  (We use LBA mode.) */
 /* 장치 D를 선택하고 준비가 될 때까지 기다린 다음 디스크의
-   섹터 선택 레지스터에 SEC_NO를 씁니다. (LBA 모드를 사용합니다.) */
-static void select_sector(struct disk *d, disk_sector_t sec_no)
+   섹터 선택 레지스터에 SEC_NO와 CNT를 씁니다. (LBA 모드를
+   사용합니다.) */
+static void select_sector(struct disk *d, disk_sector_t sec_no, size_t cnt)
 {
 	struct channel *c = d->channel;
 
-	ASSERT(sec_no < d->capacity);
-	ASSERT(sec_no < (1UL << 28));
+	ASSERT(sec_no < d->capacity && cnt <= d->capacity - sec_no);
+	ASSERT(sec_no + cnt <= (1UL << 28));
 
 	select_device_wait(d);
-	outb(reg_nsect(c), 1);
+
+	/* A count of 0 means DISK_MULTIPLE_MAX sectors. */
+	/* 개수 0은 DISK_MULTIPLE_MAX개의 섹터를 뜻합니다. */
+	outb(reg_nsect(c), cnt == DISK_MULTIPLE_MAX ? 0 : cnt);
 	outb(reg_lbal(c), sec_no);
 	outb(reg_lbam(c), sec_no >> 8);
 	outb(reg_lbah(c), (sec_no >> 16));
@@ -2,6 +2,7 @@
 #include <debug.h>
 #include "devices/intq.h"
 #include "devices/serial.h"
+#include "threads/allocprof.h"
 
 /* Stores keys from the keyboard and serial port. */
 /* 키보드와 직렬 포트의 키를 저장합니다. */
@@ -23,6 +24,16 @@ void input_putc(uint8_t key)
 	ASSERT(intr_get_level() == INTR_OFF);
 	ASSERT(!intq_full(&buffer));
 
+	/* While allocations are tracked, Ctrl+T prints the call
+	   sites holding the most memory instead of being read. */
+	/* 할당을 추적하는 동안 Ctrl+T는 입력되는 대신 메모리를 가장 많이
+	   잡고 있는 호출 지점을 출력합니다. */
+	if (key == ALLOCPROF_KEY && allocprof_on)
+	{
+		allocprof_dump(10);
+		return;
+	}
+
 	intq_putc(&buffer, key);
 	serial_notify();
 }
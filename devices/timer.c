@@ -7,6 +7,7 @@
 #include "threads/io.h"
 #include "threads/synch.h"
 #include "threads/thread.h"
+#include "intrinsic.h"
 /* See [8254] for hardware details of the 8254 timer chip. */
 /* 8254 타이머 칩의 하드웨어 세부 정보는 [8254]를 참조하세요. */
 
@@ -27,6 +28,10 @@ static int64_t ticks;
    timer_calibrate()에 의해 초기화됩니다. */
 static unsigned loops_per_tick;
 
+/* TSC cycles spent inside timer_interrupt() since boot. */
+/* 부팅 이후 timer_interrupt() 안에서 소비한 TSC 사이클 수입니다. */
+static uint64_t intr_cycles;
+
 static intr_handler_func timer_interrupt;
 static bool too_many_loops(unsigned loops);
 static void busy_wait(int64_t loops);
@@ -162,6 +167,19 @@ void timer_nsleep(int64_t ns)
 	real_time_sleep(ns, 1000 * 1000 * 1000);
 }
 
+/* Returns the number of TSC cycles spent in the timer
+   interrupt handler since the OS booted. */
+/* OS 부팅 이후 타이머 인터럽트 핸들러에서 소비한 TSC 사이클 수를
+   반환합니다. */
+uint64_t timer_interrupt_cycles(void)
+{
+	enum intr_level old_level = intr_disable();
+	uint64_t c = intr_cycles;
+	intr_set_level(old_level);
+	barrier();
+	return c;
+}
+
 /* Prints timer statistics. */
 /* 타이머 통계를 출력합니다. */
 void timer_print_stats(void)
@@ -177,8 +195,10 @@ void timer_print_stats(void)
    확인하고 wake_up 함수를 호출합니다. */
 static void timer_interrupt(struct intr_frame *args UNUSED)
 {
+	uint64_t start = rdtsc();
+
 	ticks++;
-  
+
 	// update the cpu usage for running process
 	// 실행 중인 프로세스에 대한 CPU 사용량 업데이트
 	thread_tick();
@@ -192,10 +212,10 @@ static void timer_interrupt(struct intr_frame *args UNUSED)
 	   sleep list와 글로벌 틱을 확인합니다.
 	   깨울 스레드를 찾아서 필요한 경우 ready list로 이동합니다.
 	   글로벌 틱을 업데이트합니다. */
-	// sleep_list가 정렬된 상태라면 순회 시 성능 이점이 있음
-  
+	// 타이밍 휠에서 이번 틱에 만료된 슬롯만 처리하므로 O(1) (분할 상환)
 	thread_wakeup(ticks);
-  // thread_wakeup(); // 추후 성능 Test를 위한 백업 코드 - Hyeonwoo, 2024.03.06
+
+	intr_cycles += rdtsc() - start;
 }
 
 /* Returns true if LOOPS iterations waits for more than one timer
@@ -1,10 +1,11 @@
 #include "filesys/directory.h"
+#include <debug.h>
 #include <stdio.h>
 #include <string.h>
 #include <list.h>
 #include "filesys/filesys.h"
 #include "filesys/inode.h"
-#include "threads/malloc.h"
+#include "threads/slab.h"
 
 /* A directory. */
 struct dir
@@ -21,6 +22,19 @@ struct dir_entry
 	bool in_use;				/* In use or free? */
 };
 
+/* Cache of open directories. */
+/* 열린 디렉터리의 캐시. */
+static struct kmem_cache *dir_cache;
+
+/* Initializes the directory module. */
+/* 디렉터리 모듈을 초기화합니다. */
+void dir_init(void)
+{
+	dir_cache = kmem_cache_create("dir", sizeof(struct dir), 0, NULL);
+	if (dir_cache == NULL)
+		PANIC("dir cache creation failed");
+}
+
 /* Creates a directory with space for ENTRY_CNT entries in the
  * given SECTOR.  Returns true if successful, false on failure. */
 bool dir_create(disk_sector_t sector, size_t entry_cnt)
@@ -34,7 +48,7 @@ bool dir_create(disk_sector_t sector, size_t entry_cnt)
  * 실패하면 널 포인터를 반환합니다. */
 struct dir *dir_open(struct inode *inode)
 {
-	struct dir *dir = calloc(1, sizeof *dir);
+	struct dir *dir = kmem_cache_zalloc(dir_cache);
 	if (inode != NULL && dir != NULL)
 	{
 		dir->inode = inode;
@@ -44,7 +58,7 @@ struct dir *dir_open(struct inode *inode)
 	else
 	{
 		inode_close(inode);
-		free(dir);
+		kmem_cache_free(dir_cache, dir);
 		return NULL;
 	}
 }
@@ -73,7 +87,7 @@ void dir_close(struct dir *dir)
 	if (dir != NULL)
 	{
 		inode_close(dir->inode);
-		free(dir);
+		kmem_cache_free(dir_cache, dir);
 	}
 }
 
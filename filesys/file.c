@@ -1,7 +1,7 @@
 #include "filesys/file.h"
 #include <debug.h>
 #include "filesys/inode.h"
-#include "threads/malloc.h"
+#include "threads/slab.h"
 
 /* An open file. */
 /* 열린 파일입니다. */
@@ -15,6 +15,19 @@ struct file
 						 /* file_deny_write()가 호출되었습니까? */
 };
 
+/* Cache of open files. */
+/* 열린 파일의 캐시. */
+static struct kmem_cache *file_cache;
+
+/* Initializes the file module. */
+/* 파일 모듈을 초기화합니다. */
+void file_init(void)
+{
+	file_cache = kmem_cache_create("file", sizeof(struct file), 0, NULL);
+	if (file_cache == NULL)
+		PANIC("file cache creation failed");
+}
+
 /* Opens a file for the given INODE, of which it takes ownership,
  * and returns the new file.  Returns a null pointer if an
  * allocation fails or if INODE is null. */
@@ -22,7 +35,7 @@ struct file
  * 할당이 실패하거나 INODE가 null이면 null 포인터를 반환합니다. */
 struct file *file_open(struct inode *inode)
 {
-	struct file *file = calloc(1, sizeof *file);
+	struct file *file = kmem_cache_zalloc(file_cache);
 
 	if (inode != NULL && file != NULL)
 	{
@@ -33,7 +46,7 @@ struct file *file_open(struct inode *inode)
 	}
 
 	inode_close(inode);
-	free(file);
+	kmem_cache_free(file_cache, file);
 
 	return NULL;
 }
@@ -76,7 +89,7 @@ void file_close(struct file *file)
 	{
 		file_allow_write(file);
 		inode_close(file->inode);
-		free(file);
+		kmem_cache_free(file_cache, file);
 	}
 }
 
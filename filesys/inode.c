@@ -6,6 +6,7 @@
 #include "filesys/filesys.h"
 #include "filesys/free-map.h"
 #include "threads/malloc.h"
+#include "threads/slab.h"
 
 /* Identifies an inode. */
 #define INODE_MAGIC 0x494e4f44
@@ -58,10 +59,17 @@ static disk_sector_t byte_to_sector(const struct inode *inode, off_t pos)
  * returns the same `struct inode'. */
 static struct list open_inodes;
 
+/* Cache of in-memory inodes. */
+/* 메모리 내 이노드의 캐시. */
+static struct kmem_cache *inode_cache;
+
 /* Initializes the inode module. */
 void inode_init(void)
 {
 	list_init(&open_inodes);
+	inode_cache = kmem_cache_create("inode", sizeof(struct inode), 0, NULL);
+	if (inode_cache == NULL)
+		PANIC("inode cache creation failed");
 }
 
 /* Initializes an inode with LENGTH bytes of data and
@@ -129,7 +137,7 @@ struct inode *inode_open(disk_sector_t sector)
 
 	/* Allocate memory. */
 	/* 메모리 할당. */
-	inode = malloc(sizeof *inode);
+	inode = kmem_cache_alloc(inode_cache);
 	if (inode == NULL)
 		return NULL;
 
@@ -190,7 +198,7 @@ void inode_close(struct inode *inode)
 							 bytes_to_sectors(inode->data.length));
 		}
 
-		free(inode);
+		kmem_cache_free(inode_cache, inode);
 	}
 }
 
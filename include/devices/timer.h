@@ -20,6 +20,7 @@ void timer_usleep(int64_t microseconds);
 void timer_nsleep(int64_t nanoseconds);
 
 void timer_print_stats(void);
+uint64_t timer_interrupt_cycles(void);
 
 // Design tip for modularization
 
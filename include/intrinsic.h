@@ -54,6 +54,29 @@ __attribute__((always_inline)) static __inline uint64_t rcr3(void)
 	return val;
 }
 
+__attribute__((always_inline)) static __inline uint64_t rcr4(void)
+{
+	uint64_t val;
+	__asm __volatile("movq %%cr4,%0" : "=r"(val));
+	return val;
+}
+
+__attribute__((always_inline)) static __inline void lcr4(uint64_t val)
+{
+	__asm __volatile("movq %0, %%cr4" : : "r"(val) : "memory");
+}
+
+/* Executes CPUID for LEAF and returns ECX.  See [IA32-v2a]
+   "CPUID". */
+/* LEAF에 대해 CPUID를 실행하고 ECX를 반환합니다. [IA32-v2a]
+   "CPUID"를 참조하세요. */
+__attribute__((always_inline)) static __inline uint32_t cpuid_ecx(uint32_t leaf)
+{
+	uint32_t eax = leaf, ebx, ecx = 0, edx;
+	__asm __volatile("cpuid" : "+a"(eax), "=b"(ebx), "+c"(ecx), "=d"(edx));
+	return ecx;
+}
+
 __attribute__((always_inline)) static __inline uint64_t rrax(void)
 {
 	uint64_t val;
@@ -131,4 +154,13 @@ __attribute__((always_inline)) static __inline void write_msr(uint32_t ecx, uint
 	__asm __volatile("wrmsr" ::"c"(ecx), "d"(edx), "a"(eax));
 }
 
+/* Reads the time-stamp counter.  See [IA32-v2b] "RDTSC". */
+/* 타임스탬프 카운터를 읽습니다. [IA32-v2b] "RDTSC"를 참조하세요. */
+__attribute__((always_inline)) static __inline uint64_t rdtsc(void)
+{
+	uint32_t lo, hi;
+	__asm __volatile("rdtsc" : "=a"(lo), "=d"(hi));
+	return ((uint64_t)hi << 32) | lo;
+}
+
 #endif /* intrinsic.h */
@@ -62,6 +62,7 @@ struct hash {
 	hash_hash_func *hash;       /* Hash function. */
 	hash_less_func *less;       /* Comparison function. */
 	void *aux;                  /* Auxiliary data for `hash' and `less'. */
+	bool fixed;                 /* Buckets given by caller, never resized. */
 };
 
 /* A hash table iterator. */
@@ -73,6 +74,8 @@ struct hash_iterator {
 
 /* Basic life cycle. */
 bool hash_init (struct hash *, hash_hash_func *, hash_less_func *, void *aux);
+void hash_init_fixed (struct hash *, hash_hash_func *, hash_less_func *,
+		void *aux, struct list *buckets, size_t bucket_cnt);
 void hash_clear (struct hash *, hash_action_func *);
 void hash_destroy (struct hash *, hash_action_func *);
 
@@ -0,0 +1,86 @@
+#ifndef __LIB_KERNEL_HEAP_H
+#define __LIB_KERNEL_HEAP_H
+
+/* Priority queue (pairing heap).
+ *
+ * Like lists and hash tables, the heap does not allocate memory.
+ * Each structure that can be in a heap embeds a struct
+ * heap_elem member, and heap_entry converts a struct heap_elem
+ * back to the structure that contains it.  See
+ * lib/kernel/list.h for a detailed explanation of the technique.
+ *
+ * The element that compares greatest under the heap's less
+ * function is at the top.  Push, top, and increasing an
+ * element's key are O(1); pop, removing an arbitrary element and
+ * changing its key arbitrarily are O(log n) amortized. */
+/* 우선순위 큐 (페어링 힙).
+ *
+ * 리스트나 해시 테이블처럼 힙도 메모리를 할당하지 않습니다. 힙에
+ * 들어갈 수 있는 구조체는 struct heap_elem 멤버를 포함하며,
+ * heap_entry는 struct heap_elem을 그것을 포함하는 구조체로 다시
+ * 변환합니다. 이 기법에 대한 자세한 설명은 lib/kernel/list.h를
+ * 참고하세요.
+ *
+ * 힙의 less 함수 기준으로 가장 큰 요소가 맨 위에 있습니다. 삽입,
+ * top 조회, 요소의 키 증가는 O(1)이고, pop, 임의 요소 제거, 키의 임의
+ * 변경은 분할 상환 O(log n)입니다. */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Heap element. */
+/* 힙 요소. */
+struct heap_elem
+{
+	struct heap_elem *child; /* Leftmost child. */
+							 /* 가장 왼쪽 자식. */
+	struct heap_elem *next;	 /* Next sibling. */
+							 /* 다음 형제. */
+	struct heap_elem *prev;	 /* Previous sibling, or parent if leftmost. */
+							 /* 이전 형제, 가장 왼쪽이면 부모. */
+};
+
+/* Converts pointer to heap element HEAP_ELEM into a pointer to
+   the structure that HEAP_ELEM is embedded inside. */
+/* 힙 요소 HEAP_ELEM에 대한 포인터를 HEAP_ELEM이 포함된 구조체에 대한
+   포인터로 변환합니다. */
+#define heap_entry(HEAP_ELEM, STRUCT, MEMBER) \
+	((STRUCT *)((uint8_t *)&(HEAP_ELEM)->child - offsetof(STRUCT, MEMBER.child)))
+
+/* Compares the keys of heap elements A and B, given auxiliary
+   data AUX.  Returns true if A is less than B, or false if A is
+   greater than or equal to B. */
+/* 보조 데이터 AUX를 사용하여 힙 요소 A와 B의 키를 비교합니다. A가
+   B보다 작으면 true를, 크거나 같으면 false를 반환합니다. */
+typedef bool heap_less_func(const struct heap_elem *a,
+							const struct heap_elem *b,
+							void *aux);
+
+/* Heap. */
+/* 힙. */
+struct heap
+{
+	struct heap_elem *root; /* Greatest element, or NULL. */
+							/* 가장 큰 요소 또는 NULL. */
+	size_t size;			/* Number of elements. */
+							/* 요소 수. */
+	heap_less_func *less;	/* Comparison function. */
+							/* 비교 함수. */
+	void *aux;				/* Auxiliary data for `less'. */
+							/* `less'의 보조 데이터. */
+};
+
+void heap_init(struct heap *, heap_less_func *, void *aux);
+
+void heap_push(struct heap *, struct heap_elem *);
+struct heap_elem *heap_top(const struct heap *);
+struct heap_elem *heap_pop(struct heap *);
+void heap_remove(struct heap *, struct heap_elem *);
+void heap_increase(struct heap *, struct heap_elem *);
+void heap_update(struct heap *, struct heap_elem *);
+
+size_t heap_size(const struct heap *);
+bool heap_empty(const struct heap *);
+
+#endif /* lib/kernel/heap.h */
@@ -0,0 +1,38 @@
+#ifndef __LIB_RUSAGE_H
+#define __LIB_RUSAGE_H
+
+#include <stdint.h>
+
+/* Memory and I/O usage of one process, as returned by the
+   getrusage system call.  Resident and page-table pages are
+   counted from the page map when the call is made; the rest are
+   totals since the process started. */
+/* getrusage 시스템 콜이 반환하는 프로세스 하나의 메모리 및 입출력
+   사용량. 상주 페이지와 페이지 테이블 페이지는 호출 시점의 페이지
+   맵에서 세고, 나머지는 프로세스가 시작된 뒤의 합계입니다. */
+struct rusage
+{
+	uint64_t minor_faults;		/* Faults resolved without I/O. */
+								/* 입출력 없이 해결된 페이지 오류 수. */
+	uint64_t major_faults;		/* Faults that read from disk. */
+								/* 디스크를 읽은 페이지 오류 수. */
+	uint64_t resident_pages;	/* User pages mapped now. */
+								/* 지금 매핑된 사용자 페이지 수. */
+	uint64_t page_table_pages;	/* Pages of page table now. */
+								/* 지금 페이지 테이블이 차지하는 페이지 수. */
+	uint64_t swapped_pages;		/* Pages in swap now. */
+								/* 지금 스왑에 있는 페이지 수. */
+	uint64_t read_bytes;		/* Bytes read from files. */
+								/* 파일에서 읽은 바이트 수. */
+	uint64_t write_bytes;		/* Bytes written to files. */
+								/* 파일에 쓴 바이트 수. */
+	uint64_t zero_pages;		/* Pages mapping the shared zero
+								   page now, which are not counted
+								   as resident. */
+								/* 지금 공유 0 페이지를 매핑한 페이지 수.
+								   상주 페이지로 세지 않습니다. */
+	uint64_t zero_page_hits;	/* Faults that mapped the zero page. */
+								/* 0 페이지를 매핑한 페이지 오류 수. */
+};
+
+#endif /* lib/rusage.h */
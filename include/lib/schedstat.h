@@ -0,0 +1,36 @@
+#ifndef __LIB_SCHEDSTAT_H
+#define __LIB_SCHEDSTAT_H
+
+#include <stdint.h>
+
+/* Number of buckets in the wakeup latency histogram.  Bucket N
+   counts wakeups that took from 2**N to 2**(N+1) - 1 cycles to
+   run; the last bucket also counts everything slower. */
+/* 깨어남 지연 히스토그램의 버킷 수. N번 버킷은 실행되기까지 2**N부터
+   2**(N+1) - 1 사이클이 걸린 깨어남을 셉니다. 마지막 버킷은 그보다
+   느린 것도 모두 셉니다. */
+#define SCHED_LATENCY_BUCKETS 40
+
+/* Scheduler statistics for one thread, as returned by the
+   sched_stat system call.  The run queue length and latency
+   histogram are system-wide. */
+/* sched_stat 시스템 콜이 반환하는 스레드 하나의 스케줄러 통계.
+   실행 대기열 길이와 지연 히스토그램은 시스템 전체의 값입니다. */
+struct sched_stat
+{
+	uint64_t voluntary_switches;   /* Switches away after blocking or
+									  yielding. */
+								   /* 블록되거나 양보한 뒤의 문맥 전환 수. */
+	uint64_t involuntary_switches; /* Switches away on preemption. */
+								   /* 선점에 의한 문맥 전환 수. */
+	uint64_t run_ticks;			   /* Timer ticks spent running. */
+								   /* 실행한 타이머 틱 수. */
+	uint64_t ready_ticks;		   /* Timer ticks spent ready to run. */
+								   /* 실행 대기한 타이머 틱 수. */
+	uint64_t ready_threads;		   /* Threads in the run queues now. */
+								   /* 지금 실행 대기열에 있는 스레드 수. */
+	uint64_t wakeup_latency[SCHED_LATENCY_BUCKETS]; /* Log2 histogram. */
+													/* Log2 히스토그램. */
+};
+
+#endif /* lib/schedstat.h */
@@ -36,6 +36,12 @@ enum {
 
 	SYS_MOUNT,
 	SYS_UMOUNT,
+
+	/* Scheduler instrumentation. */
+	SYS_SCHED_STAT,             /* Scheduler statistics for a thread. */
+
+	/* Resource accounting. */
+	SYS_GETRUSAGE,              /* Memory and I/O usage of a process. */
 };
 
 #endif /* lib/syscall-nr.h */
@@ -3,6 +3,8 @@
 
 #include <stdbool.h>
 #include <debug.h>
+#include <rusage.h>
+#include <schedstat.h>
 #include <stddef.h>
 
 /* Process identifier. */
@@ -50,6 +52,12 @@ bool isdir(int fd);
 int inumber(int fd);
 int symlink(const char *target, const char *linkpath);
 
+/* Scheduler instrumentation. */
+int sched_stat(pid_t, struct sched_stat *);
+
+/* Resource accounting. */
+int getrusage(pid_t, struct rusage *);
+
 static inline void *get_phys_addr(void *user_addr)
 {
 	void *pa;
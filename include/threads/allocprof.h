@@ -0,0 +1,47 @@
+#ifndef THREADS_ALLOCPROF_H
+#define THREADS_ALLOCPROF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Allocation profiler.
+
+   While it is on, every live malloc() block and palloc() run is
+   kept in a hash table with its size and the address it was
+   allocated from, so that allocprof_dump() can show which call
+   sites hold the most memory.  It is turned on by the kernel
+   command-line option "-alloc-profile" and dumped by the
+   "allocprof" action or by Ctrl+T on the console.  While it is
+   off, the allocators only test allocprof_on. */
+/* 할당 프로파일러.
+
+   켜져 있는 동안 살아 있는 모든 malloc() 블록과 palloc() 페이지
+   묶음을 크기 및 할당한 주소와 함께 해시 테이블에 보관하여,
+   allocprof_dump()가 어떤 호출 지점이 메모리를 가장 많이 잡고
+   있는지 보여 줄 수 있게 합니다. 커널 명령줄 옵션 "-alloc-profile"로
+   켜고, "allocprof" 액션이나 콘솔의 Ctrl+T로 출력합니다. 꺼져 있는
+   동안 할당기는 allocprof_on만 검사합니다. */
+
+/* Which allocator an allocation came from. */
+/* 할당이 어느 할당기에서 왔는지. */
+enum allocprof_kind
+{
+	ALLOCPROF_MALLOC, /* malloc(), calloc(), realloc(). */
+	ALLOCPROF_PALLOC, /* palloc_get_page(), palloc_get_multiple(). */
+	ALLOCPROF_KIND_CNT
+};
+
+/* Console key that prints the profile: Ctrl+T. */
+/* 프로파일을 출력하는 콘솔 키: Ctrl+T. */
+#define ALLOCPROF_KEY 0x14
+
+extern bool allocprof_on;
+
+void allocprof_init(void);
+void allocprof_record(enum allocprof_kind, void *, size_t size,
+					  const void *caller);
+void allocprof_forget(enum allocprof_kind, void *);
+size_t allocprof_live(enum allocprof_kind, size_t *cnt);
+void allocprof_dump(size_t site_cnt);
+
+#endif /* threads/allocprof.h */
@@ -0,0 +1,169 @@
+#ifndef THREADS_CPU_H
+#define THREADS_CPU_H
+
+#include <list.h>
+#include <schedstat.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "threads/spinlock.h"
+#include "threads/thread.h"
+
+/* Maximum number of CPUs the kernel keeps state for. */
+/* 커널이 상태를 유지하는 최대 CPU 수. */
+#define NCPU_MAX 8
+
+/* Most thread pages and file descriptor tables each CPU keeps
+   for reuse. */
+/* 각 CPU가 재사용을 위해 보관하는 스레드 페이지와 파일 디스크립터
+   테이블의 최대 개수. */
+#define THREAD_CACHE_MAX 16
+#define FDT_CACHE_MAX 8
+
+/* Single pages each CPU keeps in front of each page pool, and
+   how many move between a magazine and its pool at a time. */
+/* 각 CPU가 페이지 풀마다 앞에 두는 단일 페이지 수와, 매거진과 풀
+   사이에서 한 번에 옮기는 페이지 수. */
+#define PAGE_MAG_SIZE 32
+#define PAGE_MAG_BATCH 16
+
+/* A per-CPU stack of free single pages from one pool.  The pages
+   are still marked used in the pool. */
+/* 한 풀에서 온 가용 단일 페이지의 CPU별 스택. 이 페이지들은 풀에서
+   여전히 사용 중으로 표시되어 있습니다. */
+struct page_mag
+{
+	void *pages[PAGE_MAG_SIZE]; /* Free pages, hottest last. */
+								/* 가용 페이지, 마지막이 가장 최근. */
+	int cnt;					/* Entries in pages. */
+								/* pages의 항목 수. */
+	uint64_t hits;				/* Allocations served from pages. */
+								/* pages에서 처리한 할당 수. */
+	uint64_t misses;			/* Allocations that found it empty. */
+								/* 비어 있는 것을 본 할당 수. */
+	uint64_t refills;			/* Batches taken from the pool. */
+								/* 풀에서 가져온 묶음 수. */
+	uint64_t drains;			/* Batches given back to the pool. */
+								/* 풀에 돌려준 묶음 수. */
+};
+
+/* Process-context identifiers (PCIDs) each CPU tags its TLB
+   entries with, so that switching page maps need not flush them.
+   PCID 0 belongs to the base page map. */
+/* 페이지 맵을 전환할 때 TLB를 비우지 않도록 각 CPU가 TLB 항목에
+   붙이는 프로세스 컨텍스트 식별자(PCID)의 수. PCID 0은 기본 페이지
+   맵의 것입니다. */
+#define PCID_CNT 64
+
+/* Index of a pool's magazine in struct cpu's page_mags[]. */
+/* struct cpu의 page_mags[]에서 풀의 매거진 인덱스. */
+enum page_mag_pool
+{
+	PAGE_MAG_KERNEL, /* Kernel pool. */
+					 /* 커널 풀. */
+	PAGE_MAG_USER,	 /* User pool. */
+					 /* 사용자 풀. */
+	PAGE_MAG_CNT
+};
+
+/* Per-CPU scheduler state.
+ *
+ * Each CPU has its own run queues, idle thread, time slice and
+ * tick statistics.  The run queues are one FIFO queue per
+ * priority, and bit N of ready_mask is set iff ready_queues[N]
+ * is not empty.  rq_lock protects the run queues, because other
+ * CPUs may push the threads they wake onto them.
+ *
+ * The kernel runs on the bootstrap processor alone, so cpus[0]
+ * is the only entry in use.  Other processors are neither looked
+ * for nor started: that needs an AP trampoline, LAPIC and I/O
+ * APIC setup, reschedule and TLB-shootdown IPIs, and spinlocks in
+ * place of the many sections that intr_disable() alone protects,
+ * none of which exists. */
+/* CPU별 스케줄러 상태.
+ *
+ * CPU마다 자신의 실행 대기열, 유휴 스레드, 타임 슬라이스와 틱
+ * 통계를 가집니다. 실행 대기열은 우선순위마다 FIFO 큐가 하나씩이며,
+ * ready_queues[N]이 비어 있지 않을 때에만 ready_mask의 N번 비트가
+ * 켜집니다. 다른 CPU가 자신이 깨운 스레드를 넣을 수 있으므로
+ * rq_lock이 실행 대기열을 보호합니다.
+ *
+ * 커널은 부트스트랩 프로세서에서만 실행되므로 cpus[0]만 사용됩니다.
+ * 다른 프로세서는 찾지도 시작하지도 않습니다. 그러려면 AP 트램펄린,
+ * LAPIC과 I/O APIC 설정, 재스케줄과 TLB shootdown IPI, 그리고
+ * intr_disable()만으로 보호되는 많은 구간을 대신할 스핀락이 필요한데,
+ * 어느 것도 없습니다. */
+struct cpu
+{
+	int id;			 /* Index into cpus[]. */
+					 /* cpus[]에서의 인덱스. */
+
+	struct spinlock rq_lock;				/* Protects the run queues. */
+											/* 실행 대기열 보호. */
+	struct list ready_queues[PRI_MAX + 1]; /* Per-priority run queues. */
+										   /* 우선순위별 실행 대기열. */
+	uint64_t ready_mask;				   /* Non-empty ready_queues. */
+										   /* 비어 있지 않은 ready_queues. */
+	int ready_cnt;						   /* Threads in ready_queues. */
+										   /* ready_queues에 있는 스레드 수. */
+
+	struct thread *idle_thread; /* Runs when nothing else is ready. */
+								/* 실행할 스레드가 없을 때 실행. */
+	unsigned thread_ticks;		/* # of timer ticks since last yield. */
+								/* 마지막 yield 이후 타이머 틱 수. */
+
+	long long idle_ticks;	/* # of timer ticks spent idle. */
+							/* 유휴 타이머 틱 수. */
+	long long kernel_ticks; /* # of timer ticks in kernel threads. */
+							/* 커널 스레드의 타이머 틱 수. */
+	long long user_ticks;	/* # of timer ticks in user programs. */
+							/* 사용자 프로그램의 타이머 틱 수. */
+
+	/* Cycles from wakeup to running, log2 histogram. */
+	/* 깨어나서 실행되기까지의 사이클, log2 히스토그램. */
+	uint64_t wakeup_latency[SCHED_LATENCY_BUCKETS];
+
+	/* Pages of dead threads and their file descriptor tables,
+	   kept for the next thread_create() on this CPU. */
+	/* 이 CPU의 다음 thread_create()를 위해 보관하는 죽은 스레드의
+	   페이지와 파일 디스크립터 테이블. */
+	void *thread_pages[THREAD_CACHE_MAX]; /* Cached thread pages. */
+										  /* 캐시된 스레드 페이지. */
+	int thread_page_cnt;				  /* Entries in thread_pages. */
+										  /* thread_pages의 항목 수. */
+	void *fdts[FDT_CACHE_MAX];			  /* Cached, cleared FDTs. */
+										  /* 캐시된, 비워진 FDT. */
+	int fdt_cnt;						  /* Entries in fdts. */
+										  /* fdts의 항목 수. */
+
+	/* Free single pages of the kernel and user pools, so that
+	   palloc_get_page() and palloc_free_page() rarely reach the
+	   pools. */
+	/* palloc_get_page()와 palloc_free_page()가 풀까지 가는 일이
+	   드물도록 보관하는 커널과 사용자 풀의 가용 단일 페이지. */
+	struct page_mag page_mags[PAGE_MAG_CNT];
+
+	/* Page maps tagged with each PCID on this CPU.  Bit N of
+	   pcid_stale is set if entries tagged N may be out of date, so
+	   the next switch to PCID N must flush them. */
+	/* 이 CPU에서 각 PCID가 붙은 페이지 맵. pcid_stale의 N번 비트는 N이
+	   붙은 항목이 오래되었을 수 있다는 뜻이며, 그러면 다음에 PCID N으로
+	   전환할 때 그 항목들을 비워야 합니다. */
+	uint64_t *pcid_owners[PCID_CNT]; /* Page map per PCID, or null. */
+									 /* PCID별 페이지 맵 또는 널. */
+	uint64_t pcid_stale;			 /* PCIDs that need a flush. */
+									 /* 비워야 하는 PCID. */
+	int pcid_next;					 /* Next PCID to recycle. */
+									 /* 다음에 재사용할 PCID. */
+	uint64_t pml4_switches;			 /* Page map switches. */
+									 /* 페이지 맵 전환 수. */
+	uint64_t pml4_flushes;			 /* Switches that flushed the TLB. */
+									 /* TLB를 비운 전환 수. */
+};
+
+extern struct cpu cpus[NCPU_MAX];
+extern int ncpu;
+
+void cpu_init(struct cpu *, int id);
+struct cpu *this_cpu(void);
+
+#endif /* threads/cpu.h */
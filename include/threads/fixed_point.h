@@ -0,0 +1,84 @@
+#ifndef THREADS_FIXED_POINT_H
+#define THREADS_FIXED_POINT_H
+
+#include <stdint.h>
+
+/* 17.14 fixed-point arithmetic for the MLFQS scheduler.
+ *
+ * The kernel does not support floating point, so real numbers
+ * such as load_avg and recent_cpu are stored in a plain int
+ * whose low 14 bits are the fraction.  Products and quotients
+ * of two fixed-point numbers are computed in 64 bits so that
+ * they cannot overflow the intermediate result. */
+/* MLFQS 스케줄러를 위한 17.14 고정소수점 연산.
+ *
+ * 커널은 부동소수점을 지원하지 않으므로 load_avg와 recent_cpu 같은
+ * 실수는 하위 14비트를 소수부로 쓰는 int에 저장합니다. 두 고정소수점
+ * 수의 곱과 나눗셈은 중간 결과가 넘치지 않도록 64비트로 계산합니다. */
+typedef int fixed_t;
+
+#define FP_SHIFT 14
+#define FP_F (1 << FP_SHIFT)
+
+/* Converts integer N to fixed point. */
+/* 정수 N을 고정소수점으로 변환합니다. */
+static inline fixed_t fp_from_int(int n)
+{
+	return n * FP_F;
+}
+
+/* Converts X to an integer, rounding toward zero. */
+/* X를 0 방향으로 버림하여 정수로 변환합니다. */
+static inline int fp_to_int(fixed_t x)
+{
+	return x / FP_F;
+}
+
+/* Converts X to an integer, rounding to nearest. */
+/* X를 가장 가까운 정수로 반올림하여 변환합니다. */
+static inline int fp_round(fixed_t x)
+{
+	return x >= 0 ? (x + FP_F / 2) / FP_F : (x - FP_F / 2) / FP_F;
+}
+
+static inline fixed_t fp_add(fixed_t x, fixed_t y)
+{
+	return x + y;
+}
+
+static inline fixed_t fp_sub(fixed_t x, fixed_t y)
+{
+	return x - y;
+}
+
+static inline fixed_t fp_add_int(fixed_t x, int n)
+{
+	return x + n * FP_F;
+}
+
+static inline fixed_t fp_sub_int(fixed_t x, int n)
+{
+	return x - n * FP_F;
+}
+
+static inline fixed_t fp_mul(fixed_t x, fixed_t y)
+{
+	return (fixed_t)(((int64_t)x) * y / FP_F);
+}
+
+static inline fixed_t fp_mul_int(fixed_t x, int n)
+{
+	return x * n;
+}
+
+static inline fixed_t fp_div(fixed_t x, fixed_t y)
+{
+	return (fixed_t)(((int64_t)x) * FP_F / y);
+}
+
+static inline fixed_t fp_div_int(fixed_t x, int n)
+{
+	return x / n;
+}
+
+#endif /* threads/fixed_point.h */
@@ -9,5 +9,7 @@ void *malloc (size_t) __attribute__ ((malloc));
 void *calloc (size_t, size_t) __attribute__ ((malloc));
 void *realloc (void *, size_t);
 void free (void *);
+size_t malloc_footprint (size_t);
+void malloc_thread_exit (void);
 
 #endif /* threads/malloc.h */
@@ -48,5 +48,15 @@
 #define PTE_U 0x4                           /* 1=user/kernel, 0=kernel only. */
 #define PTE_A 0x20                          /* 1=accessed, 0=not acccessed. */
 #define PTE_D 0x40                          /* 1=dirty, 0=not dirty (PTEs only). */
+#define PTE_PS 0x80                         /* 1=2 MB page (PDEs only). */
+                                            /* 1=2 MB 페이지 (PDE 전용). */
+
+/* A page directory entry with PTE_PS set maps a 2 MB large page
+   directly, without a page table below it. */
+/* PTE_PS가 설정된 페이지 디렉터리 항목은 그 아래 페이지 테이블 없이
+   2 MB 대형 페이지를 직접 매핑합니다. */
+#define LPGSIZE (1UL << PDXSHIFT)           /* Bytes in a large page. */
+#define LPGCNT (LPGSIZE / PGSIZE)           /* Pages in a large page. */
+#define lpg_ofs(va) ((uint64_t)(va) & (LPGSIZE - 1))
 
 #endif /* threads/pte.h */
@@ -0,0 +1,32 @@
+#ifndef THREADS_SLAB_H
+#define THREADS_SLAB_H
+
+#include <stddef.h>
+
+/* Object caches for fixed-size kernel objects.
+
+   A cache hands out objects of one exact size and alignment,
+   carved from single-page slabs, instead of rounding them up to
+   a malloc() size class.  Each CPU keeps a short list of free
+   objects in front of the slabs.  If a constructor is given, it
+   runs once per object when its slab is created, and freed
+   objects must be returned to their constructed state. */
+/* 고정 크기 커널 객체를 위한 객체 캐시.
+
+   캐시는 malloc() 크기 등급으로 올림하는 대신, 한 페이지짜리
+   슬랩에서 잘라 낸 정확한 크기와 정렬의 객체를 나눠 줍니다. 각
+   CPU는 슬랩 앞에 가용 객체의 짧은 리스트를 둡니다. 생성자가
+   주어지면 슬랩을 만들 때 객체마다 한 번 실행되며, 해제하는 객체는
+   생성된 상태로 되돌려 놓아야 합니다. */
+struct kmem_cache;
+
+void kmem_cache_init(void);
+struct kmem_cache *kmem_cache_create(const char *name, size_t size,
+									 size_t align, void (*ctor)(void *));
+void *kmem_cache_alloc(struct kmem_cache *);
+void *kmem_cache_zalloc(struct kmem_cache *);
+void kmem_cache_free(struct kmem_cache *, void *);
+size_t kmem_cache_footprint(const struct kmem_cache *);
+void kmem_cache_print_stats(void);
+
+#endif /* threads/slab.h */
@@ -0,0 +1,37 @@
+#ifndef THREADS_SPINLOCK_H
+#define THREADS_SPINLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Spinlock.
+ *
+ * Disabling interrupts only keeps other code on the same CPU
+ * away from shared data.  A spinlock additionally keeps the
+ * other CPUs away by busy-waiting on an atomic exchange, so data
+ * touched by every CPU (such as a run queue that other CPUs
+ * push woken threads onto) must be protected by both: turn
+ * interrupts off, then take the spinlock.  Spinlocks must be
+ * held only for short, non-sleeping critical sections. */
+/* 스핀락.
+ *
+ * 인터럽트를 끄는 것은 같은 CPU의 다른 코드만 공유 데이터에서
+ * 떼어 놓습니다. 스핀락은 원자적 교환 연산으로 바쁜 대기를 하여
+ * 다른 CPU까지 떼어 놓습니다. 따라서 모든 CPU가 건드리는 데이터(예:
+ * 다른 CPU가 깨운 스레드를 넣는 실행 대기열)는 둘 다로 보호해야
+ * 합니다. 먼저 인터럽트를 끄고 그다음 스핀락을 잡습니다. 스핀락은
+ * 잠들지 않는 짧은 임계 구역에서만 잡아야 합니다. */
+struct spinlock
+{
+	volatile uint32_t locked; /* Nonzero while held. */
+							  /* 잡혀 있으면 0이 아님. */
+	struct cpu *cpu;		  /* CPU holding the lock (for debugging). */
+							  /* 락을 잡은 CPU (디버깅용). */
+};
+
+void spin_init(struct spinlock *);
+void spin_lock(struct spinlock *);
+void spin_unlock(struct spinlock *);
+bool spin_held(const struct spinlock *);
+
+#endif /* threads/spinlock.h */
@@ -1,6 +1,7 @@
 #ifndef THREADS_SYNCH_H
 #define THREADS_SYNCH_H
 
+#include <heap.h>
 #include <list.h>
 #include <stdbool.h>
 
@@ -10,8 +11,8 @@ struct semaphore
 {
 	unsigned value;		 /* Current value. */
 						 /* 현재 값입니다. */
-	struct list waiters; /* List of waiting threads. */
-						 /* 대기 스레드 목록. */
+	struct heap waiters; /* Waiting threads, by priority. */
+						 /* 우선순위 순의 대기 스레드. */
 };
 
 void sema_init(struct semaphore *, unsigned value);
@@ -32,10 +33,14 @@ void sema_self_test(void);
 /* Lock. */
 struct lock
 {
-	struct thread *holder;		/* Thread holding lock (for debugging). */
-								/* 스레드 홀딩 락 (디버깅용). */
-	struct semaphore semaphore; /* Binary semaphore controlling access. */
-								/* 바이너리 세마포어로 액세스를 제어합니다. */
+	struct thread *holder;		  /* Thread holding lock. */
+								  /* 락을 잡은 스레드. */
+	struct semaphore semaphore;	  /* Binary semaphore controlling access. */
+								  /* 바이너리 세마포어로 액세스를 제어합니다. */
+	struct heap waiters;		  /* Waiting threads, by priority. */
+								  /* 우선순위 순의 대기 스레드. */
+	struct heap_elem holder_elem; /* Element in holder's held_locks. */
+								  /* 홀더의 held_locks 요소. */
 };
 
 void lock_init(struct lock *);
@@ -57,15 +62,123 @@ void lock_release(struct lock *);
 
 bool lock_held_by_current_thread(const struct lock *);
 
+/* Priority donation.  Each lock keeps its waiters in a max-heap
+   by priority, and each thread keeps the locks it holds in a
+   max-heap keyed by their highest waiter, so the donation a
+   thread receives is read off the top in O(1), and acquire,
+   release and each hop of a nested donation cost O(log n).
+   The few rwlocks a thread holds are checked one by one. */
+/* 우선순위 기부. 각 락은 대기자를 우선순위 최대 힙으로 유지하고, 각
+   스레드는 잡고 있는 락을 가장 높은 대기자 기준 최대 힙으로 유지합니다.
+   따라서 스레드가 받는 기부는 맨 위에서 O(1)로 읽고, 획득, 해제,
+   중첩 기부의 각 단계는 O(log n)입니다. 스레드가 잡은 몇 개의
+   rwlock은 하나씩 확인합니다. */
+struct thread;
+void donation_init(struct thread *);
+int donation_priority(const struct thread *);
+void waiter_priority_changed(struct thread *, int old_priority);
+
+/* Priority-ceiling lock.
+ *
+ * A lock whose set of users is known up front can declare a
+ * ceiling, the highest priority of any thread that will ever
+ * acquire it.  The holder runs at the ceiling for as long as it
+ * holds the lock (immediate priority ceiling protocol), so no
+ * user of the lock can preempt the holder, and a waiter is
+ * blocked for at most one critical section.  There is no
+ * donation list and no chain walk.  The highest ceiling a thread
+ * holds is folded into its effective priority along with
+ * donations, so it survives plain locks, donations and
+ * thread_set_priority() inside the critical section.  Ceiling
+ * locks must be released in the reverse order of acquisition. */
+/* 우선순위 상한 락.
+ *
+ * 사용하는 스레드가 미리 정해진 락은 상한, 즉 이 락을 잡을 수 있는
+ * 스레드 중 가장 높은 우선순위를 선언할 수 있습니다. 락을 잡은
+ * 스레드는 잡고 있는 동안 상한 우선순위로 실행되므로(즉시 우선순위
+ * 상한 프로토콜) 락의 다른 사용자가 선점할 수 없고, 대기자는 최대
+ * 임계 구역 하나만큼만 막힙니다. 기부 리스트도 체인 탐색도 없습니다.
+ * 스레드가 잡고 있는 가장 높은 상한은 기부와 함께 유효 우선순위에
+ * 반영되므로, 임계 구역 안의 일반 락, 기부, thread_set_priority()에도
+ * 유지됩니다. 상한 락은 획득한 순서의 역순으로 해제해야 합니다. */
+struct ceiling_lock
+{
+	struct thread *holder;		/* Thread holding lock. */
+								/* 락을 잡은 스레드. */
+	int ceiling;				/* Priority of the holder while held. */
+								/* 락을 잡은 동안 홀더의 우선순위. */
+	int saved_ceiling;			/* Holder's ceiling before acquiring. */
+								/* 획득 전 홀더의 상한. */
+	struct semaphore semaphore; /* Binary semaphore controlling access. */
+								/* 바이너리 세마포어로 액세스를 제어합니다. */
+};
+
+void ceiling_lock_init(struct ceiling_lock *, int ceiling);
+void ceiling_lock_acquire(struct ceiling_lock *);
+void ceiling_lock_release(struct ceiling_lock *);
+bool ceiling_lock_held_by_current_thread(const struct ceiling_lock *);
+
+/* Reader-writer lock.
+ *
+ * Any number of readers may hold the lock at once, or a single
+ * writer.  Waiters queue by priority, FIFO among equals, and a
+ * reader that arrives while anyone is waiting queues too, so a
+ * stream of readers cannot starve a waiting writer.  Every
+ * holder, readers included, receives the priority of the
+ * highest waiter.  Not recursive: a thread must not acquire an
+ * rwlock it already holds in either mode. */
+/* 읽기-쓰기 락.
+ *
+ * 여러 읽기 스레드가 동시에 잡거나, 쓰기 스레드 하나만 잡을 수
+ * 있습니다. 대기자는 우선순위 순(같으면 FIFO)으로 줄을 서며, 누군가
+ * 기다리는 중에 도착한 읽기 스레드도 줄을 서므로 읽기 스레드가 계속
+ * 와도 기다리는 쓰기 스레드가 굶지 않습니다. 읽기 스레드를 포함한
+ * 모든 홀더는 가장 높은 대기자의 우선순위를 기부받습니다. 재귀적이지
+ * 않으므로, 이미 어느 모드로든 잡고 있는 rwlock을 다시 획득하면
+ * 안 됩니다. */
+struct rwlock
+{
+	int readers;		   /* Number of readers holding the lock. */
+						   /* 락을 잡은 읽기 스레드 수. */
+	struct thread *writer; /* Writer holding the lock, or NULL. */
+						   /* 락을 잡은 쓰기 스레드 또는 NULL. */
+	struct list holders;   /* Holds of the current holders. */
+						   /* 현재 홀더들의 rwlock_hold. */
+	struct heap waiters;   /* Waiting threads, by priority. */
+						   /* 우선순위 순의 대기 스레드. */
+};
+
+/* Most rwlocks one thread may hold at once. */
+/* 한 스레드가 동시에 잡을 수 있는 rwlock의 최대 개수. */
+#define RWLOCK_HOLD_MAX 4
+
+/* One rwlock held by a thread, in either mode. */
+/* 스레드가 어느 모드로든 잡고 있는 rwlock 하나. */
+struct rwlock_hold
+{
+	struct rwlock *lock;   /* Held rwlock, or NULL if unused. */
+						   /* 잡고 있는 rwlock, 사용하지 않으면 NULL. */
+	struct thread *thread; /* Holding thread. */
+						   /* 잡고 있는 스레드. */
+	struct list_elem elem; /* Element in lock's holders. */
+						   /* 락의 holders 리스트 요소. */
+};
+
+void rwlock_init(struct rwlock *);
+void rwlock_acquire_read(struct rwlock *);
+void rwlock_release_read(struct rwlock *);
+void rwlock_acquire_write(struct rwlock *);
+void rwlock_release_write(struct rwlock *);
+bool rwlock_held_by_current_thread(const struct rwlock *);
+
 /* Condition variable. */
 /* 조건 변수. */
 struct condition
 {
-	struct list waiters; /* List of waiting threads. */
-						 /* 대기 스레드 목록. */
+	struct heap waiters; /* Waiting threads, by priority. */
+						 /* 우선순위 순의 대기 스레드. */
 };
 
-bool cond_priority(const struct list_elem *a, const struct list_elem *b, void *aux);
 // Initialize the condition variable data structure.
 // 조건 변수 자료 구조를 초기화합니다.
 void cond_init(struct condition *);
@@ -3,7 +3,10 @@
 
 #include <debug.h>
 #include <list.h>
+#include <rusage.h>
+#include <schedstat.h>
 #include <stdint.h>
+#include "threads/fixed_point.h"
 #include "threads/interrupt.h"
 #include "threads/synch.h"
 #ifdef VM
@@ -33,6 +36,10 @@ typedef int tid_t;
 #define PRI_DEFAULT 31 /* 기본 우선순위. */
 #define PRI_MAX 63	   /* 최우선 순위. */
 
+/* nice 값의 범위. */
+#define NICE_MIN -20 /* 가장 양보하지 않습니다. */
+#define NICE_MAX 20	 /* 가장 많이 양보합니다. */
+
 /* 커널 스레드 또는 사용자 프로세스입니다.
  *
  * 각 스레드 구조는 자체 4KB 페이지에 저장됩니다. 스레드 구조 자체는
@@ -110,12 +117,74 @@ struct thread
 	/* thread.c와 synch.c가 공유합니다. */
 	struct list_elem elem;	   /* List element. */
 							   /* 리스트 요소. */
-	struct lock *wait_on_lock; /* Lock the thread is waiting for. */
-							   /* 스레드가 기다리는 락. */
-	struct list donations;	   /* List of threads that donated priority. */
-							   /* 우선순위를 기부한 스레드 목록. */
-	struct list_elem d_elem;   /* Donation list element. */
-							   /* 기부 리스트 요소. */
+	struct lock *wait_on_lock;	/* Lock the thread is waiting for. */
+								/* 스레드가 기다리는 락. */
+	struct heap_elem wait_elem; /* Element in wait_on_lock's waiters. */
+								/* wait_on_lock의 대기자 힙 요소. */
+	struct heap held_locks;		/* Locks held, by highest waiter. */
+								/* 잡고 있는 락 (가장 높은 대기자 순). */
+	int ceiling;				/* Highest ceiling of the ceiling locks
+								   held, or PRI_MIN - 1 if none. */
+								/* 잡고 있는 상한 락 중 가장 높은 상한,
+								   없으면 PRI_MIN - 1. */
+	struct semaphore *wait_on_sema;		/* Semaphore the thread is blocked on. */
+										/* 스레드가 막혀 있는 세마포어. */
+	struct heap_elem sema_elem;			/* Element in wait_on_sema's waiters. */
+										/* wait_on_sema의 대기자 힙 요소. */
+	uint64_t sema_seq;					/* Arrival order in wait_on_sema. */
+										/* wait_on_sema에 도착한 순서. */
+	struct semaphore_elem *cond_waiter; /* Entry in a condition's waiters. */
+										/* 조건 변수 대기자 힙의 항목. */
+	struct rwlock *wait_on_rwlock;		/* Rwlock the thread is waiting for. */
+										/* 스레드가 기다리는 rwlock. */
+	bool rw_write;						/* Waiting to write, not to read? */
+										/* 읽기가 아닌 쓰기를 기다리는가? */
+	struct heap_elem rw_elem;			/* Element in wait_on_rwlock's waiters. */
+										/* wait_on_rwlock의 대기자 힙 요소. */
+	uint64_t rw_seq;					/* Arrival order in wait_on_rwlock. */
+										/* wait_on_rwlock에 도착한 순서. */
+	struct rwlock_hold rw_holds[RWLOCK_HOLD_MAX]; /* Rwlocks held. */
+												  /* 잡고 있는 rwlock. */
+
+	/* Owned by thread.c, used only by the MLFQS scheduler. */
+	/* 소유: thread.c, MLFQS 스케줄러에서만 사용합니다. */
+	int nice;					 /* Niceness. */
+								 /* nice 값. */
+	fixed_t recent_cpu;			 /* Recent CPU time received. */
+								 /* 최근에 사용한 CPU 시간. */
+	bool cpu_active;			 /* In cpu_list (recent_cpu or nice nonzero)? */
+								 /* cpu_list에 있는지 (recent_cpu나 nice가 0이 아님). */
+	struct list_elem cpu_elem;	 /* cpu_list element. */
+								 /* cpu_list 요소. */
+	bool dirty;					 /* In dirty_list (priority must be recomputed)? */
+								 /* dirty_list에 있는지 (우선순위 재계산 필요). */
+	struct list_elem dirty_elem; /* dirty_list element. */
+								 /* dirty_list 요소. */
+
+	/* Owned by thread.c, scheduler statistics. */
+	/* 소유: thread.c, 스케줄러 통계. */
+	struct list_elem all_elem;	   /* all_list element. */
+								   /* all_list 요소. */
+	uint64_t voluntary_switches;   /* Switches away after blocking or
+									  yielding. */
+								   /* 블록되거나 양보한 뒤의 문맥 전환 수. */
+	uint64_t involuntary_switches; /* Switches away on preemption. */
+								   /* 선점에 의한 문맥 전환 수. */
+	bool preempted;				   /* Yielding from thread_preempt()? */
+								   /* thread_preempt()에서 양보 중인지. */
+	uint64_t run_ticks;			   /* Timer ticks spent running. */
+								   /* 실행한 타이머 틱 수. */
+	uint64_t ready_ticks;		   /* Timer ticks spent ready to run. */
+								   /* 실행 대기한 타이머 틱 수. */
+	int64_t ready_since;		   /* Tick the thread last became ready. */
+								   /* 마지막으로 ready가 된 틱. */
+	uint64_t wakeup_cycles;		   /* rdtsc() when last woken, or 0. */
+								   /* 마지막으로 깨어난 rdtsc() 값 또는 0. */
+
+	/* Owned by threads/malloc.c. */
+	/* 소유: threads/malloc.c. */
+	struct malloc_cache *malloc_cache; /* Cached free blocks, or null. */
+									   /* 캐시된 가용 블록 또는 널. */
 
 #ifdef USERPROG
 	/* Owned by userprog/process.c. */
@@ -126,6 +195,12 @@ struct thread
 									  /* 자식 목록 */
 	struct list_elem child_elem;	  /* List element for child list */
 									  /* 자식 목록의 리스트 요소 */
+	struct thread *parent;			  /* Thread that may still reap us. */
+									  /* 아직 우리를 회수할 수 있는 스레드. */
+	bool reapable;					  /* Parent may wait for us. */
+									  /* 부모가 우리를 기다릴 수 있음. */
+	bool zombie;					  /* Exited, page kept for parent. */
+									  /* 종료됨, 부모를 위해 페이지 유지. */
 	struct semaphore duplicate_sema;  // 복제 완료를 알리기 위한 세마포어
 	struct semaphore child_wait_sema; // 자식 프로세스가 종료될 때까지 대기하기 위한 세마포어
 	// struct semaphore exit_sema;		   // 종료 완료를 알리기 위한 세마포어
@@ -139,6 +214,24 @@ struct thread
 	// fork가 끝나면 의미가 없어지므로, fork가 끝나면 NULL로 초기화
 	struct intr_frame parent_if; // 부모 프로세스의 intr_frame
 	struct file **fdt;			 // 파일 디스크립터 테이블
+	int fdt_end;				 // 사용한 적 있는 가장 큰 fd + 1
+
+	/* Resource usage, see struct rusage. */
+	/* 자원 사용량, struct rusage를 참조하세요. */
+	uint64_t minor_faults;	/* Faults resolved without I/O. */
+							/* 입출력 없이 해결된 페이지 오류 수. */
+	uint64_t major_faults;	/* Faults that read from disk. */
+							/* 디스크를 읽은 페이지 오류 수. */
+	uint64_t swapped_pages; /* Pages in swap now. */
+							/* 지금 스왑에 있는 페이지 수. */
+	uint64_t zero_pages;	/* Pages mapping the zero page now. */
+							/* 지금 0 페이지를 매핑한 페이지 수. */
+	uint64_t zero_page_hits; /* Faults that mapped the zero page. */
+							 /* 0 페이지를 매핑한 페이지 오류 수. */
+	uint64_t read_bytes;	/* Bytes read from files. */
+							/* 파일에서 읽은 바이트 수. */
+	uint64_t write_bytes;	/* Bytes written to files. */
+							/* 파일에 쓴 바이트 수. */
 #endif
 #ifdef VM
 	/* Table for whole virtual memory owned by thread. */
@@ -162,16 +255,35 @@ struct thread
    커널 명령줄 옵션 "-o mlfqs"로 제어합니다. */
 extern bool thread_mlfqs;
 
+/* If true, thread_print_stats() also prints the wakeup latency
+   histogram.  Controlled by kernel command-line option
+   "-sched-stats". */
+/* true이면 thread_print_stats()가 깨어남 지연 히스토그램도
+   출력합니다. 커널 명령줄 옵션 "-sched-stats"로 제어합니다. */
+extern bool thread_sched_stats;
+
 void thread_init(void);
 void thread_start(void);
 
 void thread_tick(void);
 void thread_print_stats(void);
+bool thread_get_sched_stat(tid_t, struct sched_stat *);
+#ifdef USERPROG
+bool thread_get_rusage(tid_t, struct rusage *);
+#endif
+void thread_release_tid(tid_t);
+#ifdef USERPROG
+void thread_reap(struct thread *);
+struct file **fdt_alloc(void);
+void fdt_free(struct file **, int end);
+#endif
 
 typedef void thread_func(void *aux);
 
 // Point of updates
 // 1. Insert thread in ready_list in the order of priority. (note that it is not scalable)
+//    -> ready_list는 우선순위별 FIFO 큐 64개와 64비트 비트마스크로 대체되어
+//       삽입과 next_thread_to_run()이 모두 O(1)입니다.
 // 2. When the thread is added to the ready_list, compare priority of new thread and priority of the current thread.
 // 3. If the priority of the new thread is higher, call schedule() (the current thread yields CPU).
 
@@ -201,6 +313,7 @@ void thread_exit(void) NO_RETURN;
 // The current thread yields CPU and it is inserted to `ready_list` in priority order.
 // 현재 스레드의 CPU 사용량을 산출하여 우선순위에 따라 `ready_list`에 삽입합니다.
 void thread_yield(void);
+void thread_preempt(void);
 
 void thread_sleep(int64_t tick);
 
@@ -224,13 +337,15 @@ int thread_get_priority(void);
 // TODO: donation을 고려하여 우선순위를 설정합니다.
 void thread_set_priority(int);
 
+// 스레드 T의 유효 우선순위를 바꾸고, ready 상태라면 해당 우선순위 큐로 옮깁니다.
+void thread_change_priority(struct thread *t, int priority);
+
 int thread_get_nice(void);
 void thread_set_nice(int);
 int thread_get_recent_cpu(void);
 int thread_get_load_avg(void);
 
 void do_iret(struct intr_frame *tf);
-bool larger(const struct list_elem *a, const struct list_elem *b, void *aux);
 
 void thread_try_yield(void);
 
@@ -3,6 +3,12 @@
 
 #include "threads/thread.h"
 
+/* If true, each process prints its resource usage when it
+   exits.  Controlled by kernel command-line option "-rusage". */
+/* true이면 각 프로세스가 종료할 때 자원 사용량을 출력합니다. 커널
+   명령줄 옵션 "-rusage"로 제어합니다. */
+extern bool process_rusage;
+
 tid_t process_create_initd (const char *file_name);
 tid_t process_fork (const char *name, struct intr_frame *if_);
 int process_exec (void *f_name);
@@ -1,13 +1,24 @@
 #ifndef VM_ANON_H
 #define VM_ANON_H
+#include <stdint.h>
 #include "vm/vm.h"
 struct page;
 enum vm_type;
 
+#define SWAP_SLOT_NONE SIZE_MAX /* Slot of a page with none. */
+                                /* 슬롯이 없는 페이지의 슬롯. */
+#define SWAP_CLUSTER 8          /* Most pages moved by one transfer. */
+                                /* 전송 한 번에 옮기는 최대 페이지 수. */
+
 struct anon_page {
+	size_t slot;            /* Swap slot, or SWAP_SLOT_NONE. */
+	                        /* 스왑 슬롯 또는 SWAP_SLOT_NONE. */
 };
 
 void vm_anon_init (void);
+void vm_anon_print_stats (void);
 bool anon_initializer (struct page *page, enum vm_type type, void *kva);
+bool anon_swap_out_cluster (struct page *pages[], size_t cnt);
+bool anon_slot_holds (size_t slot, struct page *page);
 
 #endif
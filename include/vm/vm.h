@@ -1,7 +1,10 @@
 #ifndef VM_VM_H
 #define VM_VM_H
+#include <list.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "threads/palloc.h"
+#include "threads/vaddr.h"
 
 enum vm_type {
 	/* page not initialized */
@@ -46,6 +49,18 @@ struct page {
 	struct frame *frame;   /* Back reference for frame */
 
 	/* Your implementation */
+	struct thread *owner;  /* Process whose page map maps the page. */
+	                       /* 페이지 맵에 페이지를 매핑하는 프로세스. */
+	bool writable;         /* True if the user may write the page. */
+	                       /* 사용자가 페이지에 쓸 수 있으면 참. */
+	bool dirty;            /* True if the frame holds changes that
+	                          the page table's dirty bit may not
+	                          show and that must be written out. */
+	                       /* 프레임에 페이지 테이블의 dirty 비트가 보여
+	                          주지 않을 수 있는, 써 내보내야 하는 변경이
+	                          있으면 참. */
+	struct list_elem frame_elem; /* Element in the frame's pages. */
+	                       /* 프레임의 pages 요소. */
 
 	/* Per-type data are binded into the union.
 	 * Each function automatically detects the current union */
@@ -60,9 +75,25 @@ struct page {
 };
 
 /* The representation of "frame" */
+/* Every frame of the user pool that holds a page is in the frame
+ * table, which vm.c walks with a CLOCK hand to pick victims.  After
+ * a fork, a frame is shared copy-on-write by the parent's page and
+ * the child's, each mapped read-only, until one of them writes. */
+/* "프레임"의 표현.
+ * 페이지를 담은 사용자 풀의 모든 프레임은 프레임 테이블에 있으며,
+ * vm.c는 CLOCK 바늘로 그 테이블을 돌며 희생자를 고릅니다. fork 뒤에는
+ * 부모의 페이지와 자식의 페이지가 각각 읽기 전용으로 매핑되어, 어느
+ * 한쪽이 쓸 때까지 프레임을 copy-on-write로 공유합니다. */
 struct frame {
 	void *kva;
-	struct page *page;
+	struct list pages;     /* Pages sharing the frame. */
+	                       /* 프레임을 공유하는 페이지들. */
+	size_t ref_cnt;        /* Number of pages in PAGES. */
+	                       /* PAGES에 있는 페이지 수. */
+	struct list_elem elem; /* Frame table element. */
+	                       /* 프레임 테이블 요소. */
+	unsigned pin_cnt;      /* Evictable only while zero. */
+	                       /* 0인 동안에만 내쫓을 수 있습니다. */
 };
 
 /* The function table for page operations.
@@ -82,9 +113,33 @@ struct page_operations {
 	if ((page)->operations->destroy) (page)->operations->destroy (page)
 
 /* Representation of current process's memory space.
- * We don't want to force you to obey any specific design for this struct.
- * All designs up to you for this. */
+ *
+ * The table is a radix tree laid out like the x86-64 page table
+ * that it supplements: four levels of nodes, each a page of
+ * SPT_FANOUT pointers indexed by nine bits of the user virtual
+ * address, with the struct pages in the leaves.  A lookup takes
+ * four steps however many pages the process has, and interior
+ * nodes are allocated only when a page is first inserted below
+ * them, so a sparse address space costs a node per populated
+ * 2 MB, 1 GB and 512 GB region and nothing for the holes between
+ * them. */
+/* 현재 프로세스의 메모리 공간 표현.
+ *
+ * 이 테이블은 보조하는 x86-64 페이지 테이블처럼 배치된 기수 트리입니다.
+ * 네 단계의 노드가 있고, 각 노드는 사용자 가상 주소의 9비트로
+ * 인덱싱되는 SPT_FANOUT개의 포인터로 된 한 페이지이며, 리프에
+ * struct page가 있습니다. 프로세스의 페이지 수와 상관없이 조회는 네
+ * 단계로 끝나며, 내부 노드는 그 아래에 페이지가 처음 삽입될 때만
+ * 할당되므로, 희소한 주소 공간은 채워진 2 MB, 1 GB, 512 GB 영역마다
+ * 노드 하나의 비용만 들고 그 사이의 빈 곳에는 비용이 들지 않습니다. */
+#define SPT_LEVELS 4                         /* Levels of nodes. */
+                                             /* 노드의 단계 수. */
+#define SPT_FANOUT (PGSIZE / sizeof (void *)) /* Entries per node. */
+                                             /* 노드당 항목 수. */
+
 struct supplemental_page_table {
+	void **root;           /* Top-level node, or NULL if empty. */
+	                       /* 최상위 노드, 비어 있으면 NULL. */
 };
 
 #include "threads/thread.h"
@@ -98,6 +153,7 @@ bool spt_insert_page (struct supplemental_page_table *spt, struct page *page);
 void spt_remove_page (struct supplemental_page_table *spt, struct page *page);
 
 void vm_init (void);
+void vm_print_stats (void);
 bool vm_try_handle_fault (struct intr_frame *f, void *addr, bool user,
 		bool write, bool not_present);
 
@@ -107,6 +163,10 @@ bool vm_alloc_page_with_initializer (enum vm_type type, void *upage,
 		bool writable, vm_initializer *init, void *aux);
 void vm_dealloc_page (struct page *page);
 bool vm_claim_page (void *va);
+bool vm_pin_buffer (const void *buffer, size_t size, bool write);
+void vm_unpin_buffer (const void *buffer, size_t size);
+bool vm_claim_frame_for_readahead (struct page *page, size_t slot);
+void vm_readahead_done (struct page *page);
 enum vm_type page_get_type (struct page *page);
 
 #endif  /* VM_VM_H */
@@ -70,6 +70,73 @@ last_mask(const struct bitmap *b)
 	return last_bits ? ((elem_type)1 << last_bits) - 1 : (elem_type)-1;
 }
 
+/* Returns an elem_type in which bits FIRST through LAST - 1 of
+   the element are set, where 0 <= FIRST < LAST <= ELEM_BITS. */
+/* 요소의 FIRST부터 LAST - 1까지의 비트가 켜진 elem_type을
+   반환합니다. 0 <= FIRST < LAST <= ELEM_BITS 이어야 합니다. */
+static inline elem_type
+range_mask(size_t first, size_t last)
+{
+	elem_type high = last < ELEM_BITS ? ((elem_type)1 << last) - 1 : (elem_type)-1;
+	return high & ~(((elem_type)1 << first) - 1);
+}
+
+/* Returns the number of set bits in E.  The POPCNT instruction
+   is not available on every CPU we run on, and without it GCC
+   calls a libgcc helper that the kernel does not link, so this
+   counts bits in parallel within the word instead. */
+/* E에서 켜진 비트 수를 반환합니다. POPCNT 명령어는 모든 CPU에서
+   쓸 수 있는 것이 아니고, 그것이 없으면 GCC는 커널이 링크하지
+   않는 libgcc 함수를 호출하므로, 대신 워드 안에서 비트를
+   병렬로 셉니다. */
+static inline size_t
+popcount(elem_type e)
+{
+	e = e - ((e >> 1) & 0x5555555555555555UL);
+	e = (e & 0x3333333333333333UL) + ((e >> 2) & 0x3333333333333333UL);
+	e = (e + (e >> 4)) & 0x0f0f0f0f0f0f0f0fUL;
+	return (e * 0x0101010101010101UL) >> 56;
+}
+
+/* Returns the index of the first bit in B at or after START and
+   before END that is set to VALUE, or END if there is none.
+   Whole elements that hold no such bit are skipped at once. */
+/* B에서 START 이상 END 미만인 비트 중 VALUE로 설정된 첫 비트의
+   인덱스를 반환하고, 없으면 END를 반환합니다. 그런 비트가 없는
+   요소는 한 번에 건너뜁니다. */
+static size_t
+find_next(const struct bitmap *b, size_t start, size_t end, bool value)
+{
+	size_t idx = elem_idx(start);
+	elem_type flip = value ? 0 : (elem_type)-1;
+	elem_type e;
+
+	if (start >= end)
+		return end;
+	e = (b->bits[idx] ^ flip) & ~(bit_mask(start) - 1);
+	while (e == 0)
+	{
+		if (++idx >= elem_cnt(end))
+			return end;
+		e = b->bits[idx] ^ flip;
+	}
+	start = idx * ELEM_BITS + __builtin_ctzl(e);
+	return start < end ? start : end;
+}
+
+/* Sets the bits of MASK in element E to VALUE atomically, in
+   the same way as bitmap_mark() and bitmap_reset(). */
+/* bitmap_mark() 및 bitmap_reset()과 같은 방식으로 요소 E에서
+   MASK의 비트들을 VALUE로 원자적으로 설정합니다. */
+static inline void
+elem_set(elem_type *e, elem_type mask, bool value)
+{
+	if (value)
+		asm("lock orq %1, %0" : "=m"(*e) : "r"(mask) : "cc");
+	else
+		asm("lock andq %1, %0" : "=m"(*e) : "r"(~mask) : "cc");
+}
+
 /* Creation and destruction. */
 
 /* Initializes B to be a bitmap of BIT_CNT bits
@@ -227,9 +294,14 @@ void bitmap_set_multiple(struct bitmap *b, size_t start, size_t cnt, bool value)
 	ASSERT(start <= b->bit_cnt);
 	ASSERT(start + cnt <= b->bit_cnt);
 
-	for (size_t i = 0; i < cnt; i++)
+	while (cnt > 0)
 	{
-		bitmap_set(b, start + i, value);
+		size_t first = start % ELEM_BITS;
+		size_t n = ELEM_BITS - first < cnt ? ELEM_BITS - first : cnt;
+
+		elem_set(&b->bits[elem_idx(start)], range_mask(first, first + n), value);
+		start += n;
+		cnt -= n;
 	}
 }
 
@@ -238,17 +310,22 @@ void bitmap_set_multiple(struct bitmap *b, size_t start, size_t cnt, bool value)
 size_t
 bitmap_count(const struct bitmap *b, size_t start, size_t cnt, bool value)
 {
-	size_t i, value_cnt;
+	size_t set_cnt = 0, left = cnt;
 
 	ASSERT(b != NULL);
 	ASSERT(start <= b->bit_cnt);
 	ASSERT(start + cnt <= b->bit_cnt);
 
-	value_cnt = 0;
-	for (i = 0; i < cnt; i++)
-		if (bitmap_test(b, start + i) == value)
-			value_cnt++;
-	return value_cnt;
+	while (left > 0)
+	{
+		size_t first = start % ELEM_BITS;
+		size_t n = ELEM_BITS - first < left ? ELEM_BITS - first : left;
+
+		set_cnt += popcount(b->bits[elem_idx(start)] & range_mask(first, first + n));
+		start += n;
+		left -= n;
+	}
+	return value ? set_cnt : cnt - set_cnt;
 }
 
 /* Returns true if any bits in B between START and START + CNT,
@@ -257,16 +334,11 @@ bitmap_count(const struct bitmap *b, size_t start, size_t cnt, bool value)
    참을 반환하고, 그렇지 않으면 거짓을 반환합니다. */
 bool bitmap_contains(const struct bitmap *b, size_t start, size_t cnt, bool value)
 {
-	size_t i;
-
 	ASSERT(b != NULL);
 	ASSERT(start <= b->bit_cnt);
 	ASSERT(start + cnt <= b->bit_cnt);
 
-	for (i = 0; i < cnt; i++)
-		if (bitmap_test(b, start + i) == value)
-			return true;
-	return false;
+	return find_next(b, start, start + cnt, value) < start + cnt;
 }
 
 /* Returns true if any bits in B between START and START + CNT,
@@ -307,17 +379,58 @@ size_t bitmap_scan(const struct bitmap *b, size_t start, size_t cnt, bool value)
 	ASSERT(b != NULL);
 	ASSERT(start <= b->bit_cnt);
 
-	if (cnt <= b->bit_cnt)
+	if (cnt == 0)
+		return start;
+	while (cnt <= b->bit_cnt - start)
 	{
-		size_t last = b->bit_cnt - cnt;
-		size_t i;
-		for (i = start; i <= last; i++)
-			if (!bitmap_contains(b, i, cnt, !value))
-				return i;
+		/* Jump to the next bit set to VALUE, then to the end of
+		   its run.  A run that is long enough is the answer;
+		   otherwise the search resumes after it, so no bit is
+		   examined twice. */
+		/* VALUE로 설정된 다음 비트로 건너뛴 다음, 그 구간의 끝으로
+		   건너뜁니다. 충분히 긴 구간이면 그것이 답이고, 아니면 그
+		   뒤에서 다시 찾으므로 어떤 비트도 두 번 검사하지 않습니다. */
+		size_t run_end;
+
+		start = find_next(b, start, b->bit_cnt, value);
+		if (cnt > b->bit_cnt - start)
+			break;
+		if (cnt == 1)
+			return start;
+		run_end = find_next(b, start, start + cnt, !value);
+		if (run_end == start + cnt)
+			return start;
+		start = run_end;
 	}
 	return BITMAP_ERROR;
 }
 
+/* Like bitmap_scan(), but starts at *CURSOR instead of a fixed
+   index and wraps around to the beginning of B if nothing is
+   found after it.  On success, *CURSOR is moved past the group
+   that was found, so repeated calls hand out groups in a
+   round-robin order instead of scanning the same full prefix of
+   B each time. */
+/* bitmap_scan()과 같지만, 고정된 인덱스 대신 *CURSOR에서 시작하고
+   그 뒤에서 찾지 못하면 B의 처음으로 돌아갑니다. 성공하면
+   *CURSOR를 찾은 그룹 뒤로 옮기므로, 반복 호출은 매번 B의 같은
+   꽉 찬 앞부분을 검색하는 대신 그룹을 차례로 나눠 줍니다. */
+size_t bitmap_scan_next_fit(const struct bitmap *b, size_t *cursor, size_t cnt, bool value)
+{
+	size_t start, idx;
+
+	ASSERT(b != NULL);
+	ASSERT(cursor != NULL);
+
+	start = *cursor <= b->bit_cnt ? *cursor : 0;
+	idx = bitmap_scan(b, start, cnt, value);
+	if (idx == BITMAP_ERROR && start > 0)
+		idx = bitmap_scan(b, 0, cnt, value);
+	if (idx != BITMAP_ERROR)
+		*cursor = idx + cnt < b->bit_cnt ? idx + cnt : 0;
+	return idx;
+}
+
 /* Finds the first group of CNT consecutive bits in B at or after
    START that are all set to VALUE, flips them all to !VALUE,
    and returns the index of the first bit in the group.
@@ -343,6 +456,19 @@ size_t bitmap_scan_and_flip(struct bitmap *b, size_t start, size_t cnt, bool val
 	return idx;
 }
 
+/* Like bitmap_scan_and_flip(), but finds the group with
+   bitmap_scan_next_fit(), starting at *CURSOR. */
+/* bitmap_scan_and_flip()과 같지만, *CURSOR에서 시작하여
+   bitmap_scan_next_fit()으로 그룹을 찾습니다. */
+size_t bitmap_scan_and_flip_next_fit(struct bitmap *b, size_t *cursor, size_t cnt, bool value)
+{
+	size_t idx = bitmap_scan_next_fit(b, cursor, cnt, value);
+
+	if (idx != BITMAP_ERROR)
+		bitmap_set_multiple(b, idx, cnt, !value);
+	return idx;
+}
+
 /* File input and output. */
 
 #ifdef FILESYS
@@ -18,6 +18,7 @@ static struct hash_elem *find_elem (struct hash *, struct list *,
 static void insert_elem (struct hash *, struct list *, struct hash_elem *);
 static void remove_elem (struct hash *, struct hash_elem *);
 static void rehash (struct hash *);
+static inline size_t is_power_of_2 (size_t);
 
 /* Initializes hash table H to compute hash values using HASH and
    compare hash elements using LESS, given auxiliary data AUX. */
@@ -30,6 +31,7 @@ hash_init (struct hash *h,
 	h->hash = hash;
 	h->less = less;
 	h->aux = aux;
+	h->fixed = false;
 
 	if (h->buckets != NULL) {
 		hash_clear (h, NULL);
@@ -38,6 +40,27 @@ hash_init (struct hash *h,
 		return false;
 }
 
+/* Initializes hash table H like hash_init(), but with the
+   BUCKET_CNT lists in BUCKETS as its buckets.  BUCKET_CNT must be
+   a power of 2.  The table never resizes itself, so it never
+   calls malloc() or free() and may be used where they cannot be,
+   such as inside the allocators themselves.  hash_destroy() does
+   not free BUCKETS. */
+void
+hash_init_fixed (struct hash *h, hash_hash_func *hash, hash_less_func *less,
+		void *aux, struct list *buckets, size_t bucket_cnt) {
+	ASSERT (is_power_of_2 (bucket_cnt));
+
+	h->elem_cnt = 0;
+	h->bucket_cnt = bucket_cnt;
+	h->buckets = buckets;
+	h->hash = hash;
+	h->less = less;
+	h->aux = aux;
+	h->fixed = true;
+	hash_clear (h, NULL);
+}
+
 /* Removes all the elements from H.
 
    If DESTRUCTOR is non-null, then it is called for each element
@@ -81,7 +104,8 @@ void
 hash_destroy (struct hash *h, hash_action_func *destructor) {
 	if (destructor != NULL)
 		hash_clear (h, destructor);
-	free (h->buckets);
+	if (!h->fixed)
+		free (h->buckets);
 }
 
 /* Inserts NEW into hash table H and returns a null pointer, if
@@ -326,6 +350,9 @@ rehash (struct hash *h) {
 
 	ASSERT (h != NULL);
 
+	if (h->fixed)
+		return;
+
 	/* Save old bucket info for later use. */
 	old_buckets = h->buckets;
 	old_bucket_cnt = h->bucket_cnt;
@@ -0,0 +1,227 @@
+#include "heap.h"
+#include "../debug.h"
+
+/* A pairing heap is a heap-ordered multiway tree.  Each node
+   keeps a pointer to its leftmost child, and the children of a
+   node form a doubly linked sibling list whose leftmost member
+   points back to the parent.  Two heaps are melded by making the
+   smaller root the leftmost child of the greater one, and the
+   root is popped by melding its children pairwise, left to
+   right, and then melding the pairs right to left.
+
+   See Fredman, Sedgewick, Sleator and Tarjan, "The pairing
+   heap: A new form of self-adjusting heap", Algorithmica 1
+   (1986). */
+/* 페어링 힙은 힙 순서를 만족하는 다진 트리입니다. 각 노드는 가장
+   왼쪽 자식에 대한 포인터를 가지며, 한 노드의 자식들은 이중 연결
+   형제 리스트를 이루고 그중 가장 왼쪽 자식은 부모를 가리킵니다. 두
+   힙은 작은 쪽 루트를 큰 쪽 루트의 가장 왼쪽 자식으로 붙여 합치고,
+   루트를 꺼낼 때는 자식들을 왼쪽에서 오른쪽으로 둘씩 합친 뒤 그
+   결과를 오른쪽에서 왼쪽으로 합칩니다.
+
+   Fredman, Sedgewick, Sleator, Tarjan, "The pairing heap: A new
+   form of self-adjusting heap", Algorithmica 1 (1986)을 참고하세요. */
+
+/* Melds the heaps rooted at A and B, which must not have
+   siblings or parents, and returns the new root. */
+/* 형제나 부모가 없는 A와 B를 루트로 하는 두 힙을 합치고 새 루트를
+   반환합니다. */
+static struct heap_elem *meld(struct heap *heap, struct heap_elem *a,
+							  struct heap_elem *b)
+{
+	if (a == NULL)
+		return b;
+	if (b == NULL)
+		return a;
+	if (heap->less(a, b, heap->aux))
+	{
+		struct heap_elem *t = a;
+		a = b;
+		b = t;
+	}
+
+	b->prev = a;
+	b->next = a->child;
+	if (a->child != NULL)
+		a->child->prev = b;
+	a->child = b;
+	return a;
+}
+
+/* Melds the sibling list starting at FIRST into one heap and
+   returns its root. */
+/* FIRST로 시작하는 형제 리스트를 하나의 힙으로 합치고 그 루트를
+   반환합니다. */
+static struct heap_elem *merge_pairs(struct heap *heap, struct heap_elem *first)
+{
+	struct heap_elem *pairs = NULL;
+
+	/* First pass: meld pairs left to right, stacking the results
+	   so that the second pass sees them right to left. */
+	/* 첫 번째 단계: 왼쪽에서 오른쪽으로 둘씩 합치고, 두 번째 단계에서
+	   오른쪽부터 보도록 결과를 스택에 쌓습니다. */
+	while (first != NULL)
+	{
+		struct heap_elem *a = first;
+		struct heap_elem *b = a->next;
+		first = b != NULL ? b->next : NULL;
+
+		a->next = a->prev = NULL;
+		if (b != NULL)
+			b->next = b->prev = NULL;
+		a = meld(heap, a, b);
+		a->next = pairs;
+		pairs = a;
+	}
+
+	/* Second pass: meld the pairs into one heap. */
+	/* 두 번째 단계: 쌍들을 하나의 힙으로 합칩니다. */
+	struct heap_elem *root = NULL;
+	while (pairs != NULL)
+	{
+		struct heap_elem *next = pairs->next;
+		pairs->next = NULL;
+		root = meld(heap, root, pairs);
+		pairs = next;
+	}
+	return root;
+}
+
+/* Unlinks E, which must not be the root, together with its
+   subtree from its parent and siblings. */
+/* 루트가 아닌 E를 서브트리와 함께 부모와 형제에게서 떼어 냅니다. */
+static void detach(struct heap_elem *e)
+{
+	ASSERT(e->prev != NULL);
+
+	if (e->prev->child == e)
+		e->prev->child = e->next;
+	else
+		e->prev->next = e->next;
+	if (e->next != NULL)
+		e->next->prev = e->prev;
+	e->next = e->prev = NULL;
+}
+
+/* Initializes HEAP as an empty heap ordered by LESS given
+   auxiliary data AUX. */
+/* HEAP을 보조 데이터 AUX와 함께 LESS로 정렬되는 빈 힙으로
+   초기화합니다. */
+void heap_init(struct heap *heap, heap_less_func *less, void *aux)
+{
+	ASSERT(heap != NULL);
+	ASSERT(less != NULL);
+
+	heap->root = NULL;
+	heap->size = 0;
+	heap->less = less;
+	heap->aux = aux;
+}
+
+/* Inserts E into HEAP. */
+/* E를 HEAP에 삽입합니다. */
+void heap_push(struct heap *heap, struct heap_elem *e)
+{
+	ASSERT(heap != NULL);
+	ASSERT(e != NULL);
+
+	e->child = e->next = e->prev = NULL;
+	heap->root = meld(heap, heap->root, e);
+	heap->size++;
+}
+
+/* Returns the greatest element of HEAP, or NULL if HEAP is
+   empty. */
+/* HEAP의 가장 큰 요소를 반환하고, HEAP이 비어 있으면 NULL을
+   반환합니다. */
+struct heap_elem *heap_top(const struct heap *heap)
+{
+	ASSERT(heap != NULL);
+
+	return heap->root;
+}
+
+/* Removes and returns the greatest element of HEAP, or returns
+   NULL if HEAP is empty. */
+/* HEAP의 가장 큰 요소를 제거하고 반환하며, HEAP이 비어 있으면
+   NULL을 반환합니다. */
+struct heap_elem *heap_pop(struct heap *heap)
+{
+	ASSERT(heap != NULL);
+
+	struct heap_elem *top = heap->root;
+	if (top != NULL)
+	{
+		heap->root = merge_pairs(heap, top->child);
+		top->child = NULL;
+		heap->size--;
+	}
+	return top;
+}
+
+/* Removes E, which must be in HEAP, from HEAP. */
+/* HEAP에 들어 있는 E를 HEAP에서 제거합니다. */
+void heap_remove(struct heap *heap, struct heap_elem *e)
+{
+	ASSERT(heap != NULL);
+	ASSERT(e != NULL);
+
+	if (e == heap->root)
+	{
+		heap_pop(heap);
+		return;
+	}
+
+	detach(e);
+	heap->root = meld(heap, heap->root, merge_pairs(heap, e->child));
+	e->child = NULL;
+	heap->size--;
+}
+
+/* Restores HEAP's order after the key of E, which must be in
+   HEAP, has increased or stayed the same. */
+/* HEAP에 들어 있는 E의 키가 커지거나 그대로일 때 HEAP의 순서를
+   복구합니다. */
+void heap_increase(struct heap *heap, struct heap_elem *e)
+{
+	ASSERT(heap != NULL);
+	ASSERT(e != NULL);
+
+	if (e == heap->root)
+		return;
+
+	/* E's subtree is still heap-ordered, so it can be cut out
+	   and melded back in as a whole. */
+	/* E의 서브트리는 여전히 힙 순서를 만족하므로 통째로 잘라 내어
+	   다시 합칠 수 있습니다. */
+	detach(e);
+	heap->root = meld(heap, heap->root, e);
+}
+
+/* Restores HEAP's order after the key of E, which must be in
+   HEAP, has changed in either direction. */
+/* HEAP에 들어 있는 E의 키가 어느 방향으로든 바뀐 뒤 HEAP의 순서를
+   복구합니다. */
+void heap_update(struct heap *heap, struct heap_elem *e)
+{
+	heap_remove(heap, e);
+	heap_push(heap, e);
+}
+
+/* Returns the number of elements in HEAP. */
+/* HEAP의 요소 수를 반환합니다. */
+size_t heap_size(const struct heap *heap)
+{
+	ASSERT(heap != NULL);
+
+	return heap->size;
+}
+
+/* Returns true if HEAP is empty, false otherwise. */
+/* HEAP이 비어 있으면 true를, 그렇지 않으면 false를 반환합니다. */
+bool heap_empty(const struct heap *heap)
+{
+	ASSERT(heap != NULL);
+
+	return heap->root == NULL;
+}
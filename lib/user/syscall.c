@@ -200,3 +200,13 @@ int umount(const char *path)
 {
 	return syscall1(SYS_UMOUNT, path);
 }
+
+int sched_stat(pid_t tid, struct sched_stat *stat)
+{
+	return syscall2(SYS_SCHED_STAT, tid, stat);
+}
+
+int getrusage(pid_t pid, struct rusage *usage)
+{
+	return syscall2(SYS_GETRUSAGE, pid, usage);
+}
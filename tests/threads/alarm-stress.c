@@ -0,0 +1,119 @@
+/* Creates thousands of threads that each sleep a different
+   duration several times, spread so that wake-ups land both in
+   the near timing wheel and in its outer levels.  Verifies that
+   no thread wakes up early and that every sleep completes, then
+   reports how much time was spent in the timer interrupt. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/malloc.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "devices/timer.h"
+#include "intrinsic.h"
+
+#define SLEEPER_CNT 2000        /* Number of sleeping threads. */
+#define ITERATIONS 3            /* Sleeps per thread. */
+#define MAX_DURATION 600        /* Longest sleep, in ticks. */
+
+/* Information about the test. */
+struct stress_test
+  {
+    int64_t start;              /* Current time at start of test. */
+    struct semaphore done;      /* Upped once by each finished thread. */
+    struct lock lock;           /* Protects `early'. */
+    int early;                  /* Number of early wake-ups. */
+  };
+
+/* Information about an individual thread in the test. */
+struct stress_thread
+  {
+    struct stress_test *test;   /* Info shared between all threads. */
+    int duration;               /* Number of ticks to sleep. */
+  };
+
+static void sleeper (void *);
+
+void
+test_alarm_stress (void) 
+{
+  struct stress_test test;
+  struct stress_thread *threads;
+  int64_t start_ticks, elapsed;
+  uint64_t start_cycles, start_intr, cycles, intr;
+  int i;
+
+  /* This test does not work with the MLFQS. */
+  ASSERT (!thread_mlfqs);
+
+  msg ("Creating %d threads to sleep %d times each.", SLEEPER_CNT, ITERATIONS);
+
+  threads = malloc (sizeof *threads * SLEEPER_CNT);
+  if (threads == NULL)
+    PANIC ("couldn't allocate memory for test");
+
+  test.start = timer_ticks () + 200;
+  sema_init (&test.done, 0);
+  lock_init (&test.lock);
+  test.early = 0;
+
+  start_ticks = timer_ticks ();
+  start_cycles = rdtsc ();
+  start_intr = timer_interrupt_cycles ();
+
+  for (i = 0; i < SLEEPER_CNT; i++)
+    {
+      struct stress_thread *t = threads + i;
+      char name[16];
+
+      t->test = &test;
+      t->duration = 1 + (i * 7) % MAX_DURATION;
+      snprintf (name, sizeof name, "sleeper %d", i);
+      if (thread_create (name, PRI_DEFAULT, sleeper, t) == TID_ERROR)
+        fail ("couldn't create thread %d", i);
+    }
+
+  for (i = 0; i < SLEEPER_CNT; i++)
+    sema_down (&test.done);
+
+  elapsed = timer_elapsed (start_ticks);
+  cycles = rdtsc () - start_cycles;
+  intr = timer_interrupt_cycles () - start_intr;
+
+  if (test.early != 0)
+    fail ("%d sleeps woke up early", test.early);
+
+  msg ("%d sleeps completed in %lld ticks.", SLEEPER_CNT * ITERATIONS,
+       elapsed);
+  if (cycles != 0)
+    msg ("Timer interrupt: %llu cycles (%llu per tick), "
+         "about %llu.%02llu ticks of %lld.",
+         intr, elapsed > 0 ? intr / elapsed : 0,
+         intr * elapsed / cycles, intr * elapsed * 100 / cycles % 100,
+         elapsed);
+  free (threads);
+  pass ();
+}
+
+/* Sleeper thread. */
+static void
+sleeper (void *t_) 
+{
+  struct stress_thread *t = t_;
+  struct stress_test *test = t->test;
+  int i;
+
+  for (i = 1; i <= ITERATIONS; i++) 
+    {
+      int64_t sleep_until = test->start + i * t->duration;
+      timer_sleep (sleep_until - timer_ticks ());
+      if (timer_ticks () < sleep_until)
+        {
+          lock_acquire (&test->lock);
+          test->early++;
+          lock_release (&test->lock);
+        }
+    }
+  sema_up (&test->done);
+}
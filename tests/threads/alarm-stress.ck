@@ -0,0 +1,16 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+fail "Some sleeps did not complete.\n"
+  if !grep (/^\(alarm-stress\) 6000 sleeps completed in \d+ ticks\.$/, @output);
+fail "Test did not pass.\n"
+  if !grep (/^\(alarm-stress\) PASS$/, @output);
+pass;
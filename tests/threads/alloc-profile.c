@@ -0,0 +1,80 @@
+/* Turns the allocation profiler on and checks that it tracks
+   malloc() blocks and palloc() runs as they are allocated,
+   resized and freed.  Then dumps the call sites holding the most
+   memory, with the test's own blocks among them. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/allocprof.h"
+#include "threads/init.h"
+#include "threads/malloc.h"
+#include "threads/palloc.h"
+#include "threads/vaddr.h"
+
+#define BLOCK_CNT 64            /* Blocks to allocate. */
+#define BLOCK_SIZE 200          /* Bytes in each block. */
+#define PAGE_CNT 3              /* Pages in the palloc() run. */
+
+static void check_live (enum allocprof_kind, size_t base_bytes,
+                        size_t base_cnt, size_t bytes, size_t cnt);
+
+void
+test_alloc_profile (void)
+{
+  size_t malloc_bytes, malloc_cnt, palloc_bytes, palloc_cnt;
+  void *blocks[BLOCK_CNT];
+  void *pages;
+  int i;
+
+  allocprof_init ();
+  malloc_bytes = allocprof_live (ALLOCPROF_MALLOC, &malloc_cnt);
+  palloc_bytes = allocprof_live (ALLOCPROF_PALLOC, &palloc_cnt);
+
+  for (i = 0; i < BLOCK_CNT; i++)
+    {
+      blocks[i] = malloc (BLOCK_SIZE);
+      if (blocks[i] == NULL)
+        fail ("malloc failed");
+    }
+  check_live (ALLOCPROF_MALLOC, malloc_bytes, malloc_cnt,
+              BLOCK_CNT * BLOCK_SIZE, BLOCK_CNT);
+  msg ("malloc() blocks are tracked.");
+
+  blocks[0] = realloc (blocks[0], 2 * BLOCK_SIZE);
+  if (blocks[0] == NULL)
+    fail ("realloc failed");
+  check_live (ALLOCPROF_MALLOC, malloc_bytes, malloc_cnt,
+              (BLOCK_CNT + 1) * BLOCK_SIZE, BLOCK_CNT);
+  msg ("realloc() moves the block's record.");
+
+  pages = palloc_get_multiple (0, PAGE_CNT);
+  if (pages == NULL)
+    fail ("palloc_get_multiple failed");
+  check_live (ALLOCPROF_PALLOC, palloc_bytes, palloc_cnt,
+              PAGE_CNT * PGSIZE, 1);
+  msg ("palloc() runs are tracked.");
+
+  allocprof_dump (3);
+
+  for (i = 0; i < BLOCK_CNT; i++)
+    free (blocks[i]);
+  palloc_free_multiple (pages, PAGE_CNT);
+  check_live (ALLOCPROF_MALLOC, malloc_bytes, malloc_cnt, 0, 0);
+  check_live (ALLOCPROF_PALLOC, palloc_bytes, palloc_cnt, 0, 0);
+  msg ("Freed allocations are forgotten.");
+  pass ();
+}
+
+/* Fails unless the tracked allocations from KIND hold BYTES
+   bytes in CNT allocations more than BASE_BYTES and BASE_CNT. */
+static void
+check_live (enum allocprof_kind kind, size_t base_bytes, size_t base_cnt,
+            size_t bytes, size_t cnt)
+{
+  size_t live_cnt;
+  size_t live_bytes = allocprof_live (kind, &live_cnt);
+
+  if (live_bytes - base_bytes != bytes || live_cnt - base_cnt != cnt)
+    fail ("%zu bytes in %zu allocations tracked, expected %zu in %zu",
+          live_bytes - base_bytes, live_cnt - base_cnt, bytes, cnt);
+}
@@ -0,0 +1,32 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the dump, whose addresses and totals vary from build to
+# build, after checking that it lists some call sites.
+fail "No allocation profile dumped\n"
+  if !grep (/^Live allocations by call site/, @output);
+fail "No malloc call sites dumped\n"
+  if !grep (/^  malloc /, @output);
+@output = grep (!/^Live allocations by call site|^  [mp]alloc /, @output);
+
+my (@expected) = split ("\n", <<'END');
+(alloc-profile) begin
+(alloc-profile) malloc() blocks are tracked.
+(alloc-profile) realloc() moves the block's record.
+(alloc-profile) palloc() runs are tracked.
+(alloc-profile) Freed allocations are forgotten.
+(alloc-profile) PASS
+(alloc-profile) end
+END
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
@@ -0,0 +1,193 @@
+/* Fills a 64K-bit bitmap with short random runs of set and
+   clear bits, then checks bitmap_scan(), bitmap_count() and
+   bitmap_contains() against bit-at-a-time versions built on
+   bitmap_test() and compares the cycles each takes.  Finally
+   hands out single bits from a map whose front is full, once
+   first-fit and once next-fit, and compares those too. */
+
+#include <bitmap.h>
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "intrinsic.h"
+
+#define BIT_CNT 65536           /* Bits in the bitmap. */
+#define SCAN_CNT 64             /* Scans timed per run length. */
+#define ALLOC_CNT 512           /* Bits handed out per policy. */
+
+static unsigned seed;
+
+static void fragment (struct bitmap *);
+static void compare_scan (const struct bitmap *, size_t cnt);
+static void compare_count (const struct bitmap *);
+static void compare_fit (void);
+
+void
+test_bitmap_bench (void)
+{
+  struct bitmap *b = bitmap_create (BIT_CNT);
+
+  if (b == NULL)
+    fail ("bitmap_create failed");
+  fragment (b);
+  compare_scan (b, 1);
+  compare_scan (b, 8);
+  compare_scan (b, 40);
+  compare_count (b);
+  bitmap_destroy (b);
+  compare_fit ();
+  pass ();
+}
+
+/* Returns a pseudo-random number. */
+static unsigned
+next_random (void)
+{
+  seed = seed * 1103515245 + 12345;
+  return seed >> 16;
+}
+
+/* Sets B to alternating runs of 1 to 32 set bits and 1 to 12
+   clear bits, so that free runs are short and scattered. */
+static void
+fragment (struct bitmap *b)
+{
+  size_t i = 0;
+
+  seed = 1;
+  bitmap_set_all (b, false);
+  while (i < BIT_CNT)
+    {
+      size_t used = next_random () % 32 + 1;
+      size_t gap = next_random () % 12 + 1;
+
+      if (used > BIT_CNT - i)
+        used = BIT_CNT - i;
+      bitmap_set_multiple (b, i, used, true);
+      i += used + gap;
+    }
+}
+
+/* bitmap_scan() as it was before it worked a word at a time:
+   tests every candidate start bit by bit. */
+static size_t
+slow_scan (const struct bitmap *b, size_t start, size_t cnt, bool value)
+{
+  size_t i, j;
+
+  for (i = start; i + cnt <= bitmap_size (b); i++)
+    {
+      for (j = 0; j < cnt; j++)
+        if (bitmap_test (b, i + j) != value)
+          break;
+      if (j == cnt)
+        return i;
+    }
+  return BITMAP_ERROR;
+}
+
+/* Checks and times SCAN_CNT scans of B for CNT clear bits from
+   spread-out starting points. */
+static void
+compare_scan (const struct bitmap *b, size_t cnt)
+{
+  uint64_t start, slow_cycles, fast_cycles;
+  size_t results[SCAN_CNT];
+  int i;
+
+  start = rdtsc ();
+  for (i = 0; i < SCAN_CNT; i++)
+    results[i] = slow_scan (b, i * (BIT_CNT / SCAN_CNT), cnt, false);
+  slow_cycles = rdtsc () - start;
+
+  start = rdtsc ();
+  for (i = 0; i < SCAN_CNT; i++)
+    {
+      size_t idx = bitmap_scan (b, i * (BIT_CNT / SCAN_CNT), cnt, false);
+      if (idx != results[i])
+        fail ("scan %d for %zu bits found %zu, expected %zu",
+              i, cnt, idx, results[i]);
+    }
+  fast_cycles = rdtsc () - start;
+
+  msg ("Scans for %zu clear bits agree.", cnt);
+  msg ("Scans for %zu clear bits: %llu cycles bit by bit, %llu by words.",
+       cnt, slow_cycles, fast_cycles);
+}
+
+/* Checks and times counting and testing for set bits over B
+   in 1000-bit windows. */
+static void
+compare_count (const struct bitmap *b)
+{
+  uint64_t start, slow_cycles, fast_cycles;
+  size_t slow_total = 0, fast_total = 0;
+  size_t ofs, i;
+
+  start = rdtsc ();
+  for (ofs = 0; ofs + 1000 <= BIT_CNT; ofs += 1000)
+    for (i = 0; i < 1000; i++)
+      if (bitmap_test (b, ofs + i))
+        slow_total++;
+  slow_cycles = rdtsc () - start;
+
+  start = rdtsc ();
+  for (ofs = 0; ofs + 1000 <= BIT_CNT; ofs += 1000)
+    {
+      size_t n = bitmap_count (b, ofs, 1000, true);
+      if (bitmap_contains (b, ofs, 1000, true) != (n != 0))
+        fail ("bitmap_contains disagrees with bitmap_count at %zu", ofs);
+      if (bitmap_count (b, ofs, 1000, false) != 1000 - n)
+        fail ("set and clear counts at %zu do not add up", ofs);
+      fast_total += n;
+    }
+  fast_cycles = rdtsc () - start;
+
+  if (slow_total != fast_total)
+    fail ("counted %zu set bits, expected %zu", fast_total, slow_total);
+  msg ("Counts of set bits agree.");
+  msg ("Counts of set bits: %llu cycles bit by bit, %llu by words.",
+       slow_cycles, fast_cycles);
+}
+
+/* Hands out ALLOC_CNT single bits from a map whose first 60K
+   bits are full, first with bitmap_scan_and_flip() from bit 0
+   and then with bitmap_scan_and_flip_next_fit(), and checks that
+   both hand out the same bits. */
+static void
+compare_fit (void)
+{
+  struct bitmap *first = bitmap_create (BIT_CNT);
+  struct bitmap *next = bitmap_create (BIT_CNT);
+  uint64_t start, first_cycles, next_cycles;
+  size_t cursor = 0;
+  int i;
+
+  if (first == NULL || next == NULL)
+    fail ("bitmap_create failed");
+  bitmap_set_multiple (first, 0, 60 * 1024, true);
+  bitmap_set_multiple (next, 0, 60 * 1024, true);
+
+  start = rdtsc ();
+  for (i = 0; i < ALLOC_CNT; i++)
+    if (bitmap_scan_and_flip (first, 0, 1, false) == BITMAP_ERROR)
+      fail ("first-fit allocation %d failed", i);
+  first_cycles = rdtsc () - start;
+
+  start = rdtsc ();
+  for (i = 0; i < ALLOC_CNT; i++)
+    if (bitmap_scan_and_flip_next_fit (next, &cursor, 1, false)
+        == BITMAP_ERROR)
+      fail ("next-fit allocation %d failed", i);
+  next_cycles = rdtsc () - start;
+
+  if (bitmap_count (first, 0, BIT_CNT, true)
+      != bitmap_count (next, 0, BIT_CNT, true)
+      || bitmap_scan (first, 0, 1, false) != bitmap_scan (next, 0, 1, false))
+    fail ("first fit and next fit handed out different bits");
+  msg ("First fit and next fit hand out the same bits.");
+  msg ("%d allocations: %llu cycles first fit, %llu next fit.",
+       ALLOC_CNT, first_cycles, next_cycles);
+  bitmap_destroy (first);
+  bitmap_destroy (next);
+}
@@ -0,0 +1,28 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the timing lines, whose values vary from run to run.
+@output = grep (!/ cycles /, @output);
+
+my (@expected) = split ("\n", <<'END');
+(bitmap-bench) begin
+(bitmap-bench) Scans for 1 clear bits agree.
+(bitmap-bench) Scans for 8 clear bits agree.
+(bitmap-bench) Scans for 40 clear bits agree.
+(bitmap-bench) Counts of set bits agree.
+(bitmap-bench) First fit and next fit hand out the same bits.
+(bitmap-bench) PASS
+(bitmap-bench) end
+END
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
@@ -0,0 +1,106 @@
+/* Maps a 2 MB block of user pages into a fresh page map with a
+   single large page and checks that lookups, pml4_for_each(),
+   protection changes and partial unmapping all see the right
+   4 kB pages, splitting the large page where needed.  Also
+   checks that the kernel's direct map uses large pages away from
+   the kernel text. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/mmu.h"
+#include "threads/palloc.h"
+#include "threads/vaddr.h"
+
+/* A 2 MB-aligned user address to map the block at. */
+#define UPAGE ((uint8_t *) 0x10000000)
+
+static bool count_page (uint64_t *pte, void *va, void *aux);
+
+void
+test_large_page (void)
+{
+  uint64_t *pml4, *pte;
+  uint8_t *kpage, *upage;
+  size_t mapped = 0;
+  void *kernel_page;
+  size_t i;
+
+  /* Most of the direct map should use large pages. */
+  kernel_page = palloc_get_multiple (0, LPGCNT * 2);
+  if (kernel_page == NULL)
+    fail ("palloc_get_multiple failed");
+  pte = pml4e_walk (base_pml4,
+                    (uint64_t) kernel_page + LPGSIZE - lpg_ofs (kernel_page),
+                    false);
+  if (pte == NULL || !is_large_pte (pte))
+    fail ("kernel pool page is not mapped by a large page");
+  palloc_free_multiple (kernel_page, LPGCNT * 2);
+  msg ("Kernel direct map uses large pages.");
+
+  kpage = palloc_get_multiple (PAL_USER | PAL_ZERO, LPGCNT);
+  if (kpage == NULL)
+    fail ("palloc_get_multiple failed");
+  if (lpg_ofs (vtop (kpage)) != 0)
+    {
+      /* The user pool only starts on a 2 MB boundary when the
+         memory map allows it. */
+      palloc_free_multiple (kpage, LPGCNT);
+      msg ("User pool is not 2 MB aligned; skipping.");
+      pass ();
+      return;
+    }
+  pml4 = pml4_create ();
+  if (pml4 == NULL)
+    fail ("pml4_create failed");
+  if (!pml4_set_large_page (pml4, UPAGE, kpage, true))
+    fail ("pml4_set_large_page failed");
+  if (pml4_set_large_page (pml4, UPAGE, kpage, true))
+    fail ("pml4_set_large_page mapped over a large page");
+
+  for (i = 0; i < LPGCNT; i++)
+    if (pml4_get_page (pml4, UPAGE + i * PGSIZE + 7) != kpage + i * PGSIZE + 7)
+      fail ("page %zu of the large page resolves wrongly", i);
+  pml4_for_each (pml4, count_page, &mapped);
+  if (mapped != LPGCNT)
+    fail ("pml4_for_each saw %zu user pages, expected %zu", mapped, LPGCNT);
+  msg ("Large page maps %zu pages.", mapped);
+
+  /* Write-protecting one page splits the large page. */
+  upage = UPAGE + 5 * PGSIZE;
+  if (!pml4_set_writable (pml4, upage, false))
+    fail ("pml4_set_writable failed");
+  pte = pml4e_walk (pml4, (uint64_t) upage, false);
+  if (pte == NULL || is_large_pte (pte) || is_writable (pte))
+    fail ("page was not split off and write-protected");
+  pte = pml4e_walk (pml4, (uint64_t) (upage + PGSIZE), false);
+  if (pte == NULL || !is_writable (pte))
+    fail ("neighbouring page lost its write permission");
+  msg ("Protecting one page splits the large page.");
+
+  /* Unmapping one page leaves the others mapped. */
+  pml4_clear_page (pml4, upage);
+  if (pml4_get_page (pml4, upage) != NULL)
+    fail ("cleared page is still mapped");
+  for (i = 0; i < LPGCNT; i++)
+    if (UPAGE + i * PGSIZE != upage
+        && pml4_get_page (pml4, UPAGE + i * PGSIZE) != kpage + i * PGSIZE)
+      fail ("page %zu changed when another page was cleared", i);
+  msg ("Clearing one page leaves the rest mapped.");
+
+  /* The cleared page no longer belongs to the page table. */
+  palloc_free_page (kpage + 5 * PGSIZE);
+  pml4_destroy (pml4);
+  pass ();
+}
+
+/* Counts the user pages that pml4_for_each() visits. */
+static bool
+count_page (uint64_t *pte UNUSED, void *va, void *aux)
+{
+  size_t *cnt = aux;
+
+  if (is_user_vaddr (va))
+    ++*cnt;
+  return true;
+}
@@ -0,0 +1,20 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF', <<'EOF']);
+(large-page) begin
+(large-page) Kernel direct map uses large pages.
+(large-page) Large page maps 512 pages.
+(large-page) Protecting one page splits the large page.
+(large-page) Clearing one page leaves the rest mapped.
+(large-page) PASS
+(large-page) end
+EOF
+(large-page) begin
+(large-page) Kernel direct map uses large pages.
+(large-page) User pool is not 2 MB aligned; skipping.
+(large-page) PASS
+(large-page) end
+EOF
+pass;
@@ -0,0 +1,159 @@
+/* Runs several threads that each malloc() and free() blocks of
+   random sizes from 1 to 8192 bytes, filling every block with a
+   pattern and checking it before the block is freed, so that a
+   block handed out twice or overlapping another one is caught.
+   Then checks that 520- and 5000-byte requests no longer waste
+   half of their memory and prints the cycles a malloc()/free()
+   pair takes on one thread. */
+
+#include <stdio.h>
+#include <string.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/malloc.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "threads/vaddr.h"
+#include "intrinsic.h"
+
+#define THREAD_CNT 4            /* Number of worker threads. */
+#define OP_CNT 4000             /* Operations per worker. */
+#define SLOT_CNT 32             /* Blocks a worker holds at once. */
+#define MAX_SIZE 8192           /* Largest block size. */
+#define TIMED_CNT 1000          /* Pairs timed per size. */
+
+static struct semaphore done;
+
+static thread_func worker_thread_func;
+static void check_footprint (size_t size, size_t limit);
+static void time_pairs (size_t size);
+
+void
+test_malloc_stress (void)
+{
+  int i;
+
+  sema_init (&done, 0);
+  for (i = 0; i < THREAD_CNT; i++)
+    {
+      char name[16];
+
+      snprintf (name, sizeof name, "worker %d", i);
+      thread_create (name, PRI_DEFAULT, worker_thread_func, (void *) (long) i);
+    }
+  for (i = 0; i < THREAD_CNT; i++)
+    sema_down (&done);
+  msg ("%d threads, %d operations each: no block was overwritten.",
+       THREAD_CNT, OP_CNT);
+
+  check_footprint (520, 1024);
+  check_footprint (5000, 2 * PGSIZE);
+
+  time_pairs (48);
+  time_pairs (5000);
+  pass ();
+}
+
+/* Returns the byte a block of SIZE bytes in slot SLOT of worker
+   ID is filled with. */
+static unsigned char
+pattern (int id, int slot, size_t size)
+{
+  return (unsigned char) (id * 67 + slot * 13 + size);
+}
+
+/* Fails the test if the block of SIZE bytes at P does not hold
+   its pattern. */
+static void
+check_block (const unsigned char *p, int id, int slot, size_t size)
+{
+  unsigned char c = pattern (id, slot, size);
+  size_t i;
+
+  for (i = 0; i < size; i++)
+    if (p[i] != c)
+      fail ("block of %zu bytes overwritten at byte %zu", size, i);
+}
+
+static void
+worker_thread_func (void *id_)
+{
+  int id = (int) (long) id_;
+  unsigned char *blocks[SLOT_CNT];
+  size_t sizes[SLOT_CNT];
+  unsigned seed = 0x9e3779b9u * (id + 1);
+  int i;
+
+  memset (blocks, 0, sizeof blocks);
+  for (i = 0; i < OP_CNT; i++)
+    {
+      int slot;
+
+      /* A small LCG per thread, so that the workers do not
+         share the random number generator's state. */
+      seed = seed * 1103515245 + 12345;
+      slot = (seed >> 16) % SLOT_CNT;
+      if (blocks[slot] != NULL)
+        {
+          check_block (blocks[slot], id, slot, sizes[slot]);
+          free (blocks[slot]);
+          blocks[slot] = NULL;
+        }
+      else
+        {
+          /* Three quarters of the blocks are small, the rest are
+             spread up to MAX_SIZE. */
+          seed = seed * 1103515245 + 12345;
+          sizes[slot] = (seed >> 16) % 4 != 0
+                        ? (seed >> 18) % 256 + 1
+                        : (seed >> 18) % MAX_SIZE + 1;
+          blocks[slot] = malloc (sizes[slot]);
+          if (blocks[slot] == NULL)
+            fail ("malloc (%zu) failed", sizes[slot]);
+          memset (blocks[slot], pattern (id, slot, sizes[slot]), sizes[slot]);
+        }
+      if (i % 64 == 0)
+        thread_yield ();
+    }
+  for (i = 0; i < SLOT_CNT; i++)
+    if (blocks[i] != NULL)
+      {
+        check_block (blocks[i], id, i, sizes[i]);
+        free (blocks[i]);
+      }
+  sema_up (&done);
+}
+
+/* Fails the test unless a SIZE-byte block costs less than LIMIT
+   bytes. */
+static void
+check_footprint (size_t size, size_t limit)
+{
+  size_t bytes = malloc_footprint (size);
+
+  if (bytes >= limit)
+    fail ("a %zu-byte block takes %zu bytes", size, bytes);
+  msg ("A %zu-byte block takes less than %zu bytes.", size, limit);
+  msg ("A %zu-byte block takes %zu bytes with malloc.", size, bytes);
+}
+
+/* Prints the average cycles of a malloc()/free() pair of SIZE
+   bytes. */
+static void
+time_pairs (size_t size)
+{
+  uint64_t start, cycles;
+  int i;
+
+  start = rdtsc ();
+  for (i = 0; i < TIMED_CNT; i++)
+    {
+      void *p = malloc (size);
+      if (p == NULL)
+        fail ("malloc (%zu) failed", size);
+      free (p);
+    }
+  cycles = rdtsc () - start;
+  msg ("%zu-byte blocks: %llu cycles per pair with malloc.",
+       size, cycles / TIMED_CNT);
+}
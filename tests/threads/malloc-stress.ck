@@ -0,0 +1,27 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the memory and timing lines, whose values depend on the
+# allocator's layout and vary from run to run.
+@output = grep (!/ with malloc\.$/, @output);
+
+my (@expected) = split ("\n", <<'END');
+(malloc-stress) begin
+(malloc-stress) 4 threads, 4000 operations each: no block was overwritten.
+(malloc-stress) A 520-byte block takes less than 1024 bytes.
+(malloc-stress) A 5000-byte block takes less than 8192 bytes.
+(malloc-stress) PASS
+(malloc-stress) end
+END
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
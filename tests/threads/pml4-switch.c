@@ -0,0 +1,144 @@
+/* Ping-pongs between two threads that each run in their own page
+   map, with the same user addresses mapped to different frames,
+   and checks after every switch that each thread still sees its
+   own frames.  Then remaps a page of one page map while the other
+   is active and checks that the change is seen after switching
+   back.  Prints the ticks, cycles and TLB flushes the switches
+   took, which differ with and without -no-pcid. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "devices/timer.h"
+#include "threads/cpu.h"
+#include "threads/init.h"
+#include "threads/mmu.h"
+#include "threads/palloc.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "threads/vaddr.h"
+#include "intrinsic.h"
+
+#define ROUND_CNT 2000          /* Switches to each thread. */
+#define PAGE_CNT 32             /* User pages each thread touches. */
+#define UADDR ((uint8_t *) 0x10000000)  /* Where they are mapped. */
+#define REMAP_MAGIC 0x5a        /* Contents of the remapped page. */
+
+#ifdef USERPROG
+static struct semaphore turn[2];
+static struct semaphore ready, done;
+static uint64_t *pml4s[2];
+
+static thread_func worker;
+#endif
+
+void
+test_pml4_switch (void)
+{
+#ifdef USERPROG
+  struct cpu *c = this_cpu ();
+  uint64_t switches, flushes, start;
+  int64_t start_ticks;
+  uint8_t *kpage;
+  int i;
+
+  sema_init (&ready, 0);
+  sema_init (&done, 0);
+  for (i = 0; i < 2; i++)
+    {
+      char name[16];
+
+      sema_init (&turn[i], 0);
+      snprintf (name, sizeof name, "space %d", i);
+      thread_create (name, PRI_DEFAULT, worker, (void *) (long) i);
+      sema_down (&ready);
+    }
+
+  switches = c->pml4_switches;
+  flushes = c->pml4_flushes;
+  start_ticks = timer_ticks ();
+  start = rdtsc ();
+  sema_up (&turn[0]);
+  sema_down (&ready);
+  msg ("Each thread saw only its own pages.");
+  msg ("%d switches: %lld ticks, %llu cycles, %llu of %llu loads flushed.",
+       2 * ROUND_CNT, timer_ticks () - start_ticks, rdtsc () - start,
+       c->pml4_flushes - flushes, c->pml4_switches - switches);
+
+  /* Remap thread 1's first page while it is not running. */
+  kpage = palloc_get_page (PAL_USER);
+  if (kpage == NULL)
+    fail ("palloc_get_page failed");
+  kpage[0] = REMAP_MAGIC;
+  palloc_free_page (pml4_get_page (pml4s[1], UADDR));
+  pml4_clear_page (pml4s[1], UADDR);
+  if (!pml4_set_page (pml4s[1], UADDR, kpage, true))
+    fail ("pml4_set_page failed");
+
+  sema_up (&turn[0]);
+  sema_up (&turn[1]);
+  sema_down (&done);
+  sema_down (&done);
+  pass ();
+#else
+  /* Without user programs there are no page maps to switch, and
+     the test is only registered in USERPROG builds. */
+  fail ("pml4-switch needs a USERPROG build");
+#endif
+}
+
+#ifdef USERPROG
+/* Runs in its own page map with PAGE_CNT pages at UADDR, each
+   holding the thread's ID, and checks them every time its turn
+   comes. */
+static void
+worker (void *id_)
+{
+  int id = (int) (long) id_;
+  struct thread *t = thread_current ();
+  uint64_t *pml4 = pml4_create ();
+  int round, i;
+
+  if (pml4 == NULL)
+    fail ("pml4_create failed");
+  for (i = 0; i < PAGE_CNT; i++)
+    {
+      uint8_t *kpage = palloc_get_page (PAL_USER | PAL_ZERO);
+      if (kpage == NULL || !pml4_set_page (pml4, UADDR + i * PGSIZE,
+                                           kpage, true))
+        fail ("could not map page %d", i);
+    }
+  pml4s[id] = t->pml4 = pml4;
+  pml4_activate (pml4);
+  for (i = 0; i < PAGE_CNT; i++)
+    UADDR[i * PGSIZE] = id;
+  sema_up (&ready);
+
+  for (round = 0; round < ROUND_CNT; round++)
+    {
+      sema_down (&turn[id]);
+      for (i = 0; i < PAGE_CNT; i++)
+        if (UADDR[i * PGSIZE] != id)
+          fail ("thread %d saw %d in page %d", id, UADDR[i * PGSIZE], i);
+      if (id == 0)
+        sema_up (&turn[1]);
+      else if (round + 1 < ROUND_CNT)
+        sema_up (&turn[0]);
+    }
+  if (id == 1)
+    sema_up (&ready);
+
+  /* Wait for the main thread to remap thread 1's first page. */
+  sema_down (&turn[id]);
+  if (id == 1)
+    {
+      if (UADDR[0] != REMAP_MAGIC)
+        fail ("remapped page not seen after a switch");
+      msg ("Remapped page seen after a switch.");
+    }
+
+  t->pml4 = NULL;
+  pml4_activate (NULL);
+  pml4_destroy (pml4);
+  sema_up (&done);
+}
+#endif
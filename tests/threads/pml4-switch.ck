@@ -0,0 +1,25 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the timing line, whose values vary from run to run.
+@output = grep (!/ ticks, /, @output);
+
+my (@expected) = split ("\n", <<'EOF');
+(pml4-switch) begin
+(pml4-switch) Each thread saw only its own pages.
+(pml4-switch) Remapped page seen after a switch.
+(pml4-switch) PASS
+(pml4-switch) end
+EOF
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
@@ -0,0 +1,176 @@
+/* Checks that a priority-ceiling lock runs its holder at the
+   ceiling and keeps lower-ceiling users from preempting it, then
+   compares the cost of an acquire/release pair on a ceiling lock
+   and on a plain lock, first with no donations and then while
+   the main thread holds NEST_CNT locks that donors wait on.
+   Finally checks that the ceiling survives nested ceiling locks,
+   plain locks, donations and thread_set_priority() taken or made
+   while it is held. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "intrinsic.h"
+
+#define NEST_CNT 8              /* Number of donating waiters. */
+#define ITERATIONS 10000        /* Acquire/release pairs per measurement. */
+
+static thread_func user_thread_func;
+static thread_func donor_thread_func;
+static void measure (const char *what);
+static void check_nesting (void);
+static void check_set_priority (void);
+
+void
+test_priority_ceiling (void) 
+{
+  struct ceiling_lock ceiling;
+  struct lock nest[NEST_CNT];
+  int i;
+
+  /* This test does not work with the MLFQS. */
+  ASSERT (!thread_mlfqs);
+
+  /* Make sure our priority is the default. */
+  ASSERT (thread_get_priority () == PRI_DEFAULT);
+
+  ceiling_lock_init (&ceiling, PRI_DEFAULT + 10);
+  ceiling_lock_acquire (&ceiling);
+  msg ("Holding the ceiling lock, priority %d.", thread_get_priority ());
+
+  thread_create ("user", PRI_DEFAULT + 5, user_thread_func, &ceiling);
+  msg ("Thread user should not have run yet.");
+
+  ceiling_lock_release (&ceiling);
+  msg ("Released the ceiling lock, priority %d.", thread_get_priority ());
+
+  measure ("no donors");
+
+  for (i = 0; i < NEST_CNT; i++)
+    {
+      char name[16];
+
+      lock_init (&nest[i]);
+      lock_acquire (&nest[i]);
+      snprintf (name, sizeof name, "donor %d", i);
+      thread_create (name, PRI_DEFAULT + 1 + i, donor_thread_func, &nest[i]);
+    }
+  msg ("%d donors waiting, priority %d.", NEST_CNT, thread_get_priority ());
+
+  measure ("nested donors");
+
+  for (i = NEST_CNT - 1; i >= 0; i--)
+    lock_release (&nest[i]);
+  msg ("All donors finished, priority %d.", thread_get_priority ());
+
+  check_nesting ();
+  check_set_priority ();
+  pass ();
+}
+
+/* Nests a ceiling lock inside another, then takes a plain lock,
+   first alone and then with a donor waiting on it, under the
+   outer one. */
+static void
+check_nesting (void) 
+{
+  struct ceiling_lock outer, inner;
+  struct lock plain;
+
+  ceiling_lock_init (&outer, PRI_DEFAULT + 10);
+  ceiling_lock_init (&inner, PRI_DEFAULT + 15);
+  lock_init (&plain);
+
+  ceiling_lock_acquire (&outer);
+  ceiling_lock_acquire (&inner);
+  lock_acquire (&plain);
+  lock_release (&plain);
+  msg ("Took a plain lock under two ceilings, priority %d.",
+       thread_get_priority ());
+
+  ceiling_lock_release (&inner);
+  msg ("Released the inner ceiling lock, priority %d.",
+       thread_get_priority ());
+
+  lock_acquire (&plain);
+  thread_create ("donor", PRI_DEFAULT + 12, donor_thread_func, &plain);
+  msg ("Donor waiting under the outer ceiling, priority %d.",
+       thread_get_priority ());
+  lock_release (&plain);
+  msg ("Donor finished, priority %d.", thread_get_priority ());
+
+  ceiling_lock_release (&outer);
+  msg ("Released the outer ceiling lock, priority %d.",
+       thread_get_priority ());
+}
+
+/* Lowers our own priority while holding a ceiling lock. */
+static void
+check_set_priority (void) 
+{
+  struct ceiling_lock ceiling;
+
+  ceiling_lock_init (&ceiling, PRI_DEFAULT + 10);
+  ceiling_lock_acquire (&ceiling);
+  thread_set_priority (PRI_DEFAULT - 10);
+  msg ("Lowered to %d under the ceiling, priority %d.", PRI_DEFAULT - 10,
+       thread_get_priority ());
+
+  ceiling_lock_release (&ceiling);
+  msg ("Released the ceiling lock, priority %d.", thread_get_priority ());
+  thread_set_priority (PRI_DEFAULT);
+}
+
+/* Times ITERATIONS acquire/release pairs of a plain lock and of
+   a ceiling lock and prints the average cost of each. */
+static void
+measure (const char *what) 
+{
+  struct lock lock;
+  struct ceiling_lock ceiling;
+  uint64_t start, lock_cycles, ceiling_cycles;
+  int i;
+
+  lock_init (&lock);
+  ceiling_lock_init (&ceiling, PRI_MAX);
+
+  start = rdtsc ();
+  for (i = 0; i < ITERATIONS; i++)
+    {
+      lock_acquire (&lock);
+      lock_release (&lock);
+    }
+  lock_cycles = rdtsc () - start;
+
+  start = rdtsc ();
+  for (i = 0; i < ITERATIONS; i++)
+    {
+      ceiling_lock_acquire (&ceiling);
+      ceiling_lock_release (&ceiling);
+    }
+  ceiling_cycles = rdtsc () - start;
+
+  msg ("%s: lock %llu cycles, ceiling lock %llu cycles per pair.", what,
+       lock_cycles / ITERATIONS, ceiling_cycles / ITERATIONS);
+}
+
+static void
+user_thread_func (void *lock_) 
+{
+  struct ceiling_lock *lock = lock_;
+
+  ceiling_lock_acquire (lock);
+  msg ("Thread user acquired the ceiling lock.");
+  ceiling_lock_release (lock);
+}
+
+static void
+donor_thread_func (void *lock_) 
+{
+  struct lock *lock = lock_;
+
+  lock_acquire (lock);
+  lock_release (lock);
+}
@@ -0,0 +1,36 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the timing lines, whose values vary from run to run.
+@output = grep (!/cycles per pair\.$/, @output);
+
+my (@expected) = split ("\n", <<'EOF');
+(priority-ceiling) begin
+(priority-ceiling) Holding the ceiling lock, priority 41.
+(priority-ceiling) Thread user should not have run yet.
+(priority-ceiling) Thread user acquired the ceiling lock.
+(priority-ceiling) Released the ceiling lock, priority 31.
+(priority-ceiling) 8 donors waiting, priority 39.
+(priority-ceiling) All donors finished, priority 31.
+(priority-ceiling) Took a plain lock under two ceilings, priority 46.
+(priority-ceiling) Released the inner ceiling lock, priority 41.
+(priority-ceiling) Donor waiting under the outer ceiling, priority 43.
+(priority-ceiling) Donor finished, priority 41.
+(priority-ceiling) Released the outer ceiling lock, priority 31.
+(priority-ceiling) Lowered to 21 under the ceiling, priority 41.
+(priority-ceiling) Released the ceiling lock, priority 21.
+(priority-ceiling) PASS
+(priority-ceiling) end
+EOF
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
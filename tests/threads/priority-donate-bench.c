@@ -0,0 +1,85 @@
+/* Has 1, 16 and 128 threads of mixed priority wait on a lock the
+   main thread holds, checks that the donated priority is the
+   highest waiter's and that the waiters acquire the lock in
+   priority order, and measures how long lock_release() takes to
+   hand the lock to the first waiter. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "intrinsic.h"
+
+#define WAITER_MAX 128          /* Most waiters in one round. */
+
+static struct lock lock;
+static uint64_t release_start;  /* rdtsc() just before lock_release(). */
+static uint64_t handoff_cycles; /* Cycles until the first waiter ran. */
+static int order[WAITER_MAX];   /* Priorities in acquisition order. */
+static int order_cnt;
+
+static thread_func waiter_thread_func;
+static void run_round (int waiter_cnt);
+
+void
+test_priority_donate_bench (void) 
+{
+  /* This test does not work with the MLFQS. */
+  ASSERT (!thread_mlfqs);
+
+  /* Make sure our priority is the default. */
+  ASSERT (thread_get_priority () == PRI_DEFAULT);
+
+  run_round (1);
+  run_round (16);
+  run_round (128);
+  pass ();
+}
+
+/* Blocks WAITER_CNT waiters on LOCK, then releases it and checks
+   the order in which they acquired it. */
+static void
+run_round (int waiter_cnt) 
+{
+  int i;
+
+  lock_init (&lock);
+  lock_acquire (&lock);
+  order_cnt = 0;
+  handoff_cycles = 0;
+
+  for (i = 0; i < waiter_cnt; i++)
+    {
+      char name[24];
+
+      snprintf (name, sizeof name, "waiter %d", i);
+      thread_create (name, PRI_DEFAULT + 1 + i % 32, waiter_thread_func, NULL);
+    }
+  msg ("%d waiters, priority %d.", waiter_cnt, thread_get_priority ());
+
+  release_start = rdtsc ();
+  lock_release (&lock);
+
+  /* Every waiter outranks us, so all of them have run by now. */
+  if (order_cnt != waiter_cnt)
+    fail ("only %d of %d waiters acquired the lock", order_cnt, waiter_cnt);
+  for (i = 1; i < order_cnt; i++)
+    if (order[i] > order[i - 1])
+      fail ("waiter of priority %d acquired the lock after one of "
+            "priority %d", order[i], order[i - 1]);
+  msg ("%d waiters acquired the lock in priority order, priority %d.",
+       waiter_cnt, thread_get_priority ());
+  msg ("%d waiters: %llu cycles from release to first acquire.",
+       waiter_cnt, handoff_cycles);
+}
+
+static void
+waiter_thread_func (void *aux UNUSED) 
+{
+  lock_acquire (&lock);
+  if (order_cnt == 0)
+    handoff_cycles = rdtsc () - release_start;
+  order[order_cnt++] = thread_get_priority ();
+  lock_release (&lock);
+}
@@ -0,0 +1,29 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the timing lines, whose values vary from run to run.
+@output = grep (!/cycles from release to first acquire\.$/, @output);
+
+my (@expected) = split ("\n", <<'EOF');
+(priority-donate-bench) begin
+(priority-donate-bench) 1 waiters, priority 32.
+(priority-donate-bench) 1 waiters acquired the lock in priority order, priority 31.
+(priority-donate-bench) 16 waiters, priority 47.
+(priority-donate-bench) 16 waiters acquired the lock in priority order, priority 31.
+(priority-donate-bench) 128 waiters, priority 63.
+(priority-donate-bench) 128 waiters acquired the lock in priority order, priority 31.
+(priority-donate-bench) PASS
+(priority-donate-bench) end
+EOF
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
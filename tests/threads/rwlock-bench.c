@@ -0,0 +1,133 @@
+/* Runs a read-mostly lookup workload, 95% lookups and 5%
+   updates, on a small table shared by several threads, first
+   protected by a plain lock and then by an rwlock, and prints the
+   lookup throughput of each.  Updates rewrite the table one
+   entry at a time, so a lookup that overlapped an update would
+   see a mix of old and new values; the test fails if that ever
+   happens. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+#include "intrinsic.h"
+
+#define THREAD_CNT 4            /* Number of worker threads. */
+#define OP_CNT 20000            /* Operations per worker. */
+#define WRITE_EVERY 20          /* One update per this many operations. */
+#define TABLE_SIZE 64           /* Entries in the shared table. */
+
+static int table[TABLE_SIZE];
+static bool use_rwlock;
+static struct lock lock;
+static struct rwlock rwlock;
+static struct semaphore done;
+static int torn_reads;
+
+static thread_func worker_thread_func;
+static uint64_t run (bool use_rw);
+
+void
+test_rwlock_bench (void) 
+{
+  uint64_t lock_cycles, rw_cycles;
+  unsigned long long lookups = THREAD_CNT * (OP_CNT - OP_CNT / WRITE_EVERY);
+
+  /* This test does not work with the MLFQS. */
+  ASSERT (!thread_mlfqs);
+
+  lock_cycles = run (false);
+  rw_cycles = run (true);
+
+  if (torn_reads != 0)
+    fail ("%d lookups overlapped an update", torn_reads);
+  msg ("%d threads, %d%% lookups: no lookup overlapped an update.",
+       THREAD_CNT, 100 - 100 / WRITE_EVERY);
+  msg ("lock: %llu lookups per million cycles.",
+       lookups * 1000000 / lock_cycles);
+  msg ("rwlock: %llu lookups per million cycles.",
+       lookups * 1000000 / rw_cycles);
+  pass ();
+}
+
+/* Runs the workload on THREAD_CNT workers and returns the cycles
+   it took, using the rwlock if USE_RW is true or the plain lock
+   otherwise. */
+static uint64_t
+run (bool use_rw) 
+{
+  uint64_t start;
+  int i;
+
+  use_rwlock = use_rw;
+  lock_init (&lock);
+  rwlock_init (&rwlock);
+  sema_init (&done, 0);
+
+  start = rdtsc ();
+  for (i = 0; i < THREAD_CNT; i++)
+    {
+      char name[16];
+
+      snprintf (name, sizeof name, "worker %d", i);
+      thread_create (name, PRI_DEFAULT, worker_thread_func, (void *) (long) i);
+    }
+  for (i = 0; i < THREAD_CNT; i++)
+    sema_down (&done);
+  return rdtsc () - start;
+}
+
+/* Returns true if every entry of the table holds the same value. */
+static bool
+lookup (void) 
+{
+  int i;
+
+  for (i = 1; i < TABLE_SIZE; i++)
+    if (table[i] != table[0])
+      return false;
+  return true;
+}
+
+/* Sets every entry of the table to VALUE. */
+static void
+update (int value) 
+{
+  int i;
+
+  for (i = 0; i < TABLE_SIZE; i++)
+    table[i] = value;
+}
+
+static void
+worker_thread_func (void *id_) 
+{
+  int id = (long) id_;
+  int i;
+
+  for (i = 0; i < OP_CNT; i++)
+    {
+      bool write = (i + id) % WRITE_EVERY == 0;
+
+      if (use_rwlock && write)
+        rwlock_acquire_write (&rwlock);
+      else if (use_rwlock)
+        rwlock_acquire_read (&rwlock);
+      else
+        lock_acquire (&lock);
+
+      if (write)
+        update (id * OP_CNT + i);
+      else if (!lookup ())
+        torn_reads++;
+
+      if (use_rwlock && write)
+        rwlock_release_write (&rwlock);
+      else if (use_rwlock)
+        rwlock_release_read (&rwlock);
+      else
+        lock_release (&lock);
+    }
+  sema_up (&done);
+}
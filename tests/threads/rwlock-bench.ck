@@ -0,0 +1,24 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the timing lines, whose values vary from run to run.
+@output = grep (!/lookups per million cycles\.$/, @output);
+
+my (@expected) = split ("\n", <<'EOF');
+(rwlock-bench) begin
+(rwlock-bench) 4 threads, 95% lookups: no lookup overlapped an update.
+(rwlock-bench) PASS
+(rwlock-bench) end
+EOF
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
@@ -0,0 +1,59 @@
+/* Checks that an rwlock is shared among readers, that a reader
+   arriving while a writer waits queues behind it instead of
+   starving the writer, and that the waiters donate their
+   priority to the thread holding the lock for reading. */
+
+#include <stdio.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/synch.h"
+#include "threads/thread.h"
+
+static thread_func reader_thread_func;
+static thread_func writer_thread_func;
+
+void
+test_rwlock (void) 
+{
+  struct rwlock rw;
+
+  /* This test does not work with the MLFQS. */
+  ASSERT (!thread_mlfqs);
+
+  /* Make sure our priority is the default. */
+  ASSERT (thread_get_priority () == PRI_DEFAULT);
+
+  rwlock_init (&rw);
+  rwlock_acquire_read (&rw);
+  msg ("Holding the rwlock for reading.");
+
+  thread_create ("reader", PRI_DEFAULT + 1, reader_thread_func, &rw);
+  thread_create ("writer", PRI_DEFAULT + 5, writer_thread_func, &rw);
+  msg ("Thread writer waiting, priority %d.", thread_get_priority ());
+  thread_create ("late reader", PRI_DEFAULT + 7, reader_thread_func, &rw);
+  msg ("Thread late reader waiting, priority %d.", thread_get_priority ());
+
+  rwlock_release_read (&rw);
+  msg ("Released the rwlock, priority %d.", thread_get_priority ());
+  pass ();
+}
+
+static void
+reader_thread_func (void *rw_) 
+{
+  struct rwlock *rw = rw_;
+
+  rwlock_acquire_read (rw);
+  msg ("Thread %s acquired the rwlock for reading.", thread_name ());
+  rwlock_release_read (rw);
+}
+
+static void
+writer_thread_func (void *rw_) 
+{
+  struct rwlock *rw = rw_;
+
+  rwlock_acquire_write (rw);
+  msg ("Thread %s acquired the rwlock for writing.", thread_name ());
+  rwlock_release_write (rw);
+}
@@ -0,0 +1,17 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(rwlock) begin
+(rwlock) Holding the rwlock for reading.
+(rwlock) Thread reader acquired the rwlock for reading.
+(rwlock) Thread writer waiting, priority 36.
+(rwlock) Thread late reader waiting, priority 38.
+(rwlock) Thread late reader acquired the rwlock for reading.
+(rwlock) Thread writer acquired the rwlock for writing.
+(rwlock) Released the rwlock, priority 31.
+(rwlock) PASS
+(rwlock) end
+EOF
+pass;
@@ -0,0 +1,124 @@
+/* Allocates and frees 256 objects of an inode-sized and of a
+   file-sized type, once with malloc() and once with an object
+   cache, checks that cache objects are distinct and aligned and
+   that constructed objects stay constructed, and compares the
+   memory and cycles each allocator uses. */
+
+#include <stdio.h>
+#include <string.h>
+#include "tests/threads/tests.h"
+#include "threads/init.h"
+#include "threads/malloc.h"
+#include "threads/slab.h"
+#include "intrinsic.h"
+
+#define OBJ_CNT 256             /* Objects allocated per round. */
+#define CTOR_MAGIC 0x5eedf00d   /* Set by the constructor. */
+
+static void *objs[OBJ_CNT];
+
+static void run_round (size_t size, size_t align);
+static void check_ctor (void);
+
+void
+test_slab_bench (void) 
+{
+  run_round (544, 64);
+  run_round (24, 0);
+  check_ctor ();
+  pass ();
+}
+
+/* Compares malloc() with an object cache for OBJ_CNT objects of
+   SIZE bytes aligned on ALIGN bytes. */
+static void
+run_round (size_t size, size_t align) 
+{
+  struct kmem_cache *cache;
+  uint64_t start, malloc_cycles, cache_cycles;
+  size_t cache_bytes;
+  int i;
+
+  start = rdtsc ();
+  for (i = 0; i < OBJ_CNT; i++)
+    if ((objs[i] = malloc (size)) == NULL)
+      fail ("malloc failed");
+  for (i = 0; i < OBJ_CNT; i++)
+    free (objs[i]);
+  malloc_cycles = rdtsc () - start;
+
+  cache = kmem_cache_create ("bench", size, align, NULL);
+  if (cache == NULL)
+    fail ("kmem_cache_create failed");
+
+  start = rdtsc ();
+  for (i = 0; i < OBJ_CNT; i++)
+    if ((objs[i] = kmem_cache_alloc (cache)) == NULL)
+      fail ("kmem_cache_alloc failed");
+  cache_cycles = rdtsc () - start;
+  cache_bytes = kmem_cache_footprint (cache);
+
+  /* Fill every object, then check that no other object
+     overwrote it. */
+  for (i = 0; i < OBJ_CNT; i++) 
+    {
+      if (align != 0 && (uintptr_t) objs[i] % align != 0)
+        fail ("object %d at %p is not %zu-byte aligned", i, objs[i], align);
+      memset (objs[i], i, size);
+    }
+  for (i = 0; i < OBJ_CNT; i++) 
+    {
+      const unsigned char *p = objs[i];
+      size_t j;
+
+      for (j = 0; j < size; j++)
+        if (p[j] != (unsigned char) i)
+          fail ("object %d was overwritten at byte %zu", i, j);
+    }
+
+  start = rdtsc ();
+  for (i = 0; i < OBJ_CNT; i++)
+    kmem_cache_free (cache, objs[i]);
+  cache_cycles += rdtsc () - start;
+
+  if (cache_bytes > OBJ_CNT * malloc_footprint (size))
+    fail ("%zu-byte objects take more memory in a cache than with malloc",
+          size);
+  msg ("%d %zu-byte objects allocated and freed.", OBJ_CNT, size);
+  msg ("%zu-byte objects: %zu bytes in slabs, %zu bytes with malloc.",
+       size, cache_bytes, OBJ_CNT * malloc_footprint (size));
+  msg ("%zu-byte objects: %llu cycles with kmem_cache, %llu with malloc.",
+       size, cache_cycles, malloc_cycles);
+}
+
+static void
+ctor (void *obj) 
+{
+  *(unsigned *) obj = CTOR_MAGIC;
+}
+
+/* Checks that objects of a cache with a constructor are handed
+   out constructed, including after they were freed. */
+static void
+check_ctor (void) 
+{
+  struct kmem_cache *cache = kmem_cache_create ("bench-ctor", 40, 0, ctor);
+  int round, i;
+
+  if (cache == NULL)
+    fail ("kmem_cache_create failed");
+  for (round = 0; round < 2; round++) 
+    {
+      for (i = 0; i < OBJ_CNT; i++) 
+        {
+          objs[i] = kmem_cache_alloc (cache);
+          if (objs[i] == NULL)
+            fail ("kmem_cache_alloc failed");
+          if (*(unsigned *) objs[i] != CTOR_MAGIC)
+            fail ("object %d is not constructed", i);
+        }
+      for (i = 0; i < OBJ_CNT; i++)
+        kmem_cache_free (cache, objs[i]);
+    }
+  msg ("Constructed objects stay constructed.");
+}
@@ -0,0 +1,27 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the memory and timing lines, whose values depend on the
+# allocators' layout and vary from run to run.
+@output = grep (!/ with malloc\.$/, @output);
+
+my (@expected) = split ("\n", <<'EOF');
+(slab-bench) begin
+(slab-bench) 256 544-byte objects allocated and freed.
+(slab-bench) 256 24-byte objects allocated and freed.
+(slab-bench) Constructed objects stay constructed.
+(slab-bench) PASS
+(slab-bench) end
+EOF
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
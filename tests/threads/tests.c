@@ -17,6 +17,7 @@ static const struct test tests[] =
     {"alarm-priority", test_alarm_priority},
     {"alarm-zero", test_alarm_zero},
     {"alarm-negative", test_alarm_negative},
+    {"alarm-stress", test_alarm_stress},
     {"priority-change", test_priority_change},
     {"priority-donate-one", test_priority_donate_one},
     {"priority-donate-multiple", test_priority_donate_multiple},
@@ -29,6 +30,16 @@ static const struct test tests[] =
     {"priority-preempt", test_priority_preempt},
     {"priority-sema", test_priority_sema},
     {"priority-condvar", test_priority_condvar},
+    {"priority-ceiling", test_priority_ceiling},
+    {"priority-donate-bench", test_priority_donate_bench},
+    {"rwlock", test_rwlock},
+    {"rwlock-bench", test_rwlock_bench},
+    {"slab-bench", test_slab_bench},
+    {"malloc-stress", test_malloc_stress},
+    {"bitmap-bench", test_bitmap_bench},
+    {"large-page", test_large_page},
+    {"pml4-switch", test_pml4_switch},
+    {"alloc-profile", test_alloc_profile},
     {"mlfqs-load-1", test_mlfqs_load_1},
     {"mlfqs-load-60", test_mlfqs_load_60},
     {"mlfqs-load-avg", test_mlfqs_load_avg},
@@ -11,6 +11,7 @@ extern test_func test_alarm_simultaneous;
 extern test_func test_alarm_priority;
 extern test_func test_alarm_zero;
 extern test_func test_alarm_negative;
+extern test_func test_alarm_stress;
 extern test_func test_priority_change;
 extern test_func test_priority_donate_one;
 extern test_func test_priority_donate_multiple;
@@ -23,6 +24,16 @@ extern test_func test_priority_fifo;
 extern test_func test_priority_preempt;
 extern test_func test_priority_sema;
 extern test_func test_priority_condvar;
+extern test_func test_priority_ceiling;
+extern test_func test_priority_donate_bench;
+extern test_func test_rwlock;
+extern test_func test_rwlock_bench;
+extern test_func test_slab_bench;
+extern test_func test_malloc_stress;
+extern test_func test_bitmap_bench;
+extern test_func test_large_page;
+extern test_func test_pml4_switch;
+extern test_func test_alloc_profile;
 extern test_func test_mlfqs_load_1;
 extern test_func test_mlfqs_load_60;
 extern test_func test_mlfqs_load_avg;
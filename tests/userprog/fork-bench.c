@@ -0,0 +1,40 @@
+/* Forks and reaps CHILD_CNT children that exit at once and
+   reports the average cost of one fork/exit/wait round trip,
+   which is dominated by creating and destroying the child
+   thread. */
+
+#include <stdint.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define CHILD_CNT 64
+
+static inline uint64_t
+rdtsc (void) 
+{
+  uint32_t lo, hi;
+  asm volatile ("rdtsc" : "=a" (lo), "=d" (hi));
+  return ((uint64_t) hi << 32) | lo;
+}
+
+void
+test_main (void) 
+{
+  uint64_t start, cycles;
+  int i;
+
+  start = rdtsc ();
+  for (i = 0; i < CHILD_CNT; i++)
+    {
+      int pid = fork ("child");
+      if (pid == 0)
+        exit (i);
+      if (wait (pid) != i)
+        fail ("child %d exited with the wrong status", i);
+    }
+  cycles = rdtsc () - start;
+
+  msg ("forked and reaped %d children.", CHILD_CNT);
+  msg ("%llu cycles per fork/exit/wait.", cycles / CHILD_CNT);
+}
@@ -0,0 +1,22 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the timing line, whose value varies from run to run.
+@output = grep (!/cycles per fork\/exit\/wait\.$/, @output);
+
+my (@expected) = ("(fork-bench) begin");
+push (@expected, "child: exit($_)") foreach 0...63;
+push (@expected, "(fork-bench) forked and reaped 64 children.",
+      "(fork-bench) end", "fork-bench: exit(0)");
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
@@ -0,0 +1,47 @@
+/* Writes and reads back a file, then checks that the resource
+   usage of the process counts the bytes moved, that its code,
+   data and stack are resident with the page tables that map
+   them, and that a reaped child has no usage left. */
+
+#include <syscall.h>
+#include "tests/userprog/sample.inc"
+#include "tests/lib.h"
+#include "tests/main.h"
+
+static char buf[sizeof sample];
+
+void
+test_main (void) 
+{
+  struct rusage usage;
+  int handle, pid;
+
+  CHECK (create ("test.txt", sizeof sample - 1), "create \"test.txt\"");
+  CHECK ((handle = open ("test.txt")) > 1, "open \"test.txt\"");
+  if (write (handle, sample, sizeof sample - 1) != sizeof sample - 1)
+    fail ("write failed");
+  seek (handle, 0);
+  if (read (handle, buf, sizeof sample - 1) != sizeof sample - 1)
+    fail ("read failed");
+  close (handle);
+
+  CHECK (getrusage (0, &usage) == 0, "getrusage(self)");
+  if (usage.write_bytes != sizeof sample - 1)
+    fail ("counted %llu bytes written, expected %zu",
+          usage.write_bytes, sizeof sample - 1);
+  if (usage.read_bytes != sizeof sample - 1)
+    fail ("counted %llu bytes read, expected %zu",
+          usage.read_bytes, sizeof sample - 1);
+
+  /* Code, data and stack pages at least, mapped by the page map
+     and at least one table at each of the three lower levels. */
+  if (usage.resident_pages < 3)
+    fail ("only %llu resident pages", usage.resident_pages);
+  if (usage.page_table_pages < 4)
+    fail ("only %llu page table pages", usage.page_table_pages);
+
+  if ((pid = fork ("child")) == 0)
+    exit (82);
+  msg ("wait(child) = %d", wait (pid));
+  msg ("getrusage(child) = %d", getrusage (pid, &usage));
+}
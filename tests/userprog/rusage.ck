@@ -0,0 +1,16 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(rusage) begin
+(rusage) create "test.txt"
+(rusage) open "test.txt"
+(rusage) getrusage(self)
+child: exit(82)
+(rusage) wait(child) = 82
+(rusage) getrusage(child) = -1
+(rusage) end
+rusage: exit(0)
+EOF
+pass;
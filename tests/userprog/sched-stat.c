@@ -0,0 +1,39 @@
+/* Waits for a child, then checks that the scheduler statistics
+   of the parent record the switch away while it waited and the
+   wakeup that followed, that a reaped child has no statistics
+   left, and that a child asking for its statistics to be copied
+   into its read-only code is killed. */
+
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+void
+test_main (void) 
+{
+  struct sched_stat stat;
+  unsigned long long wakeups = 0;
+  int pid;
+  int i;
+
+  if ((pid = fork ("child")) == 0)
+    exit (81);
+  msg ("wait(child) = %d", wait (pid));
+
+  CHECK (sched_stat (0, &stat) == 0, "sched_stat(self)");
+  if (stat.voluntary_switches == 0)
+    fail ("no voluntary switch recorded while waiting");
+  for (i = 0; i < SCHED_LATENCY_BUCKETS; i++)
+    wakeups += stat.wakeup_latency[i];
+  if (wakeups == 0)
+    fail ("no wakeup recorded in the latency histogram");
+
+  msg ("sched_stat(child) = %d", sched_stat (pid, &stat));
+
+  if ((pid = fork ("child")) == 0)
+    {
+      sched_stat (0, (struct sched_stat *) test_main);
+      exit (82);
+    }
+  msg ("wait(child) = %d", wait (pid));
+}
@@ -0,0 +1,16 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected ([<<'EOF']);
+(sched-stat) begin
+child: exit(81)
+(sched-stat) wait(child) = 81
+(sched-stat) sched_stat(self)
+(sched-stat) sched_stat(child) = -1
+child: exit(-1)
+(sched-stat) wait(child) = -1
+(sched-stat) end
+sched-stat: exit(0)
+EOF
+pass;
@@ -0,0 +1,39 @@
+/* Checks that a page shared copy-on-write by fork() is copied
+   for the child when the child writes to it, and that the
+   parent, once it is the last sharer, writes to the original
+   frame without copying it. */
+
+#include <string.h>
+#include <syscall.h>
+#include <stdint.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+
+static char page[PAGE_SIZE] __attribute__ ((aligned (PAGE_SIZE)));
+
+void
+test_main (void)
+{
+  pid_t child;
+  void *pa;
+
+  memset (page, 'p', PAGE_SIZE);
+  pa = get_phys_addr (page);
+
+  child = fork ("child");
+  if (child == 0)
+    {
+      CHECK (get_phys_addr (page) == pa, "child shares the parent's frame.");
+      page[0] = 'c';
+      CHECK (get_phys_addr (page) != pa, "child's write copied the frame.");
+      return;
+    }
+  wait (child);
+
+  CHECK (page[0] == 'p', "parent's page kept its contents.");
+  CHECK (get_phys_addr (page) == pa, "parent kept its frame.");
+  page[0] = 'q';
+  CHECK (get_phys_addr (page) == pa, "last sharer wrote without a copy.");
+}
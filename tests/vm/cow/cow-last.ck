@@ -0,0 +1,15 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(cow-last) begin
+(cow-last) child shares the parent's frame.
+(cow-last) child's write copied the frame.
+(cow-last) end
+(cow-last) parent's page kept its contents.
+(cow-last) parent kept its frame.
+(cow-last) last sharer wrote without a copy.
+(cow-last) end
+EOF
+pass;
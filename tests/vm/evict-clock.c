@@ -0,0 +1,48 @@
+/* Writes a pattern over more pages than fit in memory while
+   reading a small hot set of pages over and over, then checks
+   that every page kept its pattern and that getrusage() saw pages
+   go out to swap and come back with major faults.  Run with a
+   small memory, so that the frame table has to evict. */
+
+#include <stdint.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+#define PAGE_CNT 4096           /* 16 MB of pages. */
+#define HOT_CNT 16              /* Pages read between every write. */
+
+static char pages[PAGE_CNT][PAGE_SIZE];
+
+void
+test_main (void)
+{
+  struct rusage usage;
+  size_t i, j;
+  int sum = 0;
+
+  for (i = 0; i < PAGE_CNT; i++)
+    {
+      pages[i][0] = i;
+      pages[i][PAGE_SIZE - 1] = i >> 8;
+      for (j = 0; j < HOT_CNT; j++)
+        sum += pages[j][0];
+    }
+  msg ("wrote %d pages.", PAGE_CNT);
+
+  for (i = 0; i < PAGE_CNT; i++)
+    if (pages[i][0] != (char) i || pages[i][PAGE_SIZE - 1] != (char) (i >> 8))
+      fail ("page %zu lost its contents", i);
+  msg ("every page kept its contents.");
+
+  CHECK (getrusage (0, &usage) == 0, "getrusage(self)");
+  if (usage.swapped_pages == 0)
+    fail ("no pages in swap");
+  msg ("pages went to swap.");
+  if (usage.major_faults == 0)
+    fail ("no major faults");
+  msg ("pages came back with major faults.");
+  if (sum == 0)
+    fail ("hot pages read as zero");
+}
@@ -0,0 +1,14 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(evict-clock) begin
+(evict-clock) wrote 4096 pages.
+(evict-clock) every page kept its contents.
+(evict-clock) getrusage(self)
+(evict-clock) pages went to swap.
+(evict-clock) pages came back with major faults.
+(evict-clock) end
+EOF
+pass;
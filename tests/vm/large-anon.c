@@ -0,0 +1,51 @@
+/* Writes every page of an array large enough to hold whole 2 MB
+   regions, which should bring each of them in with a large page,
+   then forks a child that rewrites every page.  Sharing the pages
+   copy-on-write splits the large pages; the child and the parent
+   must each still see only their own contents. */
+
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+#define PAGE_CNT 1024           /* 4 MB of pages. */
+
+static char pages[PAGE_CNT][PAGE_SIZE];
+
+static void
+check (const char *who, char base)
+{
+  size_t i;
+
+  for (i = 0; i < PAGE_CNT; i++)
+    if (pages[i][0] != (char) (base + i)
+        || pages[i][PAGE_SIZE - 1] != (char) (base + i))
+      fail ("%s: page %zu has the wrong contents", who, i);
+}
+
+void
+test_main (void)
+{
+  pid_t pid;
+  size_t i;
+
+  for (i = 0; i < PAGE_CNT; i++)
+    pages[i][0] = pages[i][PAGE_SIZE - 1] = i;
+  check ("parent", 0);
+  msg ("wrote %d pages.", PAGE_CNT);
+
+  pid = fork ("child");
+  if (pid == 0)
+    {
+      check ("child", 0);
+      for (i = 0; i < PAGE_CNT; i++)
+        pages[i][0] = pages[i][PAGE_SIZE - 1] = i + 1;
+      check ("child", 1);
+      exit (81);
+    }
+  CHECK (pid > 0, "fork");
+  CHECK (wait (pid) == 81, "wait for child");
+  check ("parent", 0);
+  msg ("the parent's pages are unchanged.");
+}
@@ -0,0 +1,13 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(large-anon) begin
+(large-anon) wrote 1024 pages.
+(large-anon) fork
+(large-anon) wait for child
+(large-anon) the parent's pages are unchanged.
+(large-anon) end
+EOF
+pass;
@@ -0,0 +1,58 @@
+/* Touches TOUCH_CNT pages spread thinly across a large zeroed
+   array, so that each touch takes a page fault that has to find
+   its page in the supplemental page table, then touches them all
+   again and reports the cycles each pass took per page.  Checks
+   that every page was zeroed and kept what was written to it.
+
+   The touched pages do not all fit in memory, so the test runs
+   with a swap disk that can hold every one of them, and the
+   second pass faults on the pages evicted meanwhile.  It also
+   gets enough memory for the kernel to hold a struct page for
+   every page of the array.  STRIDE is kept small enough for the
+   array to fit below the stack. */
+
+#include <stdint.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+#define TOUCH_CNT 100000        /* Pages touched. */
+#define STRIDE 2                /* Pages between touched pages. */
+
+static char sparse[TOUCH_CNT * STRIDE * PAGE_SIZE];
+
+static inline uint64_t
+rdtsc (void)
+{
+  uint32_t lo, hi;
+  asm volatile ("rdtsc" : "=a" (lo), "=d" (hi));
+  return ((uint64_t) hi << 32) | lo;
+}
+
+void
+test_main (void)
+{
+  uint64_t start, fault_cycles, hit_cycles;
+  size_t i;
+
+  start = rdtsc ();
+  for (i = 0; i < TOUCH_CNT; i++)
+    {
+      char *p = &sparse[i * STRIDE * PAGE_SIZE];
+      if (*p != 0)
+        fail ("page %zu was not zeroed", i);
+      *p = i;
+    }
+  fault_cycles = rdtsc () - start;
+
+  start = rdtsc ();
+  for (i = 0; i < TOUCH_CNT; i++)
+    if (sparse[i * STRIDE * PAGE_SIZE] != (char) i)
+      fail ("page %zu lost its contents", i);
+  hit_cycles = rdtsc () - start;
+
+  msg ("touched %d pages, 1 in %d.", TOUCH_CNT, STRIDE);
+  msg ("%llu cycles per page with faults.", fault_cycles / TOUCH_CNT);
+  msg ("%llu cycles per page on the second pass.", hit_cycles / TOUCH_CNT);
+}
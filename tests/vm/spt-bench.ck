@@ -0,0 +1,25 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the timing lines, whose values vary from run to run.
+@output = grep (!/cycles per page (with faults|on the second pass)\.$/,
+                @output);
+
+my (@expected) = split ("\n", <<'END');
+(spt-bench) begin
+(spt-bench) touched 100000 pages, 1 in 2.
+(spt-bench) end
+spt-bench: exit(0)
+END
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
@@ -0,0 +1,24 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+
+our ($test);
+my (@output) = read_text_file ("$test.output");
+
+common_checks ("run", @output);
+@output = get_core_output ("run", @output);
+
+# Drop the timing lines, whose values vary from run to run.
+@output = grep (!/: \d+ cycles per page\.$/, @output);
+
+my (@expected) = split ("\n", <<'END');
+(swap-bench) begin
+(swap-bench) 5120 pages kept their contents.
+(swap-bench) end
+swap-bench: exit(0)
+END
+
+fail "Output differs from expected:\n" . join ("\n", @output) . "\n"
+  if join ("\n", @output) ne join ("\n", @expected);
+pass;
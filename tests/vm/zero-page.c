@@ -0,0 +1,54 @@
+/* Reads every page of a large zeroed array, which should map
+   each of them to the shared zero page instead of giving it a
+   frame, then writes half of them, which should give just those
+   frames of their own.  Checks the contents and the counts that
+   getrusage() reports along the way. */
+
+#include <stdint.h>
+#include <syscall.h>
+#include "tests/lib.h"
+#include "tests/main.h"
+
+#define PAGE_SIZE 4096
+#define PAGE_CNT 1024           /* 4 MB of pages. */
+
+static char pages[PAGE_CNT][PAGE_SIZE];
+
+void
+test_main (void)
+{
+  struct rusage before, usage;
+  size_t i;
+
+  CHECK (getrusage (0, &before) == 0, "getrusage(self)");
+  for (i = 0; i < PAGE_CNT; i++)
+    if (pages[i][0] != 0 || pages[i][PAGE_SIZE - 1] != 0)
+      fail ("page %zu was not zeroed", i);
+  msg ("read %d pages of zeros.", PAGE_CNT);
+
+  CHECK (getrusage (0, &usage) == 0, "getrusage(self)");
+  if (usage.zero_page_hits - before.zero_page_hits < PAGE_CNT)
+    fail ("only %llu zero page hits",
+          usage.zero_page_hits - before.zero_page_hits);
+  if (usage.zero_pages < PAGE_CNT)
+    fail ("only %llu pages map the zero page", usage.zero_pages);
+  if (usage.resident_pages >= before.resident_pages + PAGE_CNT)
+    fail ("%llu resident pages", usage.resident_pages);
+  msg ("every page maps the zero page.");
+
+  for (i = 0; i < PAGE_CNT; i += 2)
+    pages[i][0] = i / 2 + 1;
+  for (i = 0; i < PAGE_CNT; i++)
+    if (pages[i][0] != (i % 2 == 0 ? (char) (i / 2 + 1) : 0))
+      fail ("page %zu has the wrong contents", i);
+  msg ("wrote every other page.");
+
+  before = usage;
+  CHECK (getrusage (0, &usage) == 0, "getrusage(self)");
+  if (before.zero_pages - usage.zero_pages != PAGE_CNT / 2)
+    fail ("%llu pages left the zero page, expected %d",
+          before.zero_pages - usage.zero_pages, PAGE_CNT / 2);
+  if (usage.resident_pages < before.resident_pages + PAGE_CNT / 2)
+    fail ("only %llu resident pages", usage.resident_pages);
+  msg ("just the written pages got frames.");
+}
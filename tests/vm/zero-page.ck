@@ -0,0 +1,16 @@
+# -*- perl -*-
+use strict;
+use warnings;
+use tests::tests;
+check_expected (IGNORE_EXIT_CODES => 1, [<<'EOF']);
+(zero-page) begin
+(zero-page) getrusage(self)
+(zero-page) read 1024 pages of zeros.
+(zero-page) getrusage(self)
+(zero-page) every page maps the zero page.
+(zero-page) wrote every other page.
+(zero-page) getrusage(self)
+(zero-page) just the written pages got frames.
+(zero-page) end
+EOF
+pass;
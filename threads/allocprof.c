@@ -0,0 +1,296 @@
+#include "threads/allocprof.h"
+#include <debug.h>
+#include <hash.h>
+#include <list.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "threads/interrupt.h"
+#include "threads/palloc.h"
+#include "threads/vaddr.h"
+
+/* Allocation profiler.
+
+   Each live allocation has a struct alloc_rec in live_allocs,
+   keyed by its address and allocator.  The profiler is called
+   from inside malloc() and palloc(), possibly with interrupts
+   off or from the scheduler, so it must not allocate memory
+   itself: records come from a pool of REC_PAGES pages set aside
+   by allocprof_init(), and live_allocs uses a fixed array of
+   buckets, so that hash.c never resizes it.  Allocations made
+   while the pool is empty go untracked and are only counted.
+
+   Like the page allocator, the profiler is protected by turning
+   interrupts off. */
+/* 할당 프로파일러.
+
+   살아 있는 할당마다 주소와 할당기를 키로 하는 struct alloc_rec가
+   live_allocs에 있습니다. 프로파일러는 malloc()과 palloc() 안에서,
+   인터럽트가 꺼진 상태나 스케줄러에서도 불리므로 스스로 메모리를
+   할당해서는 안 됩니다. 레코드는 allocprof_init()이 떼어 둔
+   REC_PAGES 페이지의 풀에서 가져오고, live_allocs는 고정된 버킷
+   배열을 써서 hash.c가 크기를 바꾸지 않게 합니다. 풀이 비어 있을 때의
+   할당은 추적하지 않고 개수만 셉니다.
+
+   페이지 할당자처럼 프로파일러는 인터럽트를 꺼서 보호합니다. */
+
+#define REC_PAGES 64	/* Pages of allocation records. */
+						/* 할당 레코드에 쓰는 페이지 수. */
+#define BUCKET_PAGES 4	/* Pages of hash buckets. */
+						/* 해시 버킷에 쓰는 페이지 수. */
+#define SITE_MAX 256	/* Call sites allocprof_dump() tells apart. */
+						/* allocprof_dump()가 구별하는 호출 지점 수. */
+
+/* A live allocation. */
+/* 살아 있는 할당. */
+struct alloc_rec
+{
+	struct hash_elem elem;	  /* live_allocs or free_recs element. */
+							  /* live_allocs 또는 free_recs 요소. */
+	void *ptr;				  /* Start of the allocation. */
+							  /* 할당의 시작 주소. */
+	size_t size;			  /* Bytes requested. */
+							  /* 요청한 바이트 수. */
+	const void *caller;		  /* Return address into the call site. */
+							  /* 호출 지점으로의 반환 주소. */
+	enum allocprof_kind kind; /* Allocator it came from. */
+							  /* 할당한 할당기. */
+};
+
+/* Totals for one call site. */
+/* 호출 지점 하나의 합계. */
+struct site
+{
+	const void *caller;		  /* Return address into the call site. */
+							  /* 호출 지점으로의 반환 주소. */
+	enum allocprof_kind kind; /* Allocator. */
+							  /* 할당기. */
+	size_t cnt;				  /* Live allocations. */
+							  /* 살아 있는 할당 수. */
+	size_t bytes;			  /* Bytes they hold. */
+							  /* 그 할당들이 잡고 있는 바이트 수. */
+};
+
+/* True while allocations are being tracked. */
+/* 할당을 추적하는 동안 참. */
+bool allocprof_on;
+
+static struct hash live_allocs; /* Live allocations. */
+static struct list free_recs;	/* Unused records. */
+static uint64_t untracked_cnt;	/* Allocations missed for want of records. */
+
+/* Scratch space for allocprof_dump(). */
+/* allocprof_dump()의 작업 공간. */
+static struct site sites[SITE_MAX];
+
+static hash_hash_func rec_hash;
+static hash_less_func rec_less;
+
+/* Sets aside memory for the profiler and turns it on.
+   Allocations made before this are not tracked.  Does nothing if
+   the profiler is already on. */
+/* 프로파일러에 쓸 메모리를 떼어 두고 프로파일러를 켭니다. 이전에
+   이루어진 할당은 추적하지 않습니다. 이미 켜져 있으면 아무것도 하지
+   않습니다. */
+void allocprof_init(void)
+{
+	struct alloc_rec *recs;
+	struct list *buckets;
+	size_t i;
+
+	if (allocprof_on)
+		return;
+
+	recs = palloc_get_multiple(PAL_ASSERT, REC_PAGES);
+	buckets = palloc_get_multiple(PAL_ASSERT, BUCKET_PAGES);
+	list_init(&free_recs);
+	for (i = 0; i < REC_PAGES * PGSIZE / sizeof *recs; i++)
+		list_push_back(&free_recs, &recs[i].elem.list_elem);
+	hash_init_fixed(&live_allocs, rec_hash, rec_less, NULL, buckets,
+					BUCKET_PAGES * PGSIZE / sizeof *buckets);
+
+	enum intr_level old_level = intr_disable();
+	allocprof_on = true;
+	intr_set_level(old_level);
+}
+
+/* Records that CALLER got SIZE bytes at P from allocator KIND.
+   Does nothing if P is a null pointer. */
+/* CALLER가 할당기 KIND로부터 P에 SIZE 바이트를 받았음을 기록합니다.
+   P가 널 포인터이면 아무것도 하지 않습니다. */
+void allocprof_record(enum allocprof_kind kind, void *p, size_t size,
+					  const void *caller)
+{
+	if (p == NULL)
+		return;
+
+	enum intr_level old_level = intr_disable();
+	if (list_empty(&free_recs))
+		untracked_cnt++;
+	else
+	{
+		struct alloc_rec *r = list_entry(list_pop_front(&free_recs),
+										 struct alloc_rec, elem.list_elem);
+		r->ptr = p;
+		r->size = size;
+		r->caller = caller;
+		r->kind = kind;
+
+		/* A stale record is left behind if P was freed after the
+		   pool ran out. */
+		/* 풀이 바닥난 뒤 P가 해제되었다면 오래된 레코드가 남아
+		   있습니다. */
+		struct hash_elem *old = hash_replace(&live_allocs, &r->elem);
+		if (old != NULL)
+			list_push_front(&free_recs, &old->list_elem);
+	}
+	intr_set_level(old_level);
+}
+
+/* Records that the allocation at P from allocator KIND was
+   freed.  Allocations that were never recorded are ignored. */
+/* 할당기 KIND가 P에 준 할당이 해제되었음을 기록합니다. 기록된 적
+   없는 할당은 무시합니다. */
+void allocprof_forget(enum allocprof_kind kind, void *p)
+{
+	struct alloc_rec key;
+
+	if (p == NULL)
+		return;
+	key.ptr = p;
+	key.kind = kind;
+
+	enum intr_level old_level = intr_disable();
+	struct hash_elem *e = hash_delete(&live_allocs, &key.elem);
+	if (e != NULL)
+		list_push_front(&free_recs, &e->list_elem);
+	intr_set_level(old_level);
+}
+
+/* Returns the bytes held by tracked allocations from allocator
+   KIND, and stores their number in *CNT if CNT is non-null. */
+/* 할당기 KIND에서 온 추적 중인 할당이 잡고 있는 바이트 수를 반환하며,
+   CNT가 널이 아니면 그 개수를 *CNT에 저장합니다. */
+size_t allocprof_live(enum allocprof_kind kind, size_t *cnt)
+{
+	struct hash_iterator i;
+	size_t bytes = 0, n = 0;
+
+	enum intr_level old_level = intr_disable();
+	if (allocprof_on)
+	{
+		hash_first(&i, &live_allocs);
+		while (hash_next(&i))
+		{
+			struct alloc_rec *r = hash_entry(hash_cur(&i), struct alloc_rec, elem);
+			if (r->kind == kind)
+			{
+				bytes += r->size;
+				n++;
+			}
+		}
+	}
+	intr_set_level(old_level);
+
+	if (cnt != NULL)
+		*cnt = n;
+	return bytes;
+}
+
+/* Prints, for each allocator, the SITE_CNT call sites whose live
+   allocations hold the most bytes.  The call sites are printed as
+   return addresses, which the `backtrace' tool translates into
+   function names and line numbers.  May be called from an
+   interrupt handler. */
+/* 할당기마다 살아 있는 할당이 가장 많은 바이트를 잡고 있는 SITE_CNT
+   개의 호출 지점을 출력합니다. 호출 지점은 반환 주소로 출력하며,
+   `backtrace' 도구로 함수 이름과 줄 번호로 바꿀 수 있습니다. 인터럽트
+   처리기에서 불러도 됩니다. */
+void allocprof_dump(size_t site_cnt)
+{
+	static const char *kind_names[ALLOCPROF_KIND_CNT] = {"malloc", "palloc"};
+	size_t site_used = 0, other_cnt = 0;
+	struct hash_iterator i;
+	size_t s;
+
+	if (!allocprof_on)
+	{
+		printf("Allocation profiler is off (use -alloc-profile).\n");
+		return;
+	}
+
+	/* Interrupts stay off until the sites are printed, since
+	   SITES is shared. */
+	/* SITES를 공유하므로 호출 지점을 출력할 때까지 인터럽트를 끈 채로
+	   둡니다. */
+	enum intr_level old_level = intr_disable();
+	hash_first(&i, &live_allocs);
+	while (hash_next(&i))
+	{
+		struct alloc_rec *r = hash_entry(hash_cur(&i), struct alloc_rec, elem);
+
+		for (s = 0; s < site_used; s++)
+			if (sites[s].caller == r->caller && sites[s].kind == r->kind)
+				break;
+		if (s == site_used)
+		{
+			if (site_used == SITE_MAX)
+			{
+				other_cnt++;
+				continue;
+			}
+			sites[site_used++] = (struct site){r->caller, r->kind, 0, 0};
+		}
+		sites[s].cnt++;
+		sites[s].bytes += r->size;
+	}
+
+	/* Sort the sites by bytes held, most first. */
+	/* 호출 지점을 잡고 있는 바이트 수가 많은 순으로 정렬합니다. */
+	for (s = 1; s < site_used; s++)
+	{
+		struct site site = sites[s];
+		size_t j;
+
+		for (j = s; j > 0 && sites[j - 1].bytes < site.bytes; j--)
+			sites[j] = sites[j - 1];
+		sites[j] = site;
+	}
+
+	printf("Live allocations by call site (%zu allocations, "
+		   "%llu untracked, %zu from unlisted sites):\n",
+		   hash_size(&live_allocs), untracked_cnt, other_cnt);
+	for (int kind = 0; kind < ALLOCPROF_KIND_CNT; kind++)
+	{
+		size_t shown = 0;
+
+		for (s = 0; s < site_used && shown < site_cnt; s++)
+			if (sites[s].kind == (enum allocprof_kind)kind)
+			{
+				printf("  %s %18p %8zu bytes in %zu\n", kind_names[kind],
+					   sites[s].caller, sites[s].bytes, sites[s].cnt);
+				shown++;
+			}
+	}
+	intr_set_level(old_level);
+}
+
+/* Returns a hash of the address of alloc_rec E. */
+/* alloc_rec E의 주소에 대한 해시를 반환합니다. */
+static uint64_t rec_hash(const struct hash_elem *e, void *aux UNUSED)
+{
+	const struct alloc_rec *r = hash_entry(e, struct alloc_rec, elem);
+	return hash_bytes(&r->ptr, sizeof r->ptr);
+}
+
+/* Orders alloc_recs A and B by address, then allocator. */
+/* alloc_rec A와 B를 주소, 그다음 할당기 순으로 정렬합니다. */
+static bool rec_less(const struct hash_elem *a_, const struct hash_elem *b_,
+					 void *aux UNUSED)
+{
+	const struct alloc_rec *a = hash_entry(a_, struct alloc_rec, elem);
+	const struct alloc_rec *b = hash_entry(b_, struct alloc_rec, elem);
+
+	if (a->ptr != b->ptr)
+		return a->ptr < b->ptr;
+	return a->kind < b->kind;
+}
@@ -0,0 +1,37 @@
+#include "threads/cpu.h"
+#include <debug.h>
+#include <string.h>
+
+/* State of every CPU.  Entry 0 is the bootstrap processor. */
+/* 모든 CPU의 상태. 0번 항목이 부트스트랩 프로세서입니다. */
+struct cpu cpus[NCPU_MAX];
+
+/* Number of CPUs in use.  Only the bootstrap processor runs
+   (see struct cpu), so this is 1. */
+/* 사용 중인 CPU 수. 부트스트랩 프로세서만 실행되므로(struct cpu
+   참조) 1입니다. */
+int ncpu = 1;
+
+/* Initializes C as the state for CPU number ID, with empty run
+   queues and no idle thread yet. */
+/* C를 ID번 CPU의 상태로 초기화합니다. 실행 대기열은 비어 있고
+   유휴 스레드는 아직 없습니다. */
+void cpu_init(struct cpu *c, int id)
+{
+	ASSERT(c != NULL);
+	ASSERT(0 <= id && id < NCPU_MAX);
+
+	memset(c, 0, sizeof *c);
+	c->id = id;
+	spin_init(&c->rq_lock);
+	for (int i = PRI_MIN; i <= PRI_MAX; i++)
+		list_init(&c->ready_queues[i]);
+}
+
+/* Returns the state of the CPU we are running on, which is
+   always cpus[0]. */
+/* 현재 실행 중인 CPU의 상태를 반환하며, 항상 cpus[0]입니다. */
+struct cpu *this_cpu(void)
+{
+	return &cpus[0];
+}
@@ -13,6 +13,7 @@
 #include "devices/serial.h"
 #include "devices/timer.h"
 #include "devices/vga.h"
+#include "threads/allocprof.h"
 #include "threads/interrupt.h"
 #include "threads/io.h"
 #include "threads/loader.h"
@@ -20,6 +21,7 @@
 #include "threads/mmu.h"
 #include "threads/palloc.h"
 #include "threads/pte.h"
+#include "threads/slab.h"
 #include "threads/thread.h"
 #ifdef USERPROG
 #include "userprog/process.h"
@@ -50,6 +52,12 @@ static bool format_filesys;
 /* -q: Power off after kernel tasks complete? */
 bool power_off_when_done;
 
+/* -no-pcid: Flush the TLB on every page map switch? */
+static bool no_pcid;
+
+/* -alloc-profile: Track live allocations by call site? */
+static bool alloc_profile;
+
 bool thread_tests;
 
 static void bss_init(void);
@@ -85,6 +93,9 @@ int main(void)
 	/* Initialize memory system. */
 	mem_end = palloc_init(); // 페이지 할당기 초기화 하고 메모리 사이즈 return
 	malloc_init();			 // malloc descriptor return
+	kmem_cache_init();		 // 객체 캐시 초기화
+	if (alloc_profile)
+		allocprof_init(); // 할당 프로파일러 시작
 	paging_init(mem_end);	 // 페이징 함수 호출
 
 #ifdef USERPROG // USERPROG 매크로 등록 되어 있을 때 만
@@ -167,11 +178,33 @@ static void paging_init(uint64_t mem_end)
 
 	// 실제 주소 [0 ~ mem_end]를 다음과 같이 매핑합니다.
 	// [LOADER_KERN_BASE ~ LOADER_KERN_BASE + mem_end].
+	uint64_t text_start = (uint64_t)&start, text_end = (uint64_t)&_end_kernel_text;
 	for (uint64_t pa = 0; pa < mem_end; pa += PGSIZE)
 	{
 		uint64_t va = (uint64_t)ptov(pa);
 		int perm = PTE_P | PTE_W;
 
+		// Map each aligned 2 MB chunk that lies entirely inside or
+		// entirely outside the kernel text with one large page; only
+		// the chunks the text boundaries fall in need page tables.
+		// 커널 텍스트 안에 완전히 들어가거나 완전히 바깥에 있는 정렬된
+		// 2 MB 구간은 대형 페이지 하나로 매핑합니다. 텍스트 경계가 걸친
+		// 구간만 페이지 테이블이 필요합니다.
+		if (lpg_ofs(pa) == 0 && mem_end - pa >= LPGSIZE)
+		{
+			bool in_text = text_start <= va && va + LPGSIZE <= text_end;
+			bool out_text = va + LPGSIZE <= text_start || text_end <= va;
+			uint64_t *pde;
+
+			if ((in_text || out_text) &&
+				(pde = pml4e_walk_pde(pml4, va, 1)) != NULL)
+			{
+				*pde = pa | PTE_PS | (in_text ? PTE_P : PTE_P | PTE_W);
+				pa += LPGSIZE - PGSIZE;
+				continue;
+			}
+		}
+
 		if ((uint64_t)&start <= va && va < (uint64_t)&_end_kernel_text)
 		{
 			perm &= ~PTE_W;
@@ -187,6 +220,11 @@ static void paging_init(uint64_t mem_end)
 
 	// reload cr3
 	pml4_activate(0);
+
+	// Tag TLB entries with PCIDs so that process switches keep them.
+	// 프로세스 전환 시 TLB 항목이 남도록 PCID를 붙입니다.
+	if (!no_pcid)
+		pml4_init_pcid();
 }
 
 /* Breaks the kernel command line into words and returns them as
@@ -249,9 +287,17 @@ static char **parse_options(char **argv)
 			random_init(atoi(value));
 		else if (!strcmp(name, "-mlfqs"))
 			thread_mlfqs = true;
+		else if (!strcmp(name, "-no-pcid"))
+			no_pcid = true;
+		else if (!strcmp(name, "-alloc-profile"))
+			alloc_profile = true;
+		else if (!strcmp(name, "-sched-stats"))
+			thread_sched_stats = true;
 #ifdef USERPROG
 		else if (!strcmp(name, "-ul"))
 			user_page_limit = atoi(value);
+		else if (!strcmp(name, "-rusage"))
+			process_rusage = true;
 		else if (!strcmp(name, "-threads-tests"))
 			thread_tests = true;
 #endif
@@ -284,6 +330,13 @@ static void run_task(char **argv)
 	printf("Execution of '%s' complete.\n", task);
 }
 
+/* Prints the call sites that hold the most memory. */
+/* 메모리를 가장 많이 잡고 있는 호출 지점을 출력합니다. */
+static void dump_allocs(char **argv UNUSED)
+{
+	allocprof_dump(10);
+}
+
 /* Executes all of the actions specified in ARGV[]
    up to the null pointer sentinel. */
 /* ARGV[] 에 지정된 모든 액션을 널 포인터 센티널까지
@@ -302,6 +355,7 @@ static void run_actions(char **argv)
 	/* 지원되는 작업 표입니다. */
 	static const struct action actions[] = {
 		{"run", 2, run_task},
+		{"allocprof", 1, dump_allocs},
 #ifdef FILESYS
 		{"ls", 1, fsutil_ls},
 		{"cat", 2, fsutil_cat},
@@ -349,6 +403,7 @@ static void usage(void)
 #else
 		   "  run TEST           Run TEST.\n"
 #endif
+		   "  allocprof          Print the call sites holding the most memory.\n"
 #ifdef FILESYS
 		   "  ls                 List files in the root directory.\n"
 		   "  cat FILE           Print FILE to the console.\n"
@@ -363,8 +418,12 @@ static void usage(void)
 		   "  -f                 Format file system disk during startup.\n"
 		   "  -rs=SEED           Set random number seed to SEED.\n"
 		   "  -mlfqs             Use multi-level feedback queue scheduler.\n"
+		   "  -no-pcid           Flush the TLB on every page map switch.\n"
+		   "  -alloc-profile     Track live allocations by call site.\n"
+		   "  -sched-stats       Print wakeup latency histogram at power-off.\n"
 #ifdef USERPROG
 		   "  -ul=COUNT          Limit user memory to COUNT pages.\n"
+		   "  -rusage            Print each process's resource usage at exit.\n"
 #endif
 	);
 	power_off();
@@ -395,6 +454,9 @@ static void print_stats(void)
 {
 	timer_print_stats();
 	thread_print_stats();
+	palloc_print_stats();
+	kmem_cache_print_stats();
+	pml4_print_stats();
 #ifdef FILESYS
 	disk_print_stats();
 #endif
@@ -403,4 +465,7 @@ static void print_stats(void)
 #ifdef USERPROG
 	exception_print_stats();
 #endif
+#ifdef VM
+	vm_print_stats();
+#endif
 }
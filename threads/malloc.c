@@ -1,44 +1,93 @@
 #include "threads/malloc.h"
+#include <bitmap.h>
 #include <debug.h>
 #include <list.h>
 #include <round.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include "threads/allocprof.h"
+#include "threads/interrupt.h"
 #include "threads/palloc.h"
 #include "threads/synch.h"
+#include "threads/thread.h"
 #include "threads/vaddr.h"
 
 /* A simple implementation of malloc().
 
-   The size of each request, in bytes, is rounded up to a power
-   of 2 and assigned to the "descriptor" that manages blocks of
-   that size.  The descriptor keeps a list of free blocks.  If
-   the free list is nonempty, one of its blocks is used to
-   satisfy the request.
+   The size of each request, in bytes, is rounded up to a size
+   class and assigned to the "descriptor" that manages blocks of
+   that size.  Size classes are spaced a quarter of a power of 2
+   apart (..., 256, 320, 384, 448, 512, 640, ...), so above 64
+   bytes rounding wastes less than a fifth of a block.  The descriptor keeps a list of
+   free blocks.  If the free list is nonempty, one of its blocks
+   is used to satisfy the request.
 
-   Otherwise, a new page of memory, called an "arena", is
-   obtained from the page allocator (if none is available,
-   malloc() returns a null pointer).  The new arena is divided
-   into blocks, all of which are added to the descriptor's free
-   list.  Then we return one of the new blocks.
+   Otherwise, a new run of memory, called an "arena", is obtained
+   from the page allocator (if none is available, malloc()
+   returns a null pointer).  The new arena is divided into blocks,
+   all of which are added to the descriptor's free list.  Then we
+   return one of the new blocks.
 
    When we free a block, we add it to its descriptor's free list.
    But if the arena that the block was in now has no in-use
    blocks, we remove all of the arena's blocks from the free list
    and give the arena back to the page allocator.
 
-   We can't handle blocks bigger than 2 kB using this scheme,
-   because they're too big to fit in a single page with a
-   descriptor.  We handle those by allocating contiguous pages
-   with the page allocator and sticking the allocation size at
-   the beginning of the allocated block's arena header. */
+   Most arenas are a single page, and a block finds its arena by
+   rounding its address down to a page.  Where a page would waste
+   more than an eighth of itself, as for some classes between
+   1 kB and 8 kB, the arena is 2 to 16 pages instead, and each block is
+   preceded by a pointer to its arena.  large_pages marks the
+   kernel pool pages that belong to such arenas.
+
+   Each thread keeps up to MC_BLOCK_MAX free blocks of each class
+   up to 1 kB in its own malloc_cache, so most malloc() and free()
+   calls do not take the descriptor's lock at all.  The cache is
+   refilled and drained MC_BATCH blocks at a time, and emptied
+   when the thread exits.
+
+   Requests bigger than 8 kB are handled by allocating contiguous
+   pages with the page allocator and sticking the allocation size
+   at the beginning of the allocated block's arena header. */
+/* malloc()의 간단한 구현.
+
+   각 요청의 바이트 크기는 크기 등급으로 올림되어 그 크기의 블록을
+   관리하는 "디스크립터"에 배정됩니다. 크기 등급은 2의 거듭제곱의
+   4분의 1 간격이므로 (..., 256, 320, 384, 448, 512, 640, ...) 64
+   바이트를 넘으면 올림으로 낭비되는 공간은 블록의 5분의 1 미만입니다. 디스크립터는 가용 블록
+   리스트를 유지하며, 리스트가 비어 있지 않으면 그 블록 하나로 요청을
+   처리합니다.
+
+   그렇지 않으면 페이지 할당자에서 "아레나"라고 부르는 새 메모리
+   구간을 얻습니다 (얻을 수 없으면 malloc()은 널 포인터를 반환합니다).
+   새 아레나는 블록으로 나뉘어 모두 디스크립터의 가용 리스트에
+   추가되고, 그중 하나를 반환합니다.
+
+   블록을 해제하면 디스크립터의 가용 리스트에 추가합니다. 그 블록이
+   있던 아레나에 사용 중인 블록이 더 이상 없으면, 아레나의 모든 블록을
+   가용 리스트에서 제거하고 아레나를 페이지 할당자에 돌려줍니다.
+
+   대부분의 아레나는 한 페이지이며, 블록은 주소를 페이지 단위로 내림해
+   자기 아레나를 찾습니다. 한 페이지가 자기 크기의 8분의 1보다 많이
+   낭비하게 되는 경우, 예컨대 1 kB에서 8 kB 사이의 일부 등급은 대신
+   2~16 페이지 아레나를 쓰고, 각 블록 앞에 아레나를 가리키는 포인터를 둡니다. large_pages는
+   그런 아레나에 속한 커널 풀 페이지를 표시합니다.
+
+   각 스레드는 1 kB 이하의 등급마다 최대 MC_BLOCK_MAX 개의 가용 블록을
+   자신의 malloc_cache에 두므로, 대부분의 malloc()과 free() 호출은
+   디스크립터의 락을 전혀 잡지 않습니다. 캐시는 MC_BATCH 개씩 채우고
+   비우며, 스레드가 종료할 때 비웁니다.
+
+   8 kB보다 큰 요청은 페이지 할당자로 연속된 페이지를 할당하고 할당된
+   블록의 아레나 헤더 시작 부분에 할당 크기를 넣어 처리합니다. */
 
 /* Descriptor. */
 struct desc
 {
 	size_t block_size;		 /* Size of each element in bytes. */
 	size_t blocks_per_arena; /* Number of blocks in an arena. */
+	size_t arena_pages;		 /* Pages in an arena. */
 	struct list free_list;	 /* List of free blocks. */
 	struct lock lock;		 /* Lock. */
 };
@@ -60,27 +109,95 @@ struct block
 	struct list_elem free_elem; /* Free list element. */
 };
 
+#define BLOCK_MIN 16			 /* Smallest size class. */
+#define BLOCK_MAX (8 * 1024)	 /* Largest size class. */
+#define ARENA_PAGES_MAX 16		 /* Most pages in one arena. */
+#define MC_CLASS_MAX 1024		 /* Largest class a thread caches. */
+#define MC_BLOCK_MAX 8			 /* Most cached blocks per class. */
+#define MC_BATCH 4				 /* Blocks moved to or from a desc at once. */
+#define MC_DESC_MAX 24			 /* Most descriptors a thread caches. */
+
 /* Our set of descriptors. */
-static struct desc descs[10]; /* Descriptors. */
+static struct desc descs[40]; /* Descriptors. */
 static size_t desc_cnt;		  /* Number of descriptors. */
+static size_t mc_desc_cnt;	  /* Number of descriptors threads cache. */
 
+/* A thread's cache of free blocks, one stack per descriptor up to
+   MC_CLASS_MAX, linked through the blocks' first word. */
+/* 스레드의 가용 블록 캐시. MC_CLASS_MAX까지의 디스크립터마다 스택이
+   하나씩 있으며, 블록의 첫 워드로 연결됩니다. */
+struct malloc_cache
+{
+	void *blocks[MC_DESC_MAX]; /* Top of each stack. */
+							   /* 각 스택의 꼭대기. */
+	uint8_t cnt[MC_DESC_MAX];  /* Blocks in each stack. */
+							   /* 각 스택의 블록 수. */
+};
+
+/* Kernel pool pages that belong to multi-page arenas.  Every
+   page of such an arena is marked, not just its first, because
+   a block may lie on any of them.  Big blocks are not marked:
+   their only block starts right after the arena header on the
+   first page, like a block in a one-page arena. */
+/* 여러 페이지 아레나에 속한 커널 풀 페이지. 블록이 그중 어느
+   페이지에나 있을 수 있으므로 첫 페이지만이 아니라 아레나의 모든
+   페이지를 표시합니다. 큰 블록은 표시하지 않습니다. 큰 블록의 유일한
+   블록은 한 페이지 아레나의 블록처럼 첫 페이지의 아레나 헤더 바로
+   뒤에서 시작하기 때문입니다. */
+static struct bitmap *large_pages;
+static uint8_t *kernel_base; /* First page of the kernel pool. */
+							 /* 커널 풀의 첫 페이지. */
+
+static void *get_block(size_t size);
+static struct desc *size_to_desc(size_t size);
+static void mark_large(struct arena *, bool);
 static struct arena *block_to_arena(struct block *);
 static struct block *arena_to_block(struct arena *, size_t idx);
+static struct malloc_cache *thread_malloc_cache(bool create);
+static struct block *desc_alloc(struct desc *);
+static void desc_free(struct desc *, struct block *);
 
 /* Initializes the malloc() descriptors. */
 void malloc_init(void)
 {
-	size_t block_size;
+	size_t block_size, page_cnt;
+	void *map;
 
-	for (block_size = 16; block_size < PGSIZE / 2; block_size *= 2)
+	for (block_size = BLOCK_MIN; block_size <= BLOCK_MAX;)
 	{
 		struct desc *d = &descs[desc_cnt++];
+		size_t pow2 = (size_t)1 << (63 - __builtin_clzll(block_size));
+		size_t step = pow2 / 4 > 8 ? pow2 / 4 : 8;
+
 		ASSERT(desc_cnt <= sizeof descs / sizeof *descs);
 		d->block_size = block_size;
-		d->blocks_per_arena = (PGSIZE - sizeof(struct arena)) / block_size;
+
+		/* Take the smallest arena that wastes no more than an
+		   eighth of itself. */
+		/* 자기 크기의 8분의 1 이하만 낭비하는 가장 작은 아레나를
+		   고릅니다. */
+		for (d->arena_pages = 1;; d->arena_pages *= 2)
+		{
+			size_t arena_size = d->arena_pages * PGSIZE;
+			size_t stride = block_size + (d->arena_pages > 1 ? sizeof(struct arena *) : 0);
+
+			d->blocks_per_arena = (arena_size - sizeof(struct arena)) / stride;
+			if (d->arena_pages == ARENA_PAGES_MAX || (arena_size - d->blocks_per_arena * block_size) * 8 <= arena_size)
+				break;
+		}
 		list_init(&d->free_list);
 		lock_init(&d->lock);
+		if (block_size <= MC_CLASS_MAX)
+			mc_desc_cnt = desc_cnt;
+		ASSERT(mc_desc_cnt <= MC_DESC_MAX);
+
+		block_size += step;
 	}
+
+	page_cnt = palloc_kernel_pool(&map);
+	kernel_base = map;
+	map = palloc_get_multiple(PAL_ASSERT, DIV_ROUND_UP(bitmap_buf_size(page_cnt), PGSIZE));
+	large_pages = bitmap_create_in_buf(page_cnt, map, bitmap_buf_size(page_cnt));
 }
 
 /* Obtains and returns a new block of at least SIZE bytes.
@@ -88,9 +205,21 @@ void malloc_init(void)
 /* 최소 SIZE 바이트의 새 블록을 가져와 반환합니다.
    메모리를 사용할 수 없는 경우 널 포인터를 반환합니다. */
 void *malloc(size_t size)
+{
+	void *p = get_block(size);
+
+	if (allocprof_on)
+		allocprof_record(ALLOCPROF_MALLOC, p, size, __builtin_return_address(0));
+	return p;
+}
+
+/* Does the work of malloc(), leaving the allocation profiler to
+   its caller, which knows the call site. */
+/* malloc()의 일을 하되, 할당 프로파일러는 호출 지점을 아는 호출자에게
+   맡깁니다. */
+static void *get_block(size_t size)
 {
 	struct desc *d;
-	struct block *b;
 	struct arena *a;
 
 	/* A null pointer satisfies a request for 0 bytes. */
@@ -101,10 +230,8 @@ void *malloc(size_t size)
 	/* Find the smallest descriptor that satisfies a SIZE-byte
 	   request. */
 	/* SIZE-byte 요청을 만족하는 가장 작은 디스크립터를 찾습니다. */
-	for (d = descs; d < descs + desc_cnt; d++)
-		if (d->block_size >= size)
-			break;
-	if (d == descs + desc_cnt)
+	d = size_to_desc(size);
+	if (d == NULL)
 	{
 		/* SIZE is too big for any descriptor.
 		   Allocate enough pages to hold SIZE plus an arena. */
@@ -125,40 +252,39 @@ void *malloc(size_t size)
 		return a + 1;
 	}
 
-	lock_acquire(&d->lock);
-
-	/* If the free list is empty, create a new arena. */
-	/* 가용 목록이 비어 있으면 새 아레나를 만듭니다. */
-	if (list_empty(&d->free_list))
+	/* Pop a block off this thread's cache, refilling it from the
+	   descriptor if it is empty. */
+	/* 이 스레드의 캐시에서 블록을 꺼내며, 비어 있으면 디스크립터에서
+	   채웁니다. */
+	size_t idx = d - descs;
+	struct malloc_cache *mc = idx < mc_desc_cnt ? thread_malloc_cache(true) : NULL;
+	if (mc != NULL)
 	{
-		size_t i;
-
-		/* Allocate a page. */
-		/* 페이지를 할당합니다. */
-		a = palloc_get_page(0);
-		if (a == NULL)
+		if (mc->cnt[idx] == 0)
 		{
+			lock_acquire(&d->lock);
+			while (mc->cnt[idx] < MC_BATCH)
+			{
+				struct block *b = desc_alloc(d);
+				if (b == NULL)
+					break;
+				*(void **)b = mc->blocks[idx];
+				mc->blocks[idx] = b;
+				mc->cnt[idx]++;
+			}
 			lock_release(&d->lock);
-			return NULL;
 		}
+		if (mc->cnt[idx] == 0)
+			return NULL;
 
-		/* Initialize arena and add its blocks to the free list. */
-		/* 아레나를 초기화하고 해당 블록을 가용 목록에 추가합니다. */
-		a->magic = ARENA_MAGIC;
-		a->desc = d;
-		a->free_cnt = d->blocks_per_arena;
-		for (i = 0; i < d->blocks_per_arena; i++)
-		{
-			struct block *b = arena_to_block(a, i);
-			list_push_back(&d->free_list, &b->free_elem);
-		}
+		void *b = mc->blocks[idx];
+		mc->blocks[idx] = *(void **)b;
+		mc->cnt[idx]--;
+		return b;
 	}
 
-	/* Get a block from free list and return it. */
-	/* 가용 목록에서 블록을 가져와서 반환합니다. */
-	b = list_entry(list_pop_front(&d->free_list), struct block, free_elem);
-	a = block_to_arena(b);
-	a->free_cnt--;
+	lock_acquire(&d->lock);
+	struct block *b = desc_alloc(d);
 	lock_release(&d->lock);
 	return b;
 }
@@ -180,7 +306,10 @@ void *calloc(size_t a, size_t b)
 
 	/* Allocate and zero memory. */
 	/* 메모리를 할당하고 제로화합니다. */
-	void *p = malloc(size);
+	void *p = get_block(size);
+
+	if (allocprof_on)
+		allocprof_record(ALLOCPROF_MALLOC, p, size, __builtin_return_address(0));
 
 	if (p != NULL)
 	{
@@ -190,6 +319,19 @@ void *calloc(size_t a, size_t b)
 	return p;
 }
 
+/* Returns the bytes of memory that malloc() uses up for a block
+   of SIZE bytes, counting the block's share of its arena. */
+/* SIZE 바이트 블록에 malloc()이 쓰는 메모리 바이트 수를, 블록이
+   차지하는 아레나 몫까지 포함해 반환합니다. */
+size_t malloc_footprint(size_t size)
+{
+	struct desc *d = size_to_desc(size);
+
+	if (d != NULL)
+		return d->arena_pages * PGSIZE / d->blocks_per_arena;
+	return DIV_ROUND_UP(size + sizeof(struct arena), PGSIZE) * PGSIZE;
+}
+
 /* Returns the number of bytes allocated for BLOCK. */
 static size_t
 block_size(void *block)
@@ -217,7 +359,10 @@ realloc(void *old_block, size_t new_size)
 	}
 	else
 	{
-		void *new_block = malloc(new_size);
+		void *new_block = get_block(new_size);
+		if (allocprof_on)
+			allocprof_record(ALLOCPROF_MALLOC, new_block, new_size,
+							 __builtin_return_address(0));
 		if (old_block != NULL && new_block != NULL)
 		{
 			size_t old_size = block_size(old_block);
@@ -235,6 +380,9 @@ realloc(void *old_block, size_t new_size)
    블록 P를 해제합니다. */
 void free(void *p)
 {
+	if (allocprof_on)
+		allocprof_forget(ALLOCPROF_MALLOC, p);
+
 	if (p != NULL)
 	{
 		struct block *b = p;
@@ -252,27 +400,34 @@ void free(void *p)
 			memset(b, 0xcc, d->block_size);
 #endif
 
-			lock_acquire(&d->lock);
-
-			/* Add block to free list. */
-			/* 가용 목록에 블록을 추가합니다. */
-			list_push_front(&d->free_list, &b->free_elem);
-
-			/* If the arena is now entirely unused, free it. */
-			/* 현재 아레나가 완전히 사용되지 않는다면 해제합니다. */
-			if (++a->free_cnt >= d->blocks_per_arena)
+			/* Push the block onto this thread's cache, first
+			   draining the cache if it is full. */
+			/* 블록을 이 스레드의 캐시에 넣으며, 캐시가 가득 차 있으면
+			   먼저 비웁니다. */
+			size_t idx = d - descs;
+			struct malloc_cache *mc = idx < mc_desc_cnt ? thread_malloc_cache(false) : NULL;
+			if (mc != NULL)
 			{
-				size_t i;
-
-				ASSERT(a->free_cnt == d->blocks_per_arena);
-				for (i = 0; i < d->blocks_per_arena; i++)
+				if (mc->cnt[idx] == MC_BLOCK_MAX)
 				{
-					struct block *b = arena_to_block(a, i);
-					list_remove(&b->free_elem);
+					lock_acquire(&d->lock);
+					while (mc->cnt[idx] > MC_BLOCK_MAX - MC_BATCH)
+					{
+						struct block *old = mc->blocks[idx];
+						mc->blocks[idx] = *(void **)old;
+						mc->cnt[idx]--;
+						desc_free(d, old);
+					}
+					lock_release(&d->lock);
 				}
-				palloc_free_page(a);
+				*(void **)b = mc->blocks[idx];
+				mc->blocks[idx] = b;
+				mc->cnt[idx]++;
+				return;
 			}
 
+			lock_acquire(&d->lock);
+			desc_free(d, b);
 			lock_release(&d->lock);
 		}
 		else
@@ -285,11 +440,80 @@ void free(void *p)
 	}
 }
 
+/* Gives every block in the running thread's cache back to its
+   descriptor and frees the cache.  Called when the thread
+   exits. */
+/* 실행 중인 스레드의 캐시에 있는 모든 블록을 디스크립터에 돌려주고
+   캐시를 해제합니다. 스레드가 종료할 때 호출됩니다. */
+void malloc_thread_exit(void)
+{
+	struct thread *t = thread_current();
+	struct malloc_cache *mc = t->malloc_cache;
+	size_t idx;
+
+	if (mc == NULL)
+		return;
+
+	t->malloc_cache = NULL;
+	for (idx = 0; idx < mc_desc_cnt; idx++)
+	{
+		struct desc *d = &descs[idx];
+
+		if (mc->cnt[idx] == 0)
+			continue;
+		lock_acquire(&d->lock);
+		while (mc->cnt[idx] > 0)
+		{
+			struct block *b = mc->blocks[idx];
+			mc->blocks[idx] = *(void **)b;
+			mc->cnt[idx]--;
+			desc_free(d, b);
+		}
+		lock_release(&d->lock);
+	}
+	free(mc);
+}
+
+/* Returns the descriptor for blocks of SIZE bytes, or a null
+   pointer if SIZE is bigger than any size class. */
+/* SIZE 바이트 블록의 디스크립터를 반환하며, SIZE가 모든 크기
+   등급보다 크면 널 포인터를 반환합니다. */
+static struct desc *size_to_desc(size_t size)
+{
+	size_t idx;
+
+	if (size > BLOCK_MAX)
+		return NULL;
+	if (size <= 64)
+		idx = size <= BLOCK_MIN ? 0 : (ROUND_UP(size, 8) - BLOCK_MIN) / 8;
+	else
+	{
+		/* SIZE is in (2**K, 2**(K + 1)]; find its quarter. */
+		/* SIZE는 (2**K, 2**(K + 1)] 구간에 있으며, 그 4분위를 찾습니다. */
+		int k = 63 - __builtin_clzll(size - 1);
+		size_t quarter = DIV_ROUND_UP(size - ((size_t)1 << k), (size_t)1 << (k - 2));
+		idx = (64 - BLOCK_MIN) / 8 + (k - 6) * 4 + quarter;
+	}
+
+	ASSERT(idx < desc_cnt && descs[idx].block_size >= size);
+	return &descs[idx];
+}
+
 /* Returns the arena that block B is inside. */
 /* 블록 B가 있는 아레나를 반환합니다. */
 static struct arena *block_to_arena(struct block *b)
 {
-	struct arena *a = pg_round_down(b);
+	size_t page_idx = pg_no(b) - pg_no(kernel_base);
+	struct arena *a;
+
+	/* A block in a multi-page arena is preceded by a pointer to
+	   it; any other block's arena starts its page. */
+	/* 여러 페이지 아레나의 블록 앞에는 아레나를 가리키는 포인터가
+	   있고, 그 외 블록의 아레나는 블록이 있는 페이지의 시작입니다. */
+	if ((uint8_t *)b >= kernel_base && page_idx < bitmap_size(large_pages) && bitmap_test(large_pages, page_idx))
+		a = ((struct arena **)b)[-1];
+	else
+		a = pg_round_down(b);
 
 	/* Check that the arena is valid. */
 	/* arena가 유효한지 확인합니다. */
@@ -298,7 +522,7 @@ static struct arena *block_to_arena(struct block *b)
 
 	/* Check that the block is properly aligned for the arena. */
 	/* 블록이 아레나에 맞게 제대로 정렬되었는지 확인합니다. */
-	ASSERT(a->desc == NULL || (pg_ofs(b) - sizeof *a) % a->desc->block_size == 0);
+	ASSERT(a->desc == NULL || a->desc->arena_pages > 1 || (pg_ofs(b) - sizeof *a) % a->desc->block_size == 0);
 	ASSERT(a->desc != NULL || pg_ofs(b) == sizeof *a);
 
 	return a;
@@ -308,8 +532,134 @@ static struct arena *block_to_arena(struct block *b)
 /* 아레나 A 내의 (IDX - 1)'번째 블록을 반환합니다. */
 static struct block *arena_to_block(struct arena *a, size_t idx)
 {
+	struct desc *d;
+
 	ASSERT(a != NULL);
 	ASSERT(a->magic == ARENA_MAGIC);
-	ASSERT(idx < a->desc->blocks_per_arena);
-	return (struct block *)((uint8_t *)a + sizeof *a + idx * a->desc->block_size);
+	d = a->desc;
+	ASSERT(idx < d->blocks_per_arena);
+	if (d->arena_pages == 1)
+		return (struct block *)((uint8_t *)a + sizeof *a + idx * d->block_size);
+	return (struct block *)((uint8_t *)a + sizeof *a + idx * (sizeof a + d->block_size) + sizeof a);
+}
+
+/* Marks the pages of A, a multi-page arena, as belonging to a
+   multi-page arena if LARGE is true, or as not belonging to one
+   otherwise.  The bitmap is shared by all descriptors, so this
+   runs with interrupts off rather than under a descriptor's
+   lock. */
+/* 여러 페이지 아레나인 A의 페이지를, LARGE가 true이면 여러 페이지
+   아레나에 속한다고, 아니면 속하지 않는다고 표시합니다. 비트맵은 모든
+   디스크립터가 공유하므로 디스크립터의 락 대신 인터럽트를 끈 상태로
+   실행합니다. */
+static void mark_large(struct arena *a, bool large)
+{
+	enum intr_level old_level = intr_disable();
+	bitmap_set_multiple(large_pages, pg_no(a) - pg_no(kernel_base), a->desc->arena_pages, large);
+	intr_set_level(old_level);
+}
+
+/* Returns the running thread's malloc cache, creating it if
+   CREATE is true and it does not exist yet.  Returns a null
+   pointer if there is no cache. */
+/* 실행 중인 스레드의 malloc 캐시를 반환하며, CREATE가 true이고 아직
+   없으면 만듭니다. 캐시가 없으면 널 포인터를 반환합니다. */
+static struct malloc_cache *thread_malloc_cache(bool create)
+{
+	struct thread *t = thread_current();
+
+	if (t->malloc_cache == NULL && create)
+	{
+		/* Bypass the cache to allocate the cache itself. */
+		/* 캐시 자체는 캐시를 거치지 않고 할당합니다. */
+		struct desc *d = size_to_desc(sizeof *t->malloc_cache);
+
+		lock_acquire(&d->lock);
+		t->malloc_cache = (struct malloc_cache *)desc_alloc(d);
+		lock_release(&d->lock);
+		if (t->malloc_cache != NULL)
+			memset(t->malloc_cache, 0, sizeof *t->malloc_cache);
+	}
+	return t->malloc_cache;
+}
+
+/* Takes a free block from D, creating a new arena if its free
+   list is empty.  Returns a null pointer if memory is not
+   available.  D's lock must be held. */
+/* D에서 가용 블록을 가져오며, 가용 리스트가 비어 있으면 새 아레나를
+   만듭니다. 메모리를 사용할 수 없으면 널 포인터를 반환합니다. D의
+   락을 잡고 있어야 합니다. */
+static struct block *desc_alloc(struct desc *d)
+{
+	struct block *b;
+	struct arena *a;
+
+	ASSERT(lock_held_by_current_thread(&d->lock));
+
+	/* If the free list is empty, create a new arena. */
+	/* 가용 목록이 비어 있으면 새 아레나를 만듭니다. */
+	if (list_empty(&d->free_list))
+	{
+		size_t i;
+
+		/* Allocate the arena's pages. */
+		/* 아레나의 페이지를 할당합니다. */
+		a = palloc_get_multiple(0, d->arena_pages);
+		if (a == NULL)
+			return NULL;
+
+		/* Initialize arena and add its blocks to the free list. */
+		/* 아레나를 초기화하고 해당 블록을 가용 목록에 추가합니다. */
+		a->magic = ARENA_MAGIC;
+		a->desc = d;
+		a->free_cnt = d->blocks_per_arena;
+		for (i = 0; i < d->blocks_per_arena; i++)
+		{
+			struct block *b = arena_to_block(a, i);
+			if (d->arena_pages > 1)
+				((struct arena **)b)[-1] = a;
+			list_push_back(&d->free_list, &b->free_elem);
+		}
+		if (d->arena_pages > 1)
+			mark_large(a, true);
+	}
+
+	/* Get a block from free list and return it. */
+	/* 가용 목록에서 블록을 가져와서 반환합니다. */
+	b = list_entry(list_pop_front(&d->free_list), struct block, free_elem);
+	a = block_to_arena(b);
+	a->free_cnt--;
+	return b;
+}
+
+/* Returns block B to D, freeing its arena if that leaves the
+   arena entirely unused.  D's lock must be held. */
+/* 블록 B를 D에 돌려주며, 그로 인해 아레나가 완전히 사용되지 않게
+   되면 아레나를 해제합니다. D의 락을 잡고 있어야 합니다. */
+static void desc_free(struct desc *d, struct block *b)
+{
+	struct arena *a = block_to_arena(b);
+
+	ASSERT(lock_held_by_current_thread(&d->lock));
+
+	/* Add block to free list. */
+	/* 가용 목록에 블록을 추가합니다. */
+	list_push_front(&d->free_list, &b->free_elem);
+
+	/* If the arena is now entirely unused, free it. */
+	/* 현재 아레나가 완전히 사용되지 않는다면 해제합니다. */
+	if (++a->free_cnt >= d->blocks_per_arena)
+	{
+		size_t i;
+
+		ASSERT(a->free_cnt == d->blocks_per_arena);
+		for (i = 0; i < d->blocks_per_arena; i++)
+		{
+			struct block *b = arena_to_block(a, i);
+			list_remove(&b->free_elem);
+		}
+		if (d->arena_pages > 1)
+			mark_large(a, false);
+		palloc_free_multiple(a, d->arena_pages);
+	}
 }
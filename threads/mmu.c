@@ -1,20 +1,70 @@
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdio.h>
 #include <string.h>
+#include "threads/cpu.h"
 #include "threads/init.h"
+#include "threads/interrupt.h"
 #include "threads/pte.h"
 #include "threads/palloc.h"
 #include "threads/thread.h"
 #include "threads/mmu.h"
 #include "intrinsic.h"
 
+#define CPUID_PCID (1 << 17)	 /* CPUID.1:ECX bit: PCIDs supported. */
+#define CR4_PCIDE (1 << 17)		 /* CR4 bit: tag TLB entries with PCIDs. */
+#define CR3_PCID_MASK 0xfff		 /* CR3 bits that hold the PCID. */
+#define CR3_NOFLUSH (1UL << 63) /* Keep the new PCID's TLB entries. */
+
+/* True once PCIDs are in use; see pml4_init_pcid(). */
+/* PCID를 사용하기 시작하면 참; pml4_init_pcid()를 참조하세요. */
+static bool pcid_on;
+
+static void pcid_mark_stale(uint64_t *pml4, struct cpu *skip, bool release);
+static void tlb_invalidate(uint64_t *pml4, uint64_t va);
+
+/* Replaces the 2 MB mapping in PDE by a page table of 512 4 kB
+ * mappings with the same frames and permissions, so that single
+ * pages of it can be unmapped or protected on their own.
+ * Returns false if no page table could be allocated. */
+/* PDE의 2 MB 매핑을 같은 프레임과 권한을 가진 512개의 4 kB 매핑으로
+ * 이루어진 페이지 테이블로 바꾸어, 그 안의 페이지 하나하나를 따로
+ * 해제하거나 보호할 수 있게 합니다. 페이지 테이블을 할당할 수 없으면
+ * false를 반환합니다. */
+static bool split_pde(uint64_t *pde)
+{
+	uint64_t *pt = palloc_get_page(0);
+	if (pt == NULL)
+		return false;
+
+	/* Bit 12 of a large PDE is its PAT bit, not an address bit. */
+	/* 대형 PDE의 12번 비트는 주소 비트가 아니라 PAT 비트입니다. */
+	uint64_t pa = PTE_ADDR(*pde) & ~(LPGSIZE - 1);
+	uint64_t flags = *pde & PTE_FLAGS & ~PTE_PS;
+	for (unsigned i = 0; i < LPGCNT; i++)
+		pt[i] = (pa + i * PGSIZE) | flags;
+	*pde = vtop(pt) | PTE_U | PTE_W | PTE_P;
+	return true;
+}
+
+/* If VA falls in a 2 MB page, returns its PDE.  With CREATE set
+ * the large page has already been split by pml4e_walk(), which
+ * can flush the TLB for it. */
+/* VA가 2 MB 페이지에 속하면 그 PDE를 반환합니다. CREATE가 설정되어
+ * 있으면 TLB를 비울 수 있는 pml4e_walk()가 이미 대형 페이지를
+ * 분할했습니다. */
 static uint64_t *pgdir_walk(uint64_t *pdp, const uint64_t va, int create)
 {
 	int idx = PDX(va);
 	if (pdp)
 	{
 		uint64_t *pte = (uint64_t *)pdp[idx];
-		if (!((uint64_t)pte & PTE_P))
+		if (((uint64_t)pte & PTE_P) && ((uint64_t)pte & PTE_PS))
+		{
+			ASSERT(!create);
+			return &pdp[idx];
+		}
+		else if (!((uint64_t)pte & PTE_P))
 		{
 			if (create)
 			{
@@ -84,6 +134,12 @@ uint64_t *pml4e_walk(uint64_t *pml4e, const uint64_t va, int create)
 	int allocated = 0;
 	if (pml4e)
 	{
+		/* A 2 MB page is split, with its TLB entry flushed, before a
+		   4 kB PTE inside it is handed out. */
+		/* 그 안의 4 kB PTE를 내주기 전에 2 MB 페이지를 분할하고 그
+		   TLB 항목을 비웁니다. */
+		if (create && !pml4_split_page(pml4e, (void *)va))
+			return NULL;
 		uint64_t *pdpe = (uint64_t *)pml4e[idx];
 		if (!((uint64_t)pdpe & PTE_P))
 		{
@@ -111,6 +167,49 @@ uint64_t *pml4e_walk(uint64_t *pml4e, const uint64_t va, int create)
 	return pte;
 }
 
+/* Returns the address of the page directory entry for virtual
+ * address VA in PML4, creating the upper levels of the page
+ * table if CREATE is true, as pml4e_walk() does.  The entry may
+ * be empty, map a 2 MB page, or point to a page table.  Returns
+ * a null pointer if an upper level is missing and CREATE is
+ * false, or if memory allocation fails. */
+/* PML4에서 가상 주소 VA에 대한 페이지 디렉터리 항목의 주소를
+ * 반환하며, pml4e_walk()처럼 CREATE가 참이면 페이지 테이블의 상위
+ * 단계를 생성합니다. 항목은 비어 있거나, 2 MB 페이지를 매핑하거나,
+ * 페이지 테이블을 가리킬 수 있습니다. 상위 단계가 없고 CREATE가
+ * 거짓이거나 메모리 할당이 실패하면 널 포인터를 반환합니다. */
+uint64_t *pml4e_walk_pde(uint64_t *pml4e, const uint64_t va, int create)
+{
+	uint64_t *pdpe_entry = &pml4e[PML4(va)];
+	bool allocated = false;
+
+	if (!(*pdpe_entry & PTE_P))
+	{
+		uint64_t *new_page = create ? palloc_get_page(PAL_ZERO) : NULL;
+		if (new_page == NULL)
+			return NULL;
+		*pdpe_entry = vtop(new_page) | PTE_U | PTE_W | PTE_P;
+		allocated = true;
+	}
+
+	uint64_t *pde_entry = (uint64_t *)ptov(PTE_ADDR(*pdpe_entry)) + PDPE(va);
+	if (!(*pde_entry & PTE_P))
+	{
+		uint64_t *new_page = create ? palloc_get_page(PAL_ZERO) : NULL;
+		if (new_page == NULL)
+		{
+			if (allocated)
+			{
+				palloc_free_page(ptov(PTE_ADDR(*pdpe_entry)));
+				*pdpe_entry = 0;
+			}
+			return NULL;
+		}
+		*pde_entry = vtop(new_page) | PTE_U | PTE_W | PTE_P;
+	}
+	return (uint64_t *)ptov(PTE_ADDR(*pde_entry)) + PDX(va);
+}
+
 /* Creates a new page map level 4 (pml4) has mappings for kernel
  * virtual addresses, but none for user virtual addresses.
  * Returns the new page directory, or a null pointer if memory
@@ -149,6 +248,27 @@ static bool pt_for_each(uint64_t *pt, pte_for_each_func *func, void *aux,
 	return true;
 }
 
+/* Calls FUNC once for each 4 kB page of the 2 MB page mapped by
+ * PDE, passing PDE itself as the PTE, so that callers written for
+ * 4 kB pages see every page of a large one. */
+/* PDE가 매핑하는 2 MB 페이지의 4 kB 페이지마다 PDE 자체를 PTE로
+ * 넘기며 FUNC를 한 번씩 호출하여, 4 kB 페이지를 가정하고 작성된
+ * 호출자도 대형 페이지의 모든 페이지를 보게 합니다. */
+static bool large_for_each(uint64_t *pde, pte_for_each_func *func, void *aux,
+						   unsigned pml4_index, unsigned pdp_index, unsigned pdx_index)
+{
+	for (unsigned i = 0; i < LPGCNT; i++)
+	{
+		void *va = (void *)(((uint64_t)pml4_index << PML4SHIFT) |
+							((uint64_t)pdp_index << PDPESHIFT) |
+							((uint64_t)pdx_index << PDXSHIFT) |
+							((uint64_t)i << PTXSHIFT));
+		if (!func(pde, va, aux))
+			return false;
+	}
+	return true;
+}
+
 static bool pgdir_for_each(uint64_t *pdp, pte_for_each_func *func, void *aux,
 						   unsigned pml4_index, unsigned pdp_index)
 {
@@ -156,9 +276,16 @@ static bool pgdir_for_each(uint64_t *pdp, pte_for_each_func *func, void *aux,
 	{
 		uint64_t *pte = ptov((uint64_t *)pdp[i]);
 		if (((uint64_t)pte) & PTE_P)
-			if (!pt_for_each((uint64_t *)PTE_ADDR(pte), func, aux,
-							 pml4_index, pdp_index, i))
+		{
+			if (((uint64_t)pte) & PTE_PS)
+			{
+				if (!large_for_each(&pdp[i], func, aux, pml4_index, pdp_index, i))
+					return false;
+			}
+			else if (!pt_for_each((uint64_t *)PTE_ADDR(pte), func, aux,
+								  pml4_index, pdp_index, i))
 				return false;
+		}
 	}
 	return true;
 }
@@ -207,7 +334,9 @@ static void pgdir_destroy(uint64_t *pdp)
 	for (unsigned i = 0; i < PGSIZE / sizeof(uint64_t *); i++)
 	{
 		uint64_t *pte = ptov((uint64_t *)pdp[i]);
-		if (((uint64_t)pte) & PTE_P)
+		if ((((uint64_t)pte) & PTE_P) && (((uint64_t)pte) & PTE_PS))
+			palloc_free_multiple((void *)(PTE_ADDR(pte) & ~(LPGSIZE - 1)), LPGCNT);
+		else if (((uint64_t)pte) & PTE_P)
 			pt_destroy(PTE_ADDR(pte));
 	}
 	palloc_free_page((void *)pdp);
@@ -232,6 +361,17 @@ void pml4_destroy(uint64_t *pml4)
 		return;
 	ASSERT(pml4 != base_pml4);
 
+	/* Its PCIDs may be handed to the next page map allocated at
+	 * the same address, which must not see these entries. */
+	/* PCID는 같은 주소에 할당될 다음 페이지 맵에 넘어갈 수 있으며, 그
+	 * 페이지 맵이 이 항목들을 보아서는 안 됩니다. */
+	if (pcid_on)
+	{
+		enum intr_level old_level = intr_disable();
+		pcid_mark_stale(pml4, NULL, true);
+		intr_set_level(old_level);
+	}
+
 	/* if PML4 (vaddr) >= 1, it's kernel space by define. */
 	/* PML4 (vaddr) >= 1이면, 정의에 의한 커널 공간입니다. */
 	uint64_t *pdpe = ptov((uint64_t *)pml4[0]);
@@ -240,13 +380,195 @@ void pml4_destroy(uint64_t *pml4)
 	palloc_free_page((void *)pml4);
 }
 
+/* Counts the user pages mapped in PML4 into *USER_PAGES and the
+ * pages its page tables take up, PML4 itself included, into
+ * *TABLE_PAGES.  A large page counts as LPGCNT user pages.  The
+ * kernel's tables are shared with base_pml4 and not counted. */
+/* PML4에 매핑된 사용자 페이지 수를 *USER_PAGES에, PML4 자신을 포함해
+ * 페이지 테이블이 차지하는 페이지 수를 *TABLE_PAGES에 셉니다. 대형
+ * 페이지는 LPGCNT개의 사용자 페이지로 셉니다. 커널의 테이블은
+ * base_pml4와 공유하므로 세지 않습니다. */
+void pml4_count_pages(uint64_t *pml4, size_t *user_pages, size_t *table_pages)
+{
+	*user_pages = 0;
+	*table_pages = 1;
+
+	uint64_t *pdpe = ptov((uint64_t *)pml4[0]);
+	if (!(((uint64_t)pdpe) & PTE_P))
+		return;
+	pdpe = (uint64_t *)PTE_ADDR(pdpe);
+	++*table_pages;
+	for (unsigned i = 0; i < PGSIZE / sizeof(uint64_t *); i++)
+	{
+		if (!(pdpe[i] & PTE_P))
+			continue;
+		uint64_t *pgdir = ptov(PTE_ADDR(pdpe[i]));
+		++*table_pages;
+		for (unsigned j = 0; j < PGSIZE / sizeof(uint64_t *); j++)
+		{
+			if (!(pgdir[j] & PTE_P))
+				continue;
+			if (pgdir[j] & PTE_PS)
+			{
+				*user_pages += LPGCNT;
+				continue;
+			}
+			uint64_t *pt = ptov(PTE_ADDR(pgdir[j]));
+			++*table_pages;
+			for (unsigned k = 0; k < PGSIZE / sizeof(uint64_t *); k++)
+				if (pt[k] & PTE_P)
+					++*user_pages;
+		}
+	}
+}
+
+/* Returns the PCID that PML4 uses on CPU C, handing it a free
+ * one or taking one from another page map if it has none.  A
+ * newly handed out PCID is marked stale, so that entries left
+ * by its previous owner are flushed.  Interrupts must be off. */
+/* CPU C에서 PML4가 사용하는 PCID를 반환하며, 없으면 빈 PCID를 주거나
+ * 다른 페이지 맵의 것을 빼앗아 줍니다. 새로 준 PCID는 이전 주인이 남긴
+ * 항목을 비우도록 stale로 표시합니다. 인터럽트가 꺼져 있어야 합니다. */
+static int pcid_get(struct cpu *c, uint64_t *pml4)
+{
+	int free_pcid = 0;
+
+	ASSERT(intr_get_level() == INTR_OFF);
+
+	if (pml4 == base_pml4)
+		return 0;
+	for (int pcid = 1; pcid < PCID_CNT; pcid++)
+	{
+		if (c->pcid_owners[pcid] == pml4)
+			return pcid;
+		if (c->pcid_owners[pcid] == NULL && free_pcid == 0)
+			free_pcid = pcid;
+	}
+	if (free_pcid == 0)
+	{
+		free_pcid = c->pcid_next + 1;
+		c->pcid_next = (c->pcid_next + 1) % (PCID_CNT - 1);
+	}
+	c->pcid_owners[free_pcid] = pml4;
+	c->pcid_stale |= 1ULL << free_pcid;
+	return free_pcid;
+}
+
+/* Marks the PCID that PML4 uses on each CPU as stale, except on
+ * CPU SKIP, which may be null.  If RELEASE is true, PML4 also
+ * gives up the PCID.  Interrupts must be off. */
+/* 각 CPU에서 PML4가 사용하는 PCID를 stale로 표시합니다. 단, 널일 수
+ * 있는 SKIP CPU는 제외합니다. RELEASE가 참이면 PML4는 그 PCID도
+ * 내놓습니다. 인터럽트가 꺼져 있어야 합니다. */
+static void pcid_mark_stale(uint64_t *pml4, struct cpu *skip, bool release)
+{
+	for (int i = 0; i < ncpu; i++)
+	{
+		struct cpu *c = &cpus[i];
+
+		if (c == skip)
+			continue;
+		for (int pcid = 0; pcid < PCID_CNT; pcid++)
+			if (c->pcid_owners[pcid] == pml4)
+			{
+				c->pcid_stale |= 1ULL << pcid;
+				if (release)
+					c->pcid_owners[pcid] = NULL;
+			}
+	}
+}
+
+/* Invalidates the TLB entries for VA in PML4 after its PTE
+ * changed.  If PML4 is active, this is one INVLPG.  Entries
+ * tagged with PML4's PCID elsewhere are flushed the next time
+ * PML4 is activated there; without PCIDs, that reload flushes
+ * them anyway. */
+/* PTE가 바뀐 뒤 PML4에서 VA에 대한 TLB 항목을 무효화합니다. PML4가
+ * 활성 상태이면 INVLPG 한 번이면 됩니다. 다른 곳에서 PML4의 PCID가
+ * 붙은 항목은 그곳에서 PML4를 다음에 활성화할 때 비워지며, PCID가 없으면
+ * 어차피 그 재적재가 항목을 비웁니다. */
+static void tlb_invalidate(uint64_t *pml4, uint64_t va)
+{
+	enum intr_level old_level = intr_disable();
+	bool active = PTE_ADDR(rcr3()) == vtop(pml4);
+
+	if (active)
+		invlpg(va);
+	if (pcid_on)
+		pcid_mark_stale(pml4, active ? this_cpu() : NULL, false);
+	intr_set_level(old_level);
+}
+
+/* Starts tagging TLB entries with PCIDs if the CPU supports
+ * them, so that pml4_activate() can switch page maps without
+ * flushing the TLB.  Must be called with the base page map
+ * active.  Returns true if PCIDs are now in use. */
+/* CPU가 지원하면 TLB 항목에 PCID를 붙이기 시작하여, pml4_activate()가
+ * TLB를 비우지 않고 페이지 맵을 전환할 수 있게 합니다. 기본 페이지 맵이
+ * 활성 상태일 때 호출해야 합니다. 이제 PCID를 사용하면 true를
+ * 반환합니다. */
+bool pml4_init_pcid(void)
+{
+	ASSERT(rcr3() == vtop(base_pml4));
+
+	if (cpuid_ecx(1) & CPUID_PCID)
+	{
+		lcr4(rcr4() | CR4_PCIDE);
+		pcid_on = true;
+	}
+	return pcid_on;
+}
+
 /* Loads page directory PD into the CPU's page directory base
- * register. */
+ * register.  Nothing is loaded if PD is already active.  With
+ * PCIDs, the switch keeps the TLB entries of other page maps, and
+ * those of PD itself unless they are stale. */
 /* 페이지 디렉터리 PD를 CPU의 페이지 디렉터리 베이스 레지스터에
- * 로드합니다. */
+ * 로드합니다. PD가 이미 활성 상태이면 아무것도 로드하지 않습니다.
+ * PCID를 쓰면 전환해도 다른 페이지 맵의 TLB 항목이 남고, PD 자신의
+ * 항목도 stale이 아니면 남습니다. */
 void pml4_activate(uint64_t *pml4)
 {
-	lcr3(vtop(pml4 ? pml4 : base_pml4));
+	uint64_t *target = pml4 ? pml4 : base_pml4;
+	uint64_t cr3 = vtop(target);
+	enum intr_level old_level = intr_disable();
+	struct cpu *c = this_cpu();
+
+	if (pcid_on)
+	{
+		int pcid = pcid_get(c, target);
+
+		cr3 |= pcid;
+		if (c->pcid_stale & (1ULL << pcid))
+		{
+			c->pcid_stale &= ~(1ULL << pcid);
+			lcr3(cr3);
+			c->pml4_switches++;
+			c->pml4_flushes++;
+		}
+		else if (rcr3() != cr3)
+		{
+			lcr3(cr3 | CR3_NOFLUSH);
+			c->pml4_switches++;
+		}
+	}
+	else if (rcr3() != cr3)
+	{
+		lcr3(cr3);
+		c->pml4_switches++;
+		c->pml4_flushes++;
+	}
+	intr_set_level(old_level);
+}
+
+/* Prints page map switch statistics. */
+/* 페이지 맵 전환 통계를 출력합니다. */
+void pml4_print_stats(void)
+{
+	for (int i = 0; i < ncpu; i++)
+		printf("CPU %d: %llu page map switches, %llu flushed the TLB%s\n",
+			   i, cpus[i].pml4_switches, cpus[i].pml4_flushes,
+			   pcid_on ? " (PCIDs on)" : "");
 }
 
 /* Looks up the physical address that corresponds to user virtual
@@ -262,6 +584,8 @@ void *pml4_get_page(uint64_t *pml4, const void *uaddr)
 
 	uint64_t *pte = pml4e_walk(pml4, (uint64_t)uaddr, 0);
 
+	if (pte && (*pte & PTE_P) && is_large_pte(pte))
+		return ptov(PTE_ADDR(*pte) & ~(LPGSIZE - 1)) + lpg_ofs(uaddr);
 	if (pte && (*pte & PTE_P))
 		return ptov(PTE_ADDR(*pte)) + pg_ofs(uaddr);
 	return NULL;
@@ -296,6 +620,81 @@ bool pml4_set_page(uint64_t *pml4, void *upage, void *kpage, bool rw)
 	return pte != NULL;
 }
 
+/* Maps the 2 MB of user virtual memory at UPAGE to the 512
+ * physically contiguous pages at kernel virtual address KPAGE
+ * with a single page directory entry.  Both UPAGE and the
+ * physical address of KPAGE must be 2 MB aligned, and KPAGE
+ * should be a block obtained from the user pool with
+ * palloc_get_multiple().  The whole range must be unmapped.
+ * Returns true if successful, false if the range is in use or
+ * memory allocation failed. */
+/* UPAGE부터 2 MB의 사용자 가상 메모리를 커널 가상 주소 KPAGE의
+ * 물리적으로 연속된 512개 페이지에 페이지 디렉터리 항목 하나로
+ * 매핑합니다. UPAGE와 KPAGE의 물리 주소는 모두 2 MB 정렬되어야 하며,
+ * KPAGE는 palloc_get_multiple()로 사용자 풀에서 가져온 블록이어야
+ * 합니다. 범위 전체가 매핑되어 있지 않아야 합니다. 성공하면 true를,
+ * 범위가 사용 중이거나 메모리 할당에 실패하면 false를 반환합니다. */
+bool pml4_set_large_page(uint64_t *pml4, void *upage, void *kpage, bool rw)
+{
+	ASSERT(lpg_ofs(upage) == 0);
+	ASSERT(lpg_ofs(vtop(kpage)) == 0);
+	ASSERT(is_user_vaddr(upage));
+	ASSERT(pml4 != base_pml4);
+
+	uint64_t *pde = pml4e_walk_pde(pml4, (uint64_t)upage, 1);
+
+	if (pde == NULL || (*pde & PTE_P))
+		return false;
+	*pde = vtop(kpage) | PTE_PS | PTE_P | (rw ? PTE_W : 0) | PTE_U;
+	return true;
+}
+
+/* If VA falls in a 2 MB page of PML4, splits it into 4 kB pages
+ * that map the same frames with the same permissions.  Returns
+ * false only if the page table for the split could not be
+ * allocated. */
+/* VA가 PML4의 2 MB 페이지에 속하면, 같은 프레임을 같은 권한으로
+ * 매핑하는 4 kB 페이지들로 분할합니다. 분할에 필요한 페이지 테이블을
+ * 할당할 수 없을 때만 false를 반환합니다. */
+bool pml4_split_page(uint64_t *pml4, const void *va)
+{
+	uint64_t *pde = pml4e_walk_pde(pml4, (uint64_t)va, 0);
+
+	if (pde == NULL || (*pde & (PTE_P | PTE_PS)) != (PTE_P | PTE_PS))
+		return true;
+	if (!split_pde(pde))
+		return false;
+	tlb_invalidate(pml4, (uint64_t)va);
+	return true;
+}
+
+/* Makes user virtual page UPAGE in PML4 writable if RW is true,
+ * read-only otherwise.  A 2 MB page around UPAGE is split first,
+ * so the rest of it keeps its permissions.  Returns false if
+ * UPAGE is not mapped or the split fails. */
+/* PML4의 사용자 가상 페이지 UPAGE를 RW가 참이면 쓰기 가능하게,
+ * 아니면 읽기 전용으로 만듭니다. UPAGE를 포함하는 2 MB 페이지는 먼저
+ * 분할되므로 나머지 부분은 권한을 유지합니다. UPAGE가 매핑되어 있지
+ * 않거나 분할에 실패하면 false를 반환합니다. */
+bool pml4_set_writable(uint64_t *pml4, const void *upage, bool rw)
+{
+	ASSERT(pg_ofs(upage) == 0);
+	ASSERT(is_user_vaddr(upage));
+
+	if (!pml4_split_page(pml4, upage))
+		return false;
+
+	uint64_t *pte = pml4e_walk(pml4, (uint64_t)upage, false);
+	if (pte == NULL || !(*pte & PTE_P))
+		return false;
+	if (rw)
+		*pte |= PTE_W;
+	else
+		*pte &= ~(uint64_t)PTE_W;
+	tlb_invalidate(pml4, (uint64_t)upage);
+	return true;
+}
+
 /* Marks user virtual page UPAGE "not present" in page
  * directory PD.  Later accesses to the page will fault.  Other
  * bits in the page table entry are preserved.
@@ -310,13 +709,18 @@ void pml4_clear_page(uint64_t *pml4, void *upage)
 	ASSERT(pg_ofs(upage) == 0);
 	ASSERT(is_user_vaddr(upage));
 
+	/* Only UPAGE goes away, so a 2 MB page around it is split
+	 * first.  There is no way to report failure here. */
+	/* UPAGE만 사라지므로, 이를 포함하는 2 MB 페이지는 먼저 분할합니다.
+	 * 여기서는 실패를 알릴 방법이 없습니다. */
+	if (!pml4_split_page(pml4, upage))
+		PANIC("out of memory splitting a large page");
 	pte = pml4e_walk(pml4, (uint64_t)upage, false);
 
 	if (pte != NULL && (*pte & PTE_P) != 0)
 	{
 		*pte &= ~PTE_P;
-		if (rcr3() == vtop(pml4))
-			invlpg((uint64_t)upage);
+		tlb_invalidate(pml4, (uint64_t)upage);
 	}
 }
 
@@ -347,8 +751,7 @@ void pml4_set_dirty(uint64_t *pml4, const void *vpage, bool dirty)
 		else
 			*pte &= ~(uint32_t)PTE_D;
 
-		if (rcr3() == vtop(pml4))
-			invlpg((uint64_t)vpage);
+		tlb_invalidate(pml4, (uint64_t)vpage);
 	}
 }
 
@@ -379,7 +782,6 @@ void pml4_set_accessed(uint64_t *pml4, const void *vpage, bool accessed)
 		else
 			*pte &= ~(uint32_t)PTE_A;
 
-		if (rcr3() == vtop(pml4))
-			invlpg((uint64_t)vpage);
+		tlb_invalidate(pml4, (uint64_t)vpage);
 	}
 }
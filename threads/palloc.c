@@ -2,14 +2,18 @@
 #include <bitmap.h>
 #include <debug.h>
 #include <inttypes.h>
+#include <list.h>
 #include <round.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include "threads/allocprof.h"
+#include "threads/cpu.h"
 #include "threads/init.h"
+#include "threads/interrupt.h"
 #include "threads/loader.h"
-#include "threads/synch.h"
+#include "threads/pte.h"
 #include "threads/vaddr.h"
 
 /* Page allocator.  Hands out memory in page-size (or
@@ -39,16 +43,98 @@
    할당됩니다. 이는 커널 풀에 비해 지나치게 많은 양이지만
    데모용으로는 괜찮습니다. */
 
+/* Within a pool, free pages are managed by a binary buddy
+   allocator.  Free memory is kept as blocks of 2**ORDER pages
+   whose index is a multiple of their size, one free list per
+   order, linked through the first page of each block.  A
+   request for N pages takes a block of the smallest order that
+   fits, splitting larger blocks as needed, and gives the unused
+   tail back right away, so a 3-page request uses 3 pages.  A
+   freed block merges with its buddy for as long as the buddy is
+   free too.  Both take O(log n) steps instead of the bitmap
+   scan's O(pool size).  The used_map bitmap still records which
+   pages are allocated, for sanity checks.
+
+   The scheduler frees dead threads' pages with interrupts off,
+   so a pool is protected by turning interrupts off rather than
+   by a lock.  Each operation is short. */
+/* 풀 안의 가용 페이지는 이진 버디 할당자가 관리합니다. 가용 메모리는
+   인덱스가 자기 크기의 배수인 2**ORDER 페이지 블록으로 유지되며,
+   order마다 가용 리스트가 하나씩 있고 각 블록의 첫 페이지로
+   연결됩니다. N 페이지 요청은 맞는 가장 작은 order의 블록을 가져오며,
+   필요하면 더 큰 블록을 쪼개고, 쓰지 않는 뒷부분은 바로 돌려주므로
+   3 페이지 요청은 3 페이지만 씁니다. 해제된 블록은 버디도 비어 있는
+   동안 계속 버디와 합쳐집니다. 둘 다 비트맵 탐색의 O(풀 크기) 대신
+   O(log n) 단계가 걸립니다. used_map 비트맵은 검사를 위해 여전히
+   어떤 페이지가 할당되었는지 기록합니다.
+
+   스케줄러가 인터럽트가 꺼진 상태에서 죽은 스레드의 페이지를
+   해제하므로, 풀은 락 대신 인터럽트를 꺼서 보호합니다. 각 연산은
+   짧습니다. */
+
+/* Single pages, by far the most common request, go through a
+   per-CPU magazine for each pool (see struct page_mag in cpu.h).
+   palloc_get_page() pops a page from the running CPU's magazine
+   and palloc_free_page() pushes it back, without touching the
+   pool.  An empty magazine is refilled with PAGE_MAG_BATCH pages
+   from the pool at once; a full one gives its PAGE_MAG_BATCH
+   coldest pages back.  Pages in a magazine stay marked used in
+   the pool, and are flushed back to it whenever the pool alone
+   cannot satisfy a request. */
+/* 가장 흔한 요청인 단일 페이지는 풀마다 있는 CPU별 매거진을 거칩니다
+   (cpu.h의 struct page_mag 참고). palloc_get_page()는 실행 중인 CPU의
+   매거진에서 페이지를 꺼내고 palloc_free_page()는 다시 넣으며, 풀은
+   건드리지 않습니다. 빈 매거진은 풀에서 PAGE_MAG_BATCH 페이지를 한
+   번에 채우고, 가득 찬 매거진은 가장 오래된 PAGE_MAG_BATCH 페이지를
+   돌려줍니다. 매거진의 페이지는 풀에서 사용 중으로 표시된 채로 있고,
+   풀만으로 요청을 처리할 수 없을 때마다 풀로 비워집니다. */
+
+/* PAL_ZERO requests for a single page are served first from a
+   small stock of pages per pool that are already known to be
+   zero.  The idle thread fills the stock by calling
+   palloc_zero_idle() whenever nothing else is ready to run, so
+   the memset happens off the caller's critical path.  Like a
+   magazine's pages, stocked pages stay marked used in the pool
+   and are reclaimed when the pool runs short. */
+/* 단일 페이지에 대한 PAL_ZERO 요청은 먼저 풀마다 0으로 채워진 것이
+   확실한 작은 페이지 재고에서 처리됩니다. 유휴 스레드는 실행할 다른
+   스레드가 없을 때마다 palloc_zero_idle()을 호출해 재고를 채우므로,
+   memset은 호출자의 중요 경로 밖에서 일어납니다. 매거진의 페이지처럼
+   재고 페이지도 풀에서 사용 중으로 표시된 채로 있고, 풀이 부족해지면
+   회수됩니다. */
+
+#define BUDDY_ORDERS 16	 /* Orders 0...15, blocks of up to 128 MB. */
+						 /* order 0...15, 최대 128 MB 블록. */
+#define BUDDY_FREE 0x80 /* In orders[], marks the head of a free block. */
+						/* orders[]에서 가용 블록의 첫 페이지를 표시. */
+#define ZEROED_MAX 64	/* Most pre-zeroed pages kept per pool. */
+						/* 풀마다 보관하는 미리 0으로 채운 최대 페이지 수. */
+
 /* A memory pool. */
 /* 메모리 풀입니다. */
 struct pool
 {
-	struct lock lock;		 /* Mutual exclusion. */
-							 /* 상호 배제. */
 	struct bitmap *used_map; /* Bitmap of free pages. */
 							 /* 가용 페이지의 비트맵. */
 	uint8_t *base;			 /* Base of pool. */
 							 /* pool의 최하단. */
+	uint8_t *orders;		 /* Per page: BUDDY_FREE | order at the head
+								of a free block, otherwise 0. */
+							 /* 페이지별: 가용 블록의 첫 페이지면
+								BUDDY_FREE | order, 아니면 0. */
+	struct list free_lists[BUDDY_ORDERS]; /* Free blocks by order. */
+										  /* order별 가용 블록. */
+	size_t free_cnt;					  /* Number of free pages. */
+										  /* 가용 페이지 수. */
+
+	void *zeroed[ZEROED_MAX]; /* Pages known to be zero. */
+							  /* 0인 것이 확실한 페이지. */
+	int zeroed_cnt;			  /* Entries in zeroed. */
+							  /* zeroed의 항목 수. */
+	uint64_t zero_requests;	  /* PAL_ZERO requests. */
+							  /* PAL_ZERO 요청 수. */
+	uint64_t zero_hits;		  /* ...served from zeroed. */
+							  /* ...중 zeroed에서 처리한 수. */
 };
 
 /* Two pools: one for kernel data, one for user pages. */
@@ -61,6 +147,16 @@ size_t user_page_limit = SIZE_MAX;
 
 static void init_pool(struct pool *p, void **bm_base, uint64_t start, uint64_t end);
 static bool page_from_pool(const struct pool *, void *page);
+static size_t buddy_alloc(struct pool *, size_t page_cnt);
+static void buddy_free(struct pool *, size_t page_idx, size_t page_cnt);
+static void *get_pages(enum palloc_flags, size_t page_cnt);
+static void *pool_get(struct pool *, size_t page_cnt);
+static void pool_put(struct pool *, void *pages, size_t page_cnt);
+static struct page_mag *pool_mag(const struct pool *, int cpu);
+static void *mag_get(struct pool *);
+static void mag_put(struct pool *, void *page);
+static bool pool_reclaim(struct pool *);
+static void print_pool_stats(const char *name, struct pool *);
 
 /* multiboot info */
 /* 멀티 부팅 정보 */
@@ -208,6 +304,16 @@ static void populate_pools(struct area *base_mem, struct area *ext_mem)
 					rem -= size_in_pg;
 					break;
 				}
+				// Start the user pool on a 2 MB boundary when the region
+				// allows it, so that its 512-page buddy blocks are
+				// physically aligned and can back large pages.
+				// 영역이 허락하면 사용자 풀을 2 MB 경계에서 시작하여,
+				// 512페이지 버디 블록이 물리적으로 정렬되어 대형 페이지로
+				// 쓰일 수 있게 합니다.
+				if (rem < size_in_pg &&
+					ROUND_UP(start + rem * PGSIZE, LPGSIZE) < end)
+					rem = (ROUND_UP(start + rem * PGSIZE, LPGSIZE) - start) / PGSIZE;
+
 				// generate kernel pool
 				// 커널 풀 생성
 				init_pool(&kernel_pool,
@@ -288,6 +394,7 @@ static void populate_pools(struct area *base_mem, struct area *ext_mem)
 			{
 				page_cnt = ((uint64_t)pool_end - start) / PGSIZE;
 				bitmap_set_multiple(pool->used_map, page_idx, page_cnt, false);
+				buddy_free(pool, page_idx, page_cnt);
 				start = (uint64_t)pool_end;
 				goto split;
 			}
@@ -295,6 +402,7 @@ static void populate_pools(struct area *base_mem, struct area *ext_mem)
 			{
 				page_cnt = ((uint64_t)end - start) / PGSIZE;
 				bitmap_set_multiple(pool->used_map, page_idx, page_cnt, false);
+				buddy_free(pool, page_idx, page_cnt);
 			}
 		}
 	}
@@ -319,6 +427,7 @@ uint64_t palloc_init(void)
 	printf("\text_mem: 0x%llx ~ 0x%llx (Usable: %'llu kB)\n",
 		   ext_mem.start, ext_mem.end, ext_mem.size / 1024);
 	populate_pools(&base_mem, &ext_mem);
+	palloc_print_stats();
 	return ext_mem.end;
 }
 
@@ -335,18 +444,51 @@ uint64_t palloc_init(void)
    널 포인터를 반환하지만, PAL_ASSERT가 FLAGS에 설정되어 있지 않으면
    커널이 패닉에 빠집니다. */
 void *palloc_get_multiple(enum palloc_flags flags, size_t page_cnt)
+{
+	void *pages = get_pages(flags, page_cnt);
+
+	if (allocprof_on)
+		allocprof_record(ALLOCPROF_PALLOC, pages, page_cnt * PGSIZE,
+						 __builtin_return_address(0));
+	return pages;
+}
+
+/* Does the work of palloc_get_multiple(), leaving the allocation
+   profiler to its caller, which knows the call site. */
+/* palloc_get_multiple()의 일을 하되, 할당 프로파일러는 호출 지점을
+   아는 호출자에게 맡깁니다. */
+static void *get_pages(enum palloc_flags flags, size_t page_cnt)
 {
 	struct pool *pool = flags & PAL_USER ? &user_pool : &kernel_pool;
+	void *pages;
 
-	lock_acquire(&pool->lock);
-	size_t page_idx = bitmap_scan_and_flip(pool->used_map, 0, page_cnt, false);
-	lock_release(&pool->lock);
+	bool zeroed = false;
 
-	void *pages = page_idx != BITMAP_ERROR ? pool->base + PGSIZE * page_idx : NULL;
+	enum intr_level old_level = intr_disable();
+	if (flags & PAL_ZERO)
+	{
+		pool->zero_requests++;
+		if (page_cnt == 1 && pool->zeroed_cnt > 0)
+		{
+			pool->zero_hits++;
+			zeroed = true;
+		}
+	}
+	if (zeroed)
+		pages = pool->zeroed[--pool->zeroed_cnt];
+	else if (page_cnt == 1)
+		pages = mag_get(pool);
+	else
+	{
+		pages = pool_get(pool, page_cnt);
+		if (pages == NULL && pool_reclaim(pool))
+			pages = pool_get(pool, page_cnt);
+	}
+	intr_set_level(old_level);
 
 	if (pages)
 	{
-		if (flags & PAL_ZERO)
+		if ((flags & PAL_ZERO) && !zeroed)
 		{
 			memset(pages, 0, PGSIZE * page_cnt);
 		}
@@ -376,7 +518,12 @@ void *palloc_get_multiple(enum palloc_flags flags, size_t page_cnt)
    PAL_ASSERT가 FLAGS에 설정되어 있지 않으면 커널이 패닉에 빠집니다. */
 void *palloc_get_page(enum palloc_flags flags)
 {
-	return palloc_get_multiple(flags, 1);
+	void *page = get_pages(flags, 1);
+
+	if (allocprof_on)
+		allocprof_record(ALLOCPROF_PALLOC, page, PGSIZE,
+						 __builtin_return_address(0));
+	return page;
 }
 
 /* Frees the PAGE_CNT pages starting at PAGES. */
@@ -389,6 +536,9 @@ void palloc_free_multiple(void *pages, size_t page_cnt)
 	if (pages == NULL || page_cnt == 0)
 		return;
 
+	if (allocprof_on)
+		allocprof_forget(ALLOCPROF_PALLOC, pages);
+
 	if (page_from_pool(&kernel_pool, pages))
 		pool = &kernel_pool;
 	else if (page_from_pool(&user_pool, pages))
@@ -396,13 +546,15 @@ void palloc_free_multiple(void *pages, size_t page_cnt)
 	else
 		NOT_REACHED();
 
-	size_t page_idx = pg_no(pages) - pg_no(pool->base);
-
 #ifndef NDEBUG
 	memset(pages, 0xcc, PGSIZE * page_cnt);
 #endif
-	ASSERT(bitmap_all(pool->used_map, page_idx, page_cnt));
-	bitmap_set_multiple(pool->used_map, page_idx, page_cnt, false);
+	enum intr_level old_level = intr_disable();
+	if (page_cnt == 1)
+		mag_put(pool, pages);
+	else
+		pool_put(pool, pages, page_cnt);
+	intr_set_level(old_level);
 }
 
 /* Frees the page at PAGE. */
@@ -412,6 +564,29 @@ void palloc_free_page(void *page)
 	palloc_free_multiple(page, 1);
 }
 
+/* Stores the first page of the kernel pool in *BASE and returns
+   the number of pages the pool spans. */
+/* 커널 풀의 첫 페이지를 *BASE에 저장하고 풀이 걸쳐 있는 페이지 수를
+   반환합니다. */
+size_t palloc_kernel_pool(void **base)
+{
+	*base = kernel_pool.base;
+	return bitmap_size(kernel_pool.used_map);
+}
+
+/* Stores the number of pages the user pool spans in *TOTAL and
+   returns how many of them are free.  Pages held in magazines
+   count as in use.  The answer may be stale by the time the
+   caller looks at it. */
+/* 사용자 풀이 걸쳐 있는 페이지 수를 *TOTAL에 저장하고 그중 가용
+   페이지 수를 반환합니다. 매거진에 있는 페이지는 사용 중으로 셉니다.
+   호출자가 볼 때쯤에는 이미 낡은 값일 수 있습니다. */
+size_t palloc_user_free_cnt(size_t *total)
+{
+	*total = bitmap_size(user_pool.used_map);
+	return user_pool.free_cnt;
+}
+
 /* Initializes pool P as starting at START and ending at END */
 /* pool P를 START에서 시작하여 END에서 끝나는 것으로 초기화합니다. */
 static void init_pool(struct pool *p, void **bm_base, uint64_t start, uint64_t end)
@@ -423,8 +598,8 @@ static void init_pool(struct pool *p, void **bm_base, uint64_t start, uint64_t e
 	   비트맵에 필요한 공간을 계산하여 pool의 크기에서 뺍니다. */
 	uint64_t pgcnt = (end - start) / PGSIZE;
 	size_t bm_pages = DIV_ROUND_UP(bitmap_buf_size(pgcnt), PGSIZE) * PGSIZE;
+	size_t order_pages = DIV_ROUND_UP(pgcnt, PGSIZE) * PGSIZE;
 
-	lock_init(&p->lock);
 	p->used_map = bitmap_create_in_buf(pgcnt, *bm_base, bm_pages);
 	p->base = (void *)start;
 
@@ -432,7 +607,19 @@ static void init_pool(struct pool *p, void **bm_base, uint64_t start, uint64_t e
 	// 모두 사용 불가능으로 표시합니다.
 	bitmap_set_all(p->used_map, true);
 
-	*bm_base += bm_pages;
+	/* The buddy order map follows the bitmap.  No page is free
+	   until populate_pools() hands the usable ranges over. */
+	/* 버디 order 맵은 비트맵 뒤에 둡니다. populate_pools()가 사용
+	   가능한 범위를 넘겨주기 전까지는 가용 페이지가 없습니다. */
+	p->orders = (uint8_t *)*bm_base + bm_pages;
+	memset(p->orders, 0, pgcnt);
+	for (int order = 0; order < BUDDY_ORDERS; order++)
+		list_init(&p->free_lists[order]);
+	p->free_cnt = 0;
+	p->zeroed_cnt = 0;
+	p->zero_requests = p->zero_hits = 0;
+
+	*bm_base += bm_pages + order_pages;
 }
 
 /* Returns true if PAGE was allocated from POOL,
@@ -446,3 +633,307 @@ static bool page_from_pool(const struct pool *pool, void *page)
 	size_t end_page = start_page + bitmap_size(pool->used_map);
 	return page_no >= start_page && page_no < end_page;
 }
+
+/* Returns the free list element stored in page PAGE_IDX of P. */
+/* P의 PAGE_IDX 페이지에 저장된 가용 리스트 요소를 반환합니다. */
+static struct list_elem *block_elem(const struct pool *p, size_t page_idx)
+{
+	return (struct list_elem *)(p->base + page_idx * PGSIZE);
+}
+
+/* Adds the free block of 2**ORDER pages at PAGE_IDX to P, first
+   merging it with its buddy for as long as the buddy is a free
+   block of the same order. */
+/* PAGE_IDX에 있는 2**ORDER 페이지 가용 블록을 P에 추가합니다. 먼저
+   버디가 같은 order의 가용 블록인 동안 계속 버디와 합칩니다. */
+static void buddy_insert(struct pool *p, size_t page_idx, int order)
+{
+	size_t pgcnt = bitmap_size(p->used_map);
+
+	while (order < BUDDY_ORDERS - 1)
+	{
+		size_t buddy = page_idx ^ ((size_t)1 << order);
+		if (buddy + ((size_t)1 << order) > pgcnt || p->orders[buddy] != (BUDDY_FREE | order))
+			break;
+
+		list_remove(block_elem(p, buddy));
+		p->orders[buddy] = 0;
+		page_idx &= ~((size_t)1 << order);
+		order++;
+	}
+
+	p->orders[page_idx] = BUDDY_FREE | order;
+	list_push_front(&p->free_lists[order], block_elem(p, page_idx));
+}
+
+/* Frees the PAGE_CNT pages at PAGE_IDX in P, as the fewest
+   aligned power-of-two blocks that cover them. */
+/* P의 PAGE_IDX부터 PAGE_CNT 페이지를, 이를 덮는 가장 적은 수의
+   정렬된 2의 거듭제곱 블록으로 해제합니다. */
+static void buddy_free(struct pool *p, size_t page_idx, size_t page_cnt)
+{
+	p->free_cnt += page_cnt;
+	while (page_cnt > 0)
+	{
+		int order = 63 - __builtin_clzll(page_cnt);
+		if (page_idx != 0 && __builtin_ctzll(page_idx) < order)
+			order = __builtin_ctzll(page_idx);
+		if (order > BUDDY_ORDERS - 1)
+			order = BUDDY_ORDERS - 1;
+
+		buddy_insert(p, page_idx, order);
+		page_idx += (size_t)1 << order;
+		page_cnt -= (size_t)1 << order;
+	}
+}
+
+/* Allocates PAGE_CNT contiguous pages from P and returns the
+   index of the first, or BITMAP_ERROR if no free block is large
+   enough. */
+/* P에서 연속된 PAGE_CNT 페이지를 할당하고 첫 페이지의 인덱스를
+   반환합니다. 충분히 큰 가용 블록이 없으면 BITMAP_ERROR를
+   반환합니다. */
+static size_t buddy_alloc(struct pool *p, size_t page_cnt)
+{
+	if (page_cnt == 0)
+		return BITMAP_ERROR;
+
+	int want = page_cnt == 1 ? 0 : 64 - __builtin_clzll(page_cnt - 1);
+	int order = want;
+	while (order < BUDDY_ORDERS && list_empty(&p->free_lists[order]))
+		order++;
+	if (order >= BUDDY_ORDERS)
+		return BITMAP_ERROR;
+
+	struct list_elem *e = list_pop_front(&p->free_lists[order]);
+	size_t page_idx = ((uint8_t *)e - p->base) / PGSIZE;
+	p->orders[page_idx] = 0;
+
+	/* Split off upper halves until the block is just large
+	   enough; their buddies are in use, so they cannot merge. */
+	/* 블록이 딱 맞을 때까지 위쪽 절반을 떼어냅니다. 그 버디는 사용
+	   중이므로 합쳐지지 않습니다. */
+	while (order > want)
+	{
+		order--;
+		size_t upper = page_idx + ((size_t)1 << order);
+		p->orders[upper] = BUDDY_FREE | order;
+		list_push_front(&p->free_lists[order], block_elem(p, upper));
+	}
+	p->free_cnt -= (size_t)1 << want;
+
+	/* Give back the tail the request does not need. */
+	/* 요청에 필요 없는 뒷부분을 돌려줍니다. */
+	if (page_cnt < (size_t)1 << want)
+		buddy_free(p, page_idx + page_cnt, ((size_t)1 << want) - page_cnt);
+
+	return page_idx;
+}
+
+/* Takes PAGE_CNT contiguous pages from P itself and returns
+   them, or a null pointer if P has no free block large enough.
+   Interrupts must be off. */
+/* P 자체에서 연속된 PAGE_CNT 페이지를 가져와 반환하며, 충분히 큰 가용
+   블록이 없으면 널 포인터를 반환합니다. 인터럽트가 꺼져 있어야
+   합니다. */
+static void *pool_get(struct pool *p, size_t page_cnt)
+{
+	size_t page_idx = buddy_alloc(p, page_cnt);
+	if (page_idx == BITMAP_ERROR)
+		return NULL;
+
+	ASSERT(bitmap_none(p->used_map, page_idx, page_cnt));
+	bitmap_set_multiple(p->used_map, page_idx, page_cnt, true);
+	return p->base + PGSIZE * page_idx;
+}
+
+/* Gives the PAGE_CNT pages at PAGES back to P itself.
+   Interrupts must be off. */
+/* PAGES부터 PAGE_CNT 페이지를 P 자체에 돌려줍니다. 인터럽트가 꺼져
+   있어야 합니다. */
+static void pool_put(struct pool *p, void *pages, size_t page_cnt)
+{
+	size_t page_idx = pg_no(pages) - pg_no(p->base);
+
+	ASSERT(bitmap_all(p->used_map, page_idx, page_cnt));
+	bitmap_set_multiple(p->used_map, page_idx, page_cnt, false);
+	buddy_free(p, page_idx, page_cnt);
+}
+
+/* Returns CPU's magazine for pool P. */
+/* P 풀에 대한 CPU의 매거진을 반환합니다. */
+static struct page_mag *pool_mag(const struct pool *p, int cpu)
+{
+	return &cpus[cpu].page_mags[p == &user_pool ? PAGE_MAG_USER : PAGE_MAG_KERNEL];
+}
+
+/* Moves the CNT coldest pages of MAG back to P. */
+/* MAG에서 가장 오래된 CNT 페이지를 P로 되돌립니다. */
+static void mag_drain(struct pool *p, struct page_mag *mag, int cnt)
+{
+	ASSERT(cnt <= mag->cnt);
+
+	for (int i = 0; i < cnt; i++)
+		pool_put(p, mag->pages[i], 1);
+	mag->cnt -= cnt;
+	memmove(mag->pages, mag->pages + cnt, mag->cnt * sizeof *mag->pages);
+	mag->drains++;
+}
+
+/* Returns a free page of P from the running CPU's magazine,
+   refilling it from P if it is empty, or a null pointer if P is
+   out of pages.  Interrupts must be off. */
+/* 실행 중인 CPU의 매거진에서 P의 가용 페이지를 반환합니다. 매거진이
+   비어 있으면 P에서 채우고, P에 페이지가 없으면 널 포인터를
+   반환합니다. 인터럽트가 꺼져 있어야 합니다. */
+static void *mag_get(struct pool *p)
+{
+	struct page_mag *mag = pool_mag(p, this_cpu()->id);
+
+	if (mag->cnt > 0)
+	{
+		mag->hits++;
+		return mag->pages[--mag->cnt];
+	}
+
+	mag->misses++;
+	while (mag->cnt < PAGE_MAG_BATCH)
+	{
+		void *page = pool_get(p, 1);
+		if (page == NULL)
+			break;
+		mag->pages[mag->cnt++] = page;
+	}
+	if (mag->cnt > 0)
+	{
+		mag->refills++;
+		return mag->pages[--mag->cnt];
+	}
+
+	/* Other CPUs may be holding the last free pages. */
+	/* 다른 CPU가 마지막 가용 페이지를 가지고 있을 수 있습니다. */
+	return pool_reclaim(p) ? pool_get(p, 1) : NULL;
+}
+
+/* Pushes PAGE, a page of P, onto the running CPU's magazine,
+   first draining it if it is full.  Interrupts must be off. */
+/* P의 페이지인 PAGE를 실행 중인 CPU의 매거진에 넣습니다. 매거진이
+   가득 차 있으면 먼저 비웁니다. 인터럽트가 꺼져 있어야 합니다. */
+static void mag_put(struct pool *p, void *page)
+{
+	struct page_mag *mag = pool_mag(p, this_cpu()->id);
+
+	ASSERT(bitmap_test(p->used_map, pg_no(page) - pg_no(p->base)));
+	if (mag->cnt == PAGE_MAG_SIZE)
+		mag_drain(p, mag, PAGE_MAG_BATCH);
+	mag->pages[mag->cnt++] = page;
+}
+
+/* Empties every CPU's magazine for P, and P's stock of zeroed
+   pages, back into P, so that their pages can merge into larger
+   blocks.  Returns true if any page was returned.  Interrupts
+   must be off. */
+/* 모든 CPU의 P용 매거진과 P의 0으로 채운 페이지 재고를 P로 비워, 그
+   페이지들이 더 큰 블록으로 합쳐질 수 있게 합니다. 페이지를 하나라도
+   돌려주었으면 true를 반환합니다. 인터럽트가 꺼져 있어야 합니다. */
+static bool pool_reclaim(struct pool *p)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < ncpu; i++)
+	{
+		struct page_mag *mag = pool_mag(p, i);
+		if (mag->cnt > 0)
+		{
+			mag_drain(p, mag, mag->cnt);
+			flushed = true;
+		}
+	}
+	while (p->zeroed_cnt > 0)
+	{
+		pool_put(p, p->zeroed[--p->zeroed_cnt], 1);
+		flushed = true;
+	}
+	return flushed;
+}
+
+/* Zeroes one free page and adds it to the stock of the pool
+   that has fewer zeroed pages.  Returns false if both stocks
+   are full or the pool is out of pages, true otherwise.  Called
+   by the idle thread; the memset runs at the caller's interrupt
+   level. */
+/* 가용 페이지 하나를 0으로 채워 0으로 채운 페이지가 더 적은 풀의
+   재고에 더합니다. 두 재고가 모두 가득 찼거나 풀에 페이지가 없으면
+   false를, 그렇지 않으면 true를 반환합니다. 유휴 스레드가 호출하며,
+   memset은 호출자의 인터럽트 수준에서 실행됩니다. */
+bool palloc_zero_idle(void)
+{
+	struct pool *p = kernel_pool.zeroed_cnt <= user_pool.zeroed_cnt ? &kernel_pool : &user_pool;
+	void *page = NULL;
+
+	enum intr_level old_level = intr_disable();
+	if (p->zeroed_cnt < ZEROED_MAX)
+		page = pool_get(p, 1);
+	intr_set_level(old_level);
+	if (page == NULL)
+		return false;
+
+	memset(page, 0, PGSIZE);
+
+	old_level = intr_disable();
+	if (p->zeroed_cnt < ZEROED_MAX)
+		p->zeroed[p->zeroed_cnt++] = page;
+	else
+		pool_put(p, page, 1);
+	intr_set_level(old_level);
+	return true;
+}
+
+/* Prints the free pages of pool P, called NAME, and how they are
+   fragmented: the largest free block, and the number of free
+   blocks of each order.  Then prints each CPU's magazine for P
+   and P's PAL_ZERO statistics. */
+/* NAME이라는 풀 P의 가용 페이지와 그 단편화 정도, 즉 가장 큰 가용
+   블록과 order별 가용 블록 수를 출력합니다. 이어서 P에 대한 각 CPU의
+   매거진과 PAL_ZERO 통계를 출력합니다. */
+static void print_pool_stats(const char *name, struct pool *p)
+{
+	size_t largest = 0;
+	int order;
+
+	for (order = BUDDY_ORDERS - 1; order >= 0; order--)
+		if (!list_empty(&p->free_lists[order]))
+		{
+			largest = (size_t)1 << order;
+			break;
+		}
+
+	printf("%s pool: %zu of %zu pages free, largest free block %zu pages (%zu%% fragmented)\n",
+		   name, p->free_cnt, bitmap_size(p->used_map), largest,
+		   p->free_cnt != 0 ? 100 - largest * 100 / p->free_cnt : 0);
+	printf("  free blocks by order:");
+	for (order = 0; order < BUDDY_ORDERS; order++)
+		printf(" %zu", list_size(&p->free_lists[order]));
+	printf("\n");
+
+	for (int i = 0; i < ncpu; i++)
+	{
+		struct page_mag *mag = pool_mag(p, i);
+		printf("  cpu %d magazine: %d pages, %llu hits, %llu misses, "
+			   "%llu refills, %llu drains\n",
+			   i, mag->cnt, mag->hits, mag->misses, mag->refills, mag->drains);
+	}
+	printf("  PAL_ZERO: %llu of %llu requests served pre-zeroed (%llu%%), "
+		   "%d zeroed pages ready\n",
+		   p->zero_hits, p->zero_requests,
+		   p->zero_requests != 0 ? p->zero_hits * 100 / p->zero_requests : 0,
+		   p->zeroed_cnt);
+}
+
+/* Prints the fragmentation of both pools. */
+/* 두 풀의 단편화 정도를 출력합니다. */
+void palloc_print_stats(void)
+{
+	print_pool_stats("Kernel", &kernel_pool);
+	print_pool_stats("User", &user_pool);
+}
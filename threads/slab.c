@@ -0,0 +1,408 @@
+#include "threads/slab.h"
+#include <debug.h>
+#include <list.h>
+#include <round.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "threads/cpu.h"
+#include "threads/interrupt.h"
+#include "threads/malloc.h"
+#include "threads/palloc.h"
+#include "threads/vaddr.h"
+
+/* Slab allocator.
+
+   Each cache owns a set of slabs.  A slab is one page: a struct
+   slab header, then as many objects of the cache's stride as
+   fit.  Free objects in a slab are chained through a pointer
+   stored inside each object, at LINK_OFS.  Slabs with some free
+   objects are on the cache's partial list, slabs with none on
+   its full list, and at most one slab with every object free is
+   kept on its empty list; further empty slabs go back to the page
+   allocator.
+
+   In front of the slabs, each CPU has a stack of up to
+   KMEM_CPU_MAX free objects.  An allocation pops from it and a
+   free pushes onto it; objects move between the stack and the
+   slabs KMEM_CPU_BATCH at a time.
+
+   Like the page allocator, a cache is protected by turning
+   interrupts off, which also keeps the running thread on its
+   CPU while it touches the per-CPU stack. */
+/* 슬랩 할당자.
+
+   각 캐시는 슬랩 집합을 가집니다. 슬랩은 한 페이지로, struct slab
+   헤더 뒤에 캐시의 stride 크기 객체를 들어가는 만큼 둡니다. 슬랩의
+   가용 객체는 각 객체 안 LINK_OFS 위치에 저장한 포인터로 연결됩니다.
+   가용 객체가 일부 있는 슬랩은 캐시의 partial 리스트에, 없는 슬랩은
+   full 리스트에 있고, 모든 객체가 가용인 슬랩은 empty 리스트에 최대
+   하나만 두며 나머지는 페이지 할당자로 돌려줍니다.
+
+   슬랩 앞에는 CPU마다 최대 KMEM_CPU_MAX 개의 가용 객체 스택이
+   있습니다. 할당은 여기서 꺼내고 해제는 여기에 넣으며, 객체는
+   KMEM_CPU_BATCH 개씩 스택과 슬랩 사이를 오갑니다.
+
+   페이지 할당자처럼 캐시는 인터럽트를 꺼서 보호하며, 이는 실행 중인
+   스레드가 CPU별 스택을 건드리는 동안 그 CPU에 머물게도 합니다. */
+
+#define KMEM_CPU_MAX 16	  /* Most free objects per CPU stack. */
+						  /* CPU 스택당 최대 가용 객체 수. */
+#define KMEM_CPU_BATCH 8  /* Objects moved to or from slabs at once. */
+						  /* 슬랩과 한 번에 주고받는 객체 수. */
+#define KMEM_NAME_MAX 15  /* Longest cache name. */
+						  /* 가장 긴 캐시 이름. */
+
+/* Magic number for detecting slab corruption. */
+/* 슬랩 손상을 감지하기 위한 매직 넘버. */
+#define SLAB_MAGIC 0x5ab1ab5e
+
+/* A slab, at the start of its page. */
+/* 페이지 시작에 놓이는 슬랩. */
+struct slab
+{
+	unsigned magic;			  /* Always SLAB_MAGIC. */
+							  /* 항상 SLAB_MAGIC. */
+	struct kmem_cache *cache; /* Owning cache. */
+							  /* 소유 캐시. */
+	struct list_elem elem;	  /* partial, full or empty list element. */
+							  /* partial, full, empty 리스트 요소. */
+	void *free;				  /* First free object. */
+							  /* 첫 가용 객체. */
+	size_t inuse;			  /* Objects not free in this slab. */
+							  /* 이 슬랩에서 가용이 아닌 객체 수. */
+};
+
+/* A CPU's stack of free objects. */
+/* CPU의 가용 객체 스택. */
+struct kmem_cpu
+{
+	void *objs[KMEM_CPU_MAX]; /* Free objects, hottest last. */
+							  /* 가용 객체, 마지막이 가장 최근. */
+	int cnt;				  /* Entries in objs. */
+							  /* objs의 항목 수. */
+};
+
+/* An object cache. */
+/* 객체 캐시. */
+struct kmem_cache
+{
+	char name[KMEM_NAME_MAX + 1]; /* Name, for statistics. */
+								  /* 통계용 이름. */
+	size_t size;				  /* Object size requested. */
+								  /* 요청된 객체 크기. */
+	size_t stride;				  /* Bytes between objects. */
+								  /* 객체 사이 바이트 수. */
+	size_t link_ofs;			  /* Free link's offset in an object. */
+								  /* 객체 안 가용 링크의 오프셋. */
+	size_t first_ofs;			  /* First object's offset in a slab. */
+								  /* 슬랩 안 첫 객체의 오프셋. */
+	size_t objs_per_slab;		  /* Objects in one slab. */
+								  /* 슬랩 하나의 객체 수. */
+	void (*ctor)(void *);		  /* Constructor, or null. */
+								  /* 생성자 또는 널. */
+
+	struct list partial; /* Slabs with some objects free. */
+						 /* 일부 객체가 가용인 슬랩. */
+	struct list full;	 /* Slabs with no object free. */
+						 /* 가용 객체가 없는 슬랩. */
+	struct list empty;	 /* Slabs with every object free. */
+						 /* 모든 객체가 가용인 슬랩. */
+	size_t slab_cnt;	 /* Slabs on any list. */
+						 /* 리스트에 있는 슬랩 수. */
+
+	uint64_t allocs;   /* kmem_cache_alloc() calls that succeeded. */
+					   /* 성공한 kmem_cache_alloc() 호출 수. */
+	uint64_t frees;	   /* kmem_cache_free() calls. */
+					   /* kmem_cache_free() 호출 수. */
+	uint64_t cpu_hits; /* Allocations served by a CPU stack. */
+					   /* CPU 스택에서 처리한 할당 수. */
+
+	struct list_elem elem;			/* cache_list element. */
+									/* cache_list 요소. */
+	struct kmem_cpu cpus[NCPU_MAX]; /* Per-CPU free objects. */
+									/* CPU별 가용 객체. */
+};
+
+/* Every cache, for kmem_cache_print_stats(). */
+/* kmem_cache_print_stats()를 위한 모든 캐시. */
+static struct list cache_list;
+
+static struct slab *obj_to_slab(const struct kmem_cache *, void *);
+static void **obj_link(const struct kmem_cache *, void *);
+static bool slab_grow(struct kmem_cache *);
+static void *slab_take(struct kmem_cache *, struct slab *);
+static void slab_put(struct kmem_cache *, void *);
+
+/* Initializes the slab allocator. */
+/* 슬랩 할당자를 초기화합니다. */
+void kmem_cache_init(void)
+{
+	list_init(&cache_list);
+}
+
+/* Creates and returns a cache of objects of SIZE bytes, aligned
+   on ALIGN bytes (a power of 2, or 0 for pointer alignment).  If
+   CTOR is non-null, it is called on every object, with interrupts
+   off, when its slab is created.  NAME is used only in
+   statistics.  Returns a null pointer if memory is not
+   available. */
+/* SIZE 바이트이며 ALIGN 바이트(2의 거듭제곱, 포인터 정렬이면 0)로
+   정렬된 객체의 캐시를 만들어 반환합니다. CTOR가 널이 아니면 슬랩을
+   만들 때 인터럽트가 꺼진 상태로 모든 객체에 대해 호출됩니다. NAME은
+   통계에만 쓰입니다. 메모리를 사용할 수 없으면 널 포인터를 반환합니다. */
+struct kmem_cache *kmem_cache_create(const char *name, size_t size,
+									 size_t align, void (*ctor)(void *))
+{
+	struct kmem_cache *c;
+
+	if (align == 0)
+		align = sizeof(void *);
+	ASSERT(size > 0);
+	ASSERT((align & (align - 1)) == 0);
+
+	c = calloc(1, sizeof *c);
+	if (c == NULL)
+		return NULL;
+
+	strlcpy(c->name, name, sizeof c->name);
+	c->size = size;
+	c->ctor = ctor;
+
+	/* Without a constructor the free link may overwrite the
+	   object's first bytes; with one it goes after the object,
+	   so that a free object keeps its constructed state. */
+	/* 생성자가 없으면 가용 링크가 객체의 앞부분을 덮어써도 되지만,
+	   있으면 가용 객체가 생성된 상태를 유지하도록 객체 뒤에 둡니다. */
+	c->link_ofs = ctor != NULL ? ROUND_UP(size, sizeof(void *)) : 0;
+	c->stride = c->link_ofs + sizeof(void *);
+	if (c->stride < size)
+		c->stride = size;
+	c->stride = ROUND_UP(c->stride, align);
+	c->first_ofs = ROUND_UP(sizeof(struct slab), align);
+	ASSERT(c->first_ofs + c->stride <= PGSIZE);
+	c->objs_per_slab = (PGSIZE - c->first_ofs) / c->stride;
+
+	list_init(&c->partial);
+	list_init(&c->full);
+	list_init(&c->empty);
+
+	enum intr_level old_level = intr_disable();
+	list_push_back(&cache_list, &c->elem);
+	intr_set_level(old_level);
+	return c;
+}
+
+/* Obtains and returns a free object from cache C.
+   Returns a null pointer if memory is not available. */
+/* 캐시 C에서 가용 객체를 가져와 반환합니다.
+   메모리를 사용할 수 없으면 널 포인터를 반환합니다. */
+void *kmem_cache_alloc(struct kmem_cache *c)
+{
+	void *obj = NULL;
+
+	enum intr_level old_level = intr_disable();
+	struct kmem_cpu *cc = &c->cpus[this_cpu()->id];
+
+	if (cc->cnt > 0)
+		c->cpu_hits++;
+	else
+	{
+		/* Refill the CPU stack from the slabs. */
+		/* 슬랩에서 CPU 스택을 채웁니다. */
+		while (cc->cnt < KMEM_CPU_BATCH)
+		{
+			struct slab *s;
+
+			if (!list_empty(&c->partial))
+				s = list_entry(list_front(&c->partial), struct slab, elem);
+			else if (!list_empty(&c->empty) || slab_grow(c))
+				s = list_entry(list_front(&c->empty), struct slab, elem);
+			else
+				break;
+			cc->objs[cc->cnt++] = slab_take(c, s);
+		}
+	}
+
+	if (cc->cnt > 0)
+	{
+		obj = cc->objs[--cc->cnt];
+		c->allocs++;
+	}
+	intr_set_level(old_level);
+	return obj;
+}
+
+/* Obtains and returns a free object from cache C, filled with
+   zeros.  Returns a null pointer if memory is not available. */
+/* 캐시 C에서 0으로 채운 가용 객체를 가져와 반환합니다. 메모리를
+   사용할 수 없으면 널 포인터를 반환합니다. */
+void *kmem_cache_zalloc(struct kmem_cache *c)
+{
+	void *obj = kmem_cache_alloc(c);
+
+	if (obj != NULL)
+		memset(obj, 0, c->size);
+	return obj;
+}
+
+/* Frees OBJ, which must have been allocated from cache C. */
+/* 캐시 C에서 할당된 것이어야 하는 OBJ를 해제합니다. */
+void kmem_cache_free(struct kmem_cache *c, void *obj)
+{
+	if (obj == NULL)
+		return;
+
+	ASSERT(obj_to_slab(c, obj)->cache == c);
+#ifndef NDEBUG
+	/* Clear the object to help detect use-after-free bugs. */
+	/* 해제 후 사용 버그를 탐지하는 데 도움이 되도록 객체를 지웁니다. */
+	if (c->ctor == NULL)
+		memset(obj, 0xcc, c->size);
+#endif
+
+	enum intr_level old_level = intr_disable();
+	struct kmem_cpu *cc = &c->cpus[this_cpu()->id];
+
+	/* Give the coldest objects of a full CPU stack back to their
+	   slabs. */
+	/* 가득 찬 CPU 스택의 가장 오래된 객체를 슬랩에 돌려줍니다. */
+	if (cc->cnt == KMEM_CPU_MAX)
+	{
+		for (int i = 0; i < KMEM_CPU_BATCH; i++)
+			slab_put(c, cc->objs[i]);
+		cc->cnt -= KMEM_CPU_BATCH;
+		memmove(cc->objs, cc->objs + KMEM_CPU_BATCH, cc->cnt * sizeof *cc->objs);
+	}
+	cc->objs[cc->cnt++] = obj;
+	c->frees++;
+	intr_set_level(old_level);
+}
+
+/* Returns the bytes of memory held by cache C's slabs. */
+/* 캐시 C의 슬랩이 차지하는 메모리 바이트 수를 반환합니다. */
+size_t kmem_cache_footprint(const struct kmem_cache *c)
+{
+	return c->slab_cnt * PGSIZE;
+}
+
+/* Prints, for every cache, its object size, the objects in use,
+   and the memory its slabs hold against what malloc() would use
+   for the same objects. */
+/* 모든 캐시에 대해 객체 크기, 사용 중인 객체 수, 그리고 슬랩이
+   차지하는 메모리를 같은 객체에 malloc()이 쓸 메모리와 비교해
+   출력합니다. */
+void kmem_cache_print_stats(void)
+{
+	struct list_elem *e;
+
+	for (e = list_begin(&cache_list); e != list_end(&cache_list); e = list_next(e))
+	{
+		struct kmem_cache *c = list_entry(e, struct kmem_cache, elem);
+		size_t active = c->allocs - c->frees;
+
+		printf("kmem_cache %s: %zu-byte objects, %zu per slab, %zu in use, "
+			   "%zu bytes in %zu slabs (malloc: %zu bytes)\n",
+			   c->name, c->size, c->objs_per_slab, active,
+			   kmem_cache_footprint(c), c->slab_cnt,
+			   active * malloc_footprint(c->size));
+		printf("  %llu allocations, %llu frees, %llu%% from CPU stacks\n",
+			   c->allocs, c->frees,
+			   c->allocs != 0 ? c->cpu_hits * 100 / c->allocs : 0);
+	}
+}
+
+/* Returns the slab that OBJ, an object of cache C, is inside. */
+/* 캐시 C의 객체인 OBJ가 들어 있는 슬랩을 반환합니다. */
+static struct slab *obj_to_slab(const struct kmem_cache *c, void *obj)
+{
+	struct slab *s = pg_round_down(obj);
+
+	ASSERT(s->magic == SLAB_MAGIC);
+	ASSERT((pg_ofs(obj) - c->first_ofs) % c->stride == 0);
+	return s;
+}
+
+/* Returns the free link inside OBJ, an object of cache C. */
+/* 캐시 C의 객체인 OBJ 안의 가용 링크를 반환합니다. */
+static void **obj_link(const struct kmem_cache *c, void *obj)
+{
+	return (void **)((uint8_t *)obj + c->link_ofs);
+}
+
+/* Adds a new slab to C's empty list, constructing its objects.
+   Returns false if no page is available.  Interrupts must be
+   off. */
+/* C의 empty 리스트에 새 슬랩을 추가하고 그 객체들을 생성합니다.
+   가용 페이지가 없으면 false를 반환합니다. 인터럽트가 꺼져 있어야
+   합니다. */
+static bool slab_grow(struct kmem_cache *c)
+{
+	struct slab *s = palloc_get_page(0);
+	size_t i;
+
+	if (s == NULL)
+		return false;
+
+	s->magic = SLAB_MAGIC;
+	s->cache = c;
+	s->inuse = 0;
+	s->free = NULL;
+	for (i = c->objs_per_slab; i-- > 0;)
+	{
+		void *obj = (uint8_t *)s + c->first_ofs + i * c->stride;
+		if (c->ctor != NULL)
+			c->ctor(obj);
+		*obj_link(c, obj) = s->free;
+		s->free = obj;
+	}
+	list_push_front(&c->empty, &s->elem);
+	c->slab_cnt++;
+	return true;
+}
+
+/* Takes a free object out of slab S of cache C, moving S to the
+   list that matches its new state.  Interrupts must be off. */
+/* 캐시 C의 슬랩 S에서 가용 객체를 꺼내고, S를 새 상태에 맞는
+   리스트로 옮깁니다. 인터럽트가 꺼져 있어야 합니다. */
+static void *slab_take(struct kmem_cache *c, struct slab *s)
+{
+	void *obj = s->free;
+
+	ASSERT(obj != NULL);
+	s->free = *obj_link(c, obj);
+	if (s->inuse++ == 0 || s->inuse == c->objs_per_slab)
+	{
+		list_remove(&s->elem);
+		list_push_front(s->inuse == c->objs_per_slab ? &c->full : &c->partial, &s->elem);
+	}
+	return obj;
+}
+
+/* Returns OBJ to its slab in cache C, moving the slab to the list
+   that matches its new state.  A second empty slab goes back to
+   the page allocator.  Interrupts must be off. */
+/* OBJ를 캐시 C의 자기 슬랩에 돌려주고, 슬랩을 새 상태에 맞는
+   리스트로 옮깁니다. 두 번째 빈 슬랩은 페이지 할당자로 돌려줍니다.
+   인터럽트가 꺼져 있어야 합니다. */
+static void slab_put(struct kmem_cache *c, void *obj)
+{
+	struct slab *s = obj_to_slab(c, obj);
+
+	ASSERT(s->inuse > 0);
+	*obj_link(c, obj) = s->free;
+	s->free = obj;
+	if (s->inuse-- == c->objs_per_slab || s->inuse == 0)
+	{
+		list_remove(&s->elem);
+		if (s->inuse != 0)
+			list_push_front(&c->partial, &s->elem);
+		else if (list_empty(&c->empty))
+			list_push_front(&c->empty, &s->elem);
+		else
+		{
+			c->slab_cnt--;
+			palloc_free_page(s);
+		}
+	}
+}
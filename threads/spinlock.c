@@ -0,0 +1,50 @@
+#include "threads/spinlock.h"
+#include <debug.h>
+#include <stddef.h>
+#include "threads/cpu.h"
+#include "threads/interrupt.h"
+
+/* Initializes spinlock LOCK as released. */
+/* 스핀락 LOCK을 풀린 상태로 초기화합니다. */
+void spin_init(struct spinlock *lock)
+{
+	ASSERT(lock != NULL);
+
+	lock->locked = 0;
+	lock->cpu = NULL;
+}
+
+/* Acquires LOCK, spinning until it becomes available.
+   Interrupts must be off, otherwise an interrupt handler on this
+   CPU could spin forever on a lock this CPU already holds. */
+/* LOCK을 사용할 수 있을 때까지 돌면서 기다린 뒤 획득합니다.
+   인터럽트가 꺼져 있어야 합니다. 그렇지 않으면 이 CPU의 인터럽트
+   핸들러가 이 CPU가 이미 잡은 락을 영원히 기다릴 수 있습니다. */
+void spin_lock(struct spinlock *lock)
+{
+	ASSERT(lock != NULL);
+	ASSERT(intr_get_level() == INTR_OFF);
+	ASSERT(!spin_held(lock));
+
+	while (__atomic_exchange_n(&lock->locked, 1, __ATOMIC_ACQUIRE) != 0)
+		while (lock->locked != 0)
+			asm volatile("pause" : : : "memory");
+	lock->cpu = this_cpu();
+}
+
+/* Releases LOCK, which must be held by this CPU. */
+/* 이 CPU가 잡고 있는 LOCK을 해제합니다. */
+void spin_unlock(struct spinlock *lock)
+{
+	ASSERT(spin_held(lock));
+
+	lock->cpu = NULL;
+	__atomic_store_n(&lock->locked, 0, __ATOMIC_RELEASE);
+}
+
+/* Returns true if this CPU holds LOCK. */
+/* 이 CPU가 LOCK을 잡고 있으면 true를 반환합니다. */
+bool spin_held(const struct spinlock *lock)
+{
+	return lock->locked != 0 && lock->cpu == this_cpu();
+}
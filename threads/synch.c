@@ -52,6 +52,18 @@
 #include "threads/interrupt.h"
 #include "threads/thread.h"
 
+static void sema_test_helper(void *sema_);
+static heap_less_func sema_waiter_less;
+static heap_less_func cond_waiter_less;
+static heap_less_func waiter_less;
+static heap_less_func rw_waiter_less;
+static int rwlock_donation(const struct rwlock *);
+static void rwlock_donate(struct rwlock *);
+
+/* Arrival counter that keeps waiters of equal priority FIFO. */
+/* 같은 우선순위의 대기자를 FIFO로 유지하는 도착 카운터. */
+static uint64_t wait_seq;
+
 /* Initializes semaphore SEMA to VALUE.  A semaphore is a
    nonnegative integer along with two atomic operators for
    manipulating it:
@@ -70,7 +82,22 @@ void sema_init(struct semaphore *sema, unsigned value)
    ASSERT(sema != NULL);
 
    sema->value = value;
-   list_init(&sema->waiters);
+   heap_init(&sema->waiters, sema_waiter_less, NULL);
+}
+
+/* Orders the threads waiting on a semaphore by priority, and
+   threads of equal priority by arrival, earliest first. */
+/* 세마포어를 기다리는 스레드를 우선순위로, 우선순위가 같으면 먼저
+   도착한 순서로 정렬합니다. */
+static bool sema_waiter_less(const struct heap_elem *a_, const struct heap_elem *b_,
+                             void *aux UNUSED)
+{
+   const struct thread *a = heap_entry(a_, struct thread, sema_elem);
+   const struct thread *b = heap_entry(b_, struct thread, sema_elem);
+
+   if (a->priority != b->priority)
+      return a->priority < b->priority;
+   return a->sema_seq > b->sema_seq;
 }
 
 /* Down or "P" operation on a semaphore.  Waits for SEMA's value
@@ -98,7 +125,10 @@ void sema_down(struct semaphore *sema)
    old_level = intr_disable();
    while (sema->value == 0)
    {
-      list_insert_ordered(&sema->waiters, &thread_current()->elem, (list_less_func *)&larger, NULL);
+      struct thread *cur = thread_current();
+      cur->wait_on_sema = sema;
+      cur->sema_seq = wait_seq++;
+      heap_push(&sema->waiters, &cur->sema_elem);
       thread_block();
    }
    sema->value--;
@@ -144,10 +174,10 @@ void sema_up(struct semaphore *sema)
 
    enum intr_level old_level = intr_disable();
 
-   if (!list_empty(&sema->waiters))
+   if (!heap_empty(&sema->waiters))
    {
-      list_sort(&sema->waiters, (list_less_func *)&larger, NULL);
-      struct thread *t = list_entry(list_pop_front(&sema->waiters), struct thread, elem);
+      struct thread *t = heap_entry(heap_pop(&sema->waiters), struct thread, sema_elem);
+      t->wait_on_sema = NULL;
       thread_unblock(t);
    }
 
@@ -158,8 +188,6 @@ void sema_up(struct semaphore *sema)
    thread_try_yield();
 }
 
-static void sema_test_helper(void *sema_);
-
 /* Self-test for semaphores that makes control "ping-pong"
    between a pair of threads.  Insert calls to printf() to see
    what's going on. */
@@ -229,6 +257,107 @@ void lock_init(struct lock *lock)
 
    lock->holder = NULL;
    sema_init(&lock->semaphore, 1);
+   heap_init(&lock->waiters, waiter_less, NULL);
+}
+
+/* Orders the threads waiting on a lock by priority. */
+/* 락을 기다리는 스레드를 우선순위로 정렬합니다. */
+static bool waiter_less(const struct heap_elem *a, const struct heap_elem *b,
+                        void *aux UNUSED)
+{
+   return heap_entry(a, struct thread, wait_elem)->priority < heap_entry(b, struct thread, wait_elem)->priority;
+}
+
+/* Returns the highest priority of a thread waiting on LOCK, or
+   PRI_MIN - 1 if there is none. */
+/* LOCK을 기다리는 스레드 중 가장 높은 우선순위를 반환하고, 없으면
+   PRI_MIN - 1을 반환합니다. */
+static int lock_donation(const struct lock *lock)
+{
+   struct heap_elem *top = heap_top(&lock->waiters);
+   return top != NULL ? heap_entry(top, struct thread, wait_elem)->priority : PRI_MIN - 1;
+}
+
+/* Orders the locks held by a thread by the priority of their
+   highest waiter. */
+/* 스레드가 잡고 있는 락들을 가장 높은 대기자의 우선순위로 정렬합니다. */
+static bool held_lock_less(const struct heap_elem *a, const struct heap_elem *b,
+                           void *aux UNUSED)
+{
+   return lock_donation(heap_entry(a, struct lock, holder_elem)) < lock_donation(heap_entry(b, struct lock, holder_elem));
+}
+
+/* Initializes the donation state of thread T, which holds no
+   locks yet. */
+/* 아직 락을 잡지 않은 스레드 T의 기부 상태를 초기화합니다. */
+void donation_init(struct thread *t)
+{
+   t->wait_on_lock = NULL;
+   heap_init(&t->held_locks, held_lock_less, NULL);
+   t->ceiling = PRI_MIN - 1;
+}
+
+/* Returns the highest priority donated to T, that is, the
+   highest priority of a thread waiting on a lock or rwlock T
+   holds, or the highest ceiling of the ceiling locks T holds,
+   whichever is higher, or PRI_MIN - 1 if there is none. */
+/* T에게 기부된 가장 높은 우선순위, 즉 T가 잡고 있는 락이나 rwlock을
+   기다리는 스레드 중 가장 높은 우선순위와 T가 잡고 있는 상한 락 중
+   가장 높은 상한 가운데 더 높은 값을 반환하고, 없으면 PRI_MIN - 1을
+   반환합니다. */
+int donation_priority(const struct thread *t)
+{
+   struct heap_elem *top = heap_top(&t->held_locks);
+   int priority = top != NULL ? lock_donation(heap_entry(top, struct lock, holder_elem)) : PRI_MIN - 1;
+
+   if (t->ceiling > priority)
+      priority = t->ceiling;
+
+   for (int i = 0; i < RWLOCK_HOLD_MAX; i++)
+      if (t->rw_holds[i].lock != NULL && rwlock_donation(t->rw_holds[i].lock) > priority)
+         priority = rwlock_donation(t->rw_holds[i].lock);
+   return priority;
+}
+
+/* Returns T's effective priority: its own priority, raised to the
+   highest priority donated to it. */
+/* T의 유효 우선순위, 즉 자신의 우선순위를 기부받은 가장 높은
+   우선순위까지 올린 값을 반환합니다. */
+static int effective_priority(const struct thread *t)
+{
+   int donated = donation_priority(t);
+   return donated > t->origin_priority ? donated : t->origin_priority;
+}
+
+/* Makes the threads waiting on LOCK donate their priority along
+   the chain of holders.  Each hop re-keys one lock in its
+   holder's heap and stops as soon as a holder's priority does not
+   change.  Interrupts must be off. */
+/* LOCK을 기다리는 스레드들이 홀더 체인을 따라 우선순위를 기부하게
+   합니다. 각 단계는 홀더의 힙에서 락 하나의 키만 갱신하며, 홀더의
+   우선순위가 바뀌지 않으면 바로 멈춥니다. 인터럽트가 꺼져 있어야
+   합니다. */
+static void donate_priority(struct lock *lock)
+{
+   ASSERT(intr_get_level() == INTR_OFF);
+
+   while (lock != NULL && lock->holder != NULL)
+   {
+      struct thread *holder = lock->holder;
+
+      heap_increase(&holder->held_locks, &lock->holder_elem);
+      int priority = effective_priority(holder);
+      if (priority <= holder->priority)
+         break;
+
+      thread_change_priority(holder, priority);
+      if (holder->wait_on_rwlock != NULL)
+      {
+         rwlock_donate(holder->wait_on_rwlock);
+         break;
+      }
+      lock = holder->wait_on_lock;
+   }
 }
 
 /* Acquires LOCK, sleeping until it becomes available if
@@ -251,30 +380,34 @@ void lock_acquire(struct lock *lock)
    ASSERT(!intr_context());
    ASSERT(!lock_held_by_current_thread(lock));
 
-   struct thread *thread_now = thread_current();
+   struct thread *cur = thread_current();
+   enum intr_level old_level = intr_disable();
 
-   if (lock->holder != NULL)
+   /* The MLFQS scheduler does not use priority donation. */
+   /* MLFQS 스케줄러는 우선순위 기부를 사용하지 않습니다. */
+   if (lock->semaphore.value == 0 && !thread_mlfqs)
    {
-      thread_now->wait_on_lock = lock;
-      if (thread_get_priority() > lock->holder->priority)
-      {
-         list_insert_ordered(&thread_now->wait_on_lock->holder->donations, &thread_now->d_elem, (list_less_func *)&larger, NULL);
-
-         while (thread_now->wait_on_lock != NULL)
-         {
-            if (thread_now->priority > thread_now->wait_on_lock->holder->priority)
-            {
-               thread_now->wait_on_lock->holder->priority = thread_now->priority;
-               thread_now = thread_now->wait_on_lock->holder;
-            }
-            else
-               break;
-         }
-      }
+      cur->wait_on_lock = lock;
+      heap_push(&lock->waiters, &cur->wait_elem);
+      donate_priority(lock);
    }
+
    sema_down(&lock->semaphore);
-   thread_current()->wait_on_lock = NULL;
-   lock->holder = thread_current();
+
+   if (cur->wait_on_lock == lock)
+   {
+      heap_remove(&lock->waiters, &cur->wait_elem);
+      cur->wait_on_lock = NULL;
+   }
+   lock->holder = cur;
+   if (!thread_mlfqs)
+   {
+      /* Threads still waiting on LOCK now donate to us. */
+      /* 아직 LOCK을 기다리는 스레드들은 이제 우리에게 기부합니다. */
+      heap_push(&cur->held_locks, &lock->holder_elem);
+      cur->priority = effective_priority(cur);
+   }
+   intr_set_level(old_level);
 }
 
 /* Tries to acquires LOCK and returns true if successful or false
@@ -294,21 +427,39 @@ bool lock_try_acquire(struct lock *lock)
    ASSERT(lock != NULL);
    ASSERT(!lock_held_by_current_thread(lock));
 
+   enum intr_level old_level = intr_disable();
    success = sema_try_down(&lock->semaphore);
    if (success)
-      lock->holder = thread_current();
+   {
+      struct thread *cur = thread_current();
+      lock->holder = cur;
+      if (!thread_mlfqs)
+      {
+         heap_push(&cur->held_locks, &lock->holder_elem);
+         cur->priority = effective_priority(cur);
+      }
+   }
+   intr_set_level(old_level);
    return success;
 }
 
 /* Releases LOCK, which must be owned by the current thread.
    This is lock_release function.
 
+   The threads waiting on LOCK stop donating to us; our priority
+   falls back to the highest donation through the other locks we
+   hold, found at the top of our held-lock heap.
+
    An interrupt handler cannot acquire a lock, so it does not
    make sense to try to release a lock within an interrupt
    handler. */
 /* 현재 스레드가 소유하고 있어야 하는 LOCK을 해제합니다. 이것이
    lock_release 함수입니다.
 
+   LOCK을 기다리던 스레드들은 더 이상 우리에게 기부하지 않으며, 우리의
+   우선순위는 잡고 있는 다른 락들을 통한 가장 높은 기부로 돌아갑니다.
+   이 값은 잡고 있는 락 힙의 맨 위에 있습니다.
+
    인터럽트 핸들러는 잠금을 획득할 수 없으므로 인터럽트 핸들러 내에서
    잠금을 해제하려고 시도하는 것은 의미가 없습니다. */
 void lock_release(struct lock *lock)
@@ -317,32 +468,19 @@ void lock_release(struct lock *lock)
    ASSERT(lock_held_by_current_thread(lock));
    struct thread *cur = lock->holder;
 
-   if (!list_empty(&cur->donations))
-   {
-      struct list_elem *e = list_begin(&cur->donations);
-      while (e != list_end(&cur->donations))
-      {
-         struct thread *t = list_entry(e, struct thread, d_elem);
-         if (t->wait_on_lock == lock)
-         {
-            list_remove(e);
-            t->wait_on_lock = NULL;
-         }
-         e = e->next;
-      }
-   }
-
-   if (!list_empty(&cur->donations))
-   {
-      struct thread *t = list_entry(list_front(&cur->donations), struct thread, d_elem);
-      cur->priority = t->priority;
-   }
-   else
+   enum intr_level old_level = intr_disable();
+   if (!thread_mlfqs)
    {
-      cur->priority = cur->origin_priority;
+      /* We may be in a condition's waiters, so the key there must
+         follow our priority. */
+      /* 조건 변수의 대기자 힙에 있을 수 있으므로 그 키가 우리
+         우선순위를 따라야 합니다. */
+      heap_remove(&cur->held_locks, &lock->holder_elem);
+      thread_change_priority(cur, effective_priority(cur));
    }
-
    lock->holder = NULL;
+   intr_set_level(old_level);
+
    sema_up(&lock->semaphore);
 }
 
@@ -359,14 +497,372 @@ bool lock_held_by_current_thread(const struct lock *lock)
    return lock->holder == thread_current();
 }
 
+/* Initializes LOCK as a priority-ceiling lock whose holder runs
+   at priority CEILING.  CEILING must be at least the priority of
+   every thread that will acquire LOCK. */
+/* LOCK을 홀더가 CEILING 우선순위로 실행되는 우선순위 상한 락으로
+   초기화합니다. CEILING은 LOCK을 획득할 모든 스레드의 우선순위
+   이상이어야 합니다. */
+void ceiling_lock_init(struct ceiling_lock *lock, int ceiling)
+{
+   ASSERT(lock != NULL);
+   ASSERT(PRI_MIN <= ceiling && ceiling <= PRI_MAX);
+
+   lock->holder = NULL;
+   lock->ceiling = ceiling;
+   lock->saved_ceiling = PRI_MIN - 1;
+   sema_init(&lock->semaphore, 1);
+}
+
+/* Acquires LOCK and raises the current thread to LOCK's ceiling
+   until it is released.  Sleeps only if the holder blocked
+   inside its critical section.
+
+   This function may sleep, so it must not be called within an
+   interrupt handler. */
+/* LOCK을 획득하고 해제할 때까지 현재 스레드를 LOCK의 상한 우선순위로
+   올립니다. 홀더가 임계 구역 안에서 블록된 경우에만 잠듭니다.
+
+   이 함수는 잠들 수 있으므로 인터럽트 핸들러 내에서 호출해서는
+   안 됩니다. */
+void ceiling_lock_acquire(struct ceiling_lock *lock)
+{
+   ASSERT(lock != NULL);
+   ASSERT(!intr_context());
+   ASSERT(!ceiling_lock_held_by_current_thread(lock));
+   ASSERT(thread_mlfqs || thread_get_priority() <= lock->ceiling);
+
+   struct thread *cur = thread_current();
+
+   sema_down(&lock->semaphore);
+
+   enum intr_level old_level = intr_disable();
+   lock->holder = cur;
+   lock->saved_ceiling = cur->ceiling;
+   // MLFQS에서는 스케줄러가 우선순위를 정하므로 올리지 않습니다.
+   if (!thread_mlfqs && cur->ceiling < lock->ceiling)
+   {
+      cur->ceiling = lock->ceiling;
+      cur->priority = effective_priority(cur);
+   }
+   intr_set_level(old_level);
+}
+
+/* Releases LOCK, which must be held by the current thread, and
+   drops back to the ceiling held before acquiring it.  The
+   priority is recomputed from the thread's own priority, its
+   donations and that ceiling, so changes made while LOCK was held
+   are kept. */
+/* 현재 스레드가 잡고 있는 LOCK을 해제하고 획득 전에 잡고 있던
+   상한으로 돌아갑니다. 우선순위는 스레드 자신의 우선순위, 기부, 그
+   상한으로 다시 계산하므로 LOCK을 잡은 동안 바뀐 내용은 유지됩니다. */
+void ceiling_lock_release(struct ceiling_lock *lock)
+{
+   ASSERT(lock != NULL);
+   ASSERT(ceiling_lock_held_by_current_thread(lock));
+
+   struct thread *cur = thread_current();
+
+   enum intr_level old_level = intr_disable();
+   if (!thread_mlfqs)
+   {
+      cur->ceiling = lock->saved_ceiling;
+      thread_change_priority(cur, effective_priority(cur));
+   }
+   lock->holder = NULL;
+   intr_set_level(old_level);
+
+   sema_up(&lock->semaphore);
+}
+
+/* Returns true if the current thread holds LOCK, false
+   otherwise. */
+/* 현재 스레드가 LOCK을 보유하고 있으면 참을, 그렇지 않으면 거짓을
+   반환합니다. */
+bool ceiling_lock_held_by_current_thread(const struct ceiling_lock *lock)
+{
+   ASSERT(lock != NULL);
+
+   return lock->holder == thread_current();
+}
+
+/* Initializes RW as an rwlock that nobody holds. */
+/* RW를 아무도 잡지 않은 rwlock으로 초기화합니다. */
+void rwlock_init(struct rwlock *rw)
+{
+   ASSERT(rw != NULL);
+
+   rw->readers = 0;
+   rw->writer = NULL;
+   list_init(&rw->holders);
+   heap_init(&rw->waiters, rw_waiter_less, NULL);
+}
+
+/* Orders the threads waiting on an rwlock by priority, and
+   threads of equal priority by arrival, earliest first. */
+/* rwlock을 기다리는 스레드를 우선순위로, 같으면 먼저 도착한 순서로
+   정렬합니다. */
+static bool rw_waiter_less(const struct heap_elem *a_, const struct heap_elem *b_,
+                           void *aux UNUSED)
+{
+   const struct thread *a = heap_entry(a_, struct thread, rw_elem);
+   const struct thread *b = heap_entry(b_, struct thread, rw_elem);
+
+   if (a->priority != b->priority)
+      return a->priority < b->priority;
+   return a->rw_seq > b->rw_seq;
+}
+
+/* Returns the highest priority of a thread waiting on RW, or
+   PRI_MIN - 1 if there is none. */
+/* RW를 기다리는 스레드 중 가장 높은 우선순위를 반환하고, 없으면
+   PRI_MIN - 1을 반환합니다. */
+static int rwlock_donation(const struct rwlock *rw)
+{
+   struct heap_elem *top = heap_top(&rw->waiters);
+   return top != NULL ? heap_entry(top, struct thread, rw_elem)->priority : PRI_MIN - 1;
+}
+
+/* Raises every holder of RW to the priority of its highest
+   waiter and carries the donation on to whatever each raised
+   holder is itself waiting for.  Interrupts must be off. */
+/* RW의 모든 홀더를 가장 높은 대기자의 우선순위로 올리고, 올라간
+   홀더가 기다리고 있는 것에도 기부를 이어 전달합니다. 인터럽트가
+   꺼져 있어야 합니다. */
+static void rwlock_donate(struct rwlock *rw)
+{
+   int priority = rwlock_donation(rw);
+
+   ASSERT(intr_get_level() == INTR_OFF);
+
+   for (struct list_elem *e = list_begin(&rw->holders); e != list_end(&rw->holders); e = list_next(e))
+   {
+      struct thread *holder = list_entry(e, struct rwlock_hold, elem)->thread;
+      if (holder->priority >= priority)
+         continue;
+
+      thread_change_priority(holder, priority);
+      if (holder->wait_on_lock != NULL)
+         donate_priority(holder->wait_on_lock);
+      else if (holder->wait_on_rwlock != NULL)
+         rwlock_donate(holder->wait_on_rwlock);
+   }
+}
+
+/* Records that T now holds RW, for writing if WRITE is true.
+   Interrupts must be off. */
+/* T가 이제 RW를 잡고 있음을 기록합니다. WRITE가 참이면 쓰기
+   모드입니다. 인터럽트가 꺼져 있어야 합니다. */
+static void rwlock_grant(struct rwlock *rw, struct thread *t, bool write)
+{
+   struct rwlock_hold *hold = NULL;
+
+   for (int i = 0; i < RWLOCK_HOLD_MAX; i++)
+      if (t->rw_holds[i].lock == NULL)
+      {
+         hold = &t->rw_holds[i];
+         break;
+      }
+   ASSERT(hold != NULL);
+
+   hold->lock = rw;
+   hold->thread = t;
+   list_push_back(&rw->holders, &hold->elem);
+   if (write)
+      rw->writer = t;
+   else
+      rw->readers++;
+}
+
+/* Blocks the current thread on RW until a releasing holder
+   grants it the lock, for writing if WRITE is true.  Interrupts
+   must be off. */
+/* 해제하는 홀더가 락을 넘겨줄 때까지 현재 스레드를 RW에서 막습니다.
+   WRITE가 참이면 쓰기 모드입니다. 인터럽트가 꺼져 있어야 합니다. */
+static void rwlock_wait(struct rwlock *rw, bool write)
+{
+   struct thread *cur = thread_current();
+
+   cur->wait_on_rwlock = rw;
+   cur->rw_write = write;
+   cur->rw_seq = wait_seq++;
+   heap_push(&rw->waiters, &cur->rw_elem);
+
+   /* The MLFQS scheduler does not use priority donation. */
+   /* MLFQS 스케줄러는 우선순위 기부를 사용하지 않습니다. */
+   if (!thread_mlfqs)
+      rwlock_donate(rw);
+   thread_block();
+}
+
+/* Acquires RW for reading, sleeping while a writer holds it or
+   anyone is already waiting for it. */
+/* RW를 읽기 모드로 획득합니다. 쓰기 스레드가 잡고 있거나 이미
+   누군가 기다리고 있으면 잠듭니다. */
+void rwlock_acquire_read(struct rwlock *rw)
+{
+   ASSERT(rw != NULL);
+   ASSERT(!intr_context());
+   ASSERT(!rwlock_held_by_current_thread(rw));
+
+   enum intr_level old_level = intr_disable();
+   if (rw->writer == NULL && heap_empty(&rw->waiters))
+      rwlock_grant(rw, thread_current(), false);
+   else
+      rwlock_wait(rw, false);
+   intr_set_level(old_level);
+}
+
+/* Acquires RW for writing, sleeping while anyone holds it or is
+   already waiting for it. */
+/* RW를 쓰기 모드로 획득합니다. 누군가 잡고 있거나 이미 기다리고
+   있으면 잠듭니다. */
+void rwlock_acquire_write(struct rwlock *rw)
+{
+   ASSERT(rw != NULL);
+   ASSERT(!intr_context());
+   ASSERT(!rwlock_held_by_current_thread(rw));
+
+   enum intr_level old_level = intr_disable();
+   if (rw->writer == NULL && rw->readers == 0 && heap_empty(&rw->waiters))
+      rwlock_grant(rw, thread_current(), true);
+   else
+      rwlock_wait(rw, true);
+   intr_set_level(old_level);
+}
+
+/* Drops the current thread's hold on RW.  If that leaves RW
+   free, hands it to the highest waiter: a writer alone, or a
+   reader together with the readers queued right behind it up to
+   the next writer. */
+/* 현재 스레드가 RW를 잡은 기록을 지웁니다. 그 결과 RW가 비면 가장
+   높은 대기자에게 넘깁니다. 쓰기 스레드라면 혼자, 읽기 스레드라면
+   다음 쓰기 스레드 전까지 바로 뒤에 줄 선 읽기 스레드들과 함께
+   넘깁니다. */
+static void rwlock_release(struct rwlock *rw)
+{
+   struct thread *cur = thread_current();
+
+   enum intr_level old_level = intr_disable();
+   for (int i = 0; i < RWLOCK_HOLD_MAX; i++)
+      if (cur->rw_holds[i].lock == rw)
+      {
+         list_remove(&cur->rw_holds[i].elem);
+         cur->rw_holds[i].lock = NULL;
+         break;
+      }
+   if (rw->writer == cur)
+      rw->writer = NULL;
+   else
+      rw->readers--;
+   if (!thread_mlfqs)
+      thread_change_priority(cur, effective_priority(cur));
+
+   while (rw->writer == NULL && !heap_empty(&rw->waiters))
+   {
+      struct thread *t = heap_entry(heap_top(&rw->waiters), struct thread, rw_elem);
+      if (t->rw_write && rw->readers > 0)
+         break;
+
+      heap_pop(&rw->waiters);
+      t->wait_on_rwlock = NULL;
+      rwlock_grant(rw, t, t->rw_write);
+      thread_unblock(t);
+   }
+   intr_set_level(old_level);
+
+   thread_try_yield();
+}
+
+/* Releases RW, which the current thread must hold for reading. */
+/* 현재 스레드가 읽기 모드로 잡고 있어야 하는 RW를 해제합니다. */
+void rwlock_release_read(struct rwlock *rw)
+{
+   ASSERT(rw != NULL);
+   ASSERT(rwlock_held_by_current_thread(rw));
+   ASSERT(rw->writer != thread_current());
+
+   rwlock_release(rw);
+}
+
+/* Releases RW, which the current thread must hold for writing. */
+/* 현재 스레드가 쓰기 모드로 잡고 있어야 하는 RW를 해제합니다. */
+void rwlock_release_write(struct rwlock *rw)
+{
+   ASSERT(rw != NULL);
+   ASSERT(rw->writer == thread_current());
+
+   rwlock_release(rw);
+}
+
+/* Returns true if the current thread holds RW in either mode,
+   false otherwise. */
+/* 현재 스레드가 어느 모드로든 RW를 잡고 있으면 참을, 그렇지 않으면
+   거짓을 반환합니다. */
+bool rwlock_held_by_current_thread(const struct rwlock *rw)
+{
+   struct thread *cur = thread_current();
+
+   ASSERT(rw != NULL);
+
+   for (int i = 0; i < RWLOCK_HOLD_MAX; i++)
+      if (cur->rw_holds[i].lock == rw)
+         return true;
+   return false;
+}
+
 /* One semaphore in a list. */
 /* 리스트에 하나의 세마포어가 있습니다.*/
 struct semaphore_elem
 {
-   struct list_elem elem;      /* List element. */
+   struct heap_elem elem;      /* Heap element. */
    struct semaphore semaphore; /* This semaphore. */
+   struct thread *thread;      /* Waiting thread. */
+   struct condition *cond;     /* Condition waited on. */
+   uint64_t seq;               /* Arrival order. */
 };
 
+/* Orders the waiters of a condition variable by the priority of
+   their threads, and equal priorities by arrival. */
+/* 조건 변수의 대기자를 스레드 우선순위로, 같으면 도착 순서로
+   정렬합니다. */
+static bool cond_waiter_less(const struct heap_elem *a_, const struct heap_elem *b_,
+                             void *aux UNUSED)
+{
+   const struct semaphore_elem *a = heap_entry(a_, struct semaphore_elem, elem);
+   const struct semaphore_elem *b = heap_entry(b_, struct semaphore_elem, elem);
+
+   if (a->thread->priority != b->thread->priority)
+      return a->thread->priority < b->thread->priority;
+   return a->seq > b->seq;
+}
+
+/* Called with interrupts off after T's priority changed from
+   OLD_PRIORITY, to move T within the lock, rwlock, semaphore and
+   condition variable waiters it is in.  O(1) when the priority rose,
+   O(log n) amortized when it fell. */
+/* T의 우선순위가 OLD_PRIORITY에서 바뀐 뒤 인터럽트가 꺼진 상태에서
+   호출되어, T가 들어 있는 락, rwlock, 세마포어, 조건 변수 대기자
+   힙에서 T의
+   위치를 옮깁니다. 우선순위가 올랐으면 O(1), 내렸으면 분할 상환
+   O(log n)입니다. */
+void waiter_priority_changed(struct thread *t, int old_priority)
+{
+   void (*fix)(struct heap *, struct heap_elem *) =
+       t->priority > old_priority ? heap_increase : heap_update;
+
+   ASSERT(intr_get_level() == INTR_OFF);
+
+   if (t->wait_on_lock != NULL)
+      fix(&t->wait_on_lock->waiters, &t->wait_elem);
+   if (t->wait_on_rwlock != NULL)
+      fix(&t->wait_on_rwlock->waiters, &t->rw_elem);
+   if (t->wait_on_sema != NULL)
+      fix(&t->wait_on_sema->waiters, &t->sema_elem);
+   if (t->cond_waiter != NULL)
+      fix(&t->cond_waiter->cond->waiters, &t->cond_waiter->elem);
+}
+
 /* Initializes condition variable COND.  A condition variable
    allows one piece of code to signal a condition and cooperating
    code to receive the signal and act upon it. */
@@ -376,7 +872,7 @@ void cond_init(struct condition *cond)
 {
    ASSERT(cond != NULL);
 
-   list_init(&cond->waiters);
+   heap_init(&cond->waiters, cond_waiter_less, NULL);
 }
 
 /* Atomically releases LOCK and waits for COND to be signaled by
@@ -424,7 +920,15 @@ void cond_wait(struct condition *cond, struct lock *lock)
    ASSERT(lock_held_by_current_thread(lock));
 
    sema_init(&waiter.semaphore, 0);
-   list_insert_ordered(&cond->waiters, &waiter.elem, (list_less_func *)cond_priority, NULL);
+   waiter.thread = thread_current();
+   waiter.cond = cond;
+
+   enum intr_level old_level = intr_disable();
+   waiter.seq = wait_seq++;
+   heap_push(&cond->waiters, &waiter.elem);
+   waiter.thread->cond_waiter = &waiter;
+   intr_set_level(old_level);
+
    lock_release(lock);
    sema_down(&waiter.semaphore);
    lock_acquire(lock);
@@ -451,10 +955,14 @@ void cond_signal(struct condition *cond, struct lock *lock UNUSED)
    ASSERT(!intr_context());
    ASSERT(lock_held_by_current_thread(lock));
 
-   if (!list_empty(&cond->waiters))
+   if (!heap_empty(&cond->waiters))
    {
-      list_sort(&cond->waiters, (list_less_func *)cond_priority, NULL);
-      sema_up(&list_entry(list_pop_front(&cond->waiters), struct semaphore_elem, elem)->semaphore);
+      enum intr_level old_level = intr_disable();
+      struct semaphore_elem *waiter = heap_entry(heap_pop(&cond->waiters), struct semaphore_elem, elem);
+      waiter->thread->cond_waiter = NULL;
+      intr_set_level(old_level);
+
+      sema_up(&waiter->semaphore);
    }
 }
 
@@ -468,15 +976,6 @@ void cond_broadcast(struct condition *cond, struct lock *lock)
    ASSERT(cond != NULL);
    ASSERT(lock != NULL);
 
-   while (!list_empty(&cond->waiters))
+   while (!heap_empty(&cond->waiters))
       cond_signal(cond, lock);
 }
-
-bool cond_priority(const struct list_elem *a, const struct list_elem *b, void *aux)
-{
-   struct semaphore_elem *sema_a = list_entry(a, struct semaphore_elem, elem);
-   struct semaphore_elem *sema_b = list_entry(b, struct semaphore_elem, elem);
-   struct thread *t_a = list_entry(list_begin(&sema_a->semaphore.waiters), struct thread, elem);
-   struct thread *t_b = list_entry(list_begin(&sema_b->semaphore.waiters), struct thread, elem);
-   return t_a->priority > t_b->priority;
-}
\ No newline at end of file
@@ -4,9 +4,14 @@
 #include <random.h>
 #include <stdio.h>
 #include <string.h>
+#include "devices/timer.h"
+#include "threads/cpu.h"
+#include "threads/fixed_point.h"
 #include "threads/flags.h"
 #include "threads/interrupt.h"
 #include "threads/intr-stubs.h"
+#include "threads/malloc.h"
+#include "threads/mmu.h"
 #include "threads/palloc.h"
 #include "threads/synch.h"
 #include "threads/vaddr.h"
@@ -38,18 +43,42 @@ struct value
    이 값을 수정하지 마세요. */
 #define THREAD_BASIC 0xd42df210
 
-/* List of processes in THREAD_READY state, that is, processes
-   that are ready to run but not actually running. */
-/* 스레드_준비 상태의 프로세스, 즉 실행할 준비가 되었지만
-   실제로 실행되지 않는 프로세스의 목록입니다. */
-static struct list ready_list;
-
-// sleep_list 생성
-static struct list sleep_list;
-
-/* Idle thread. */
-/* 유휴 스레드. */
-static struct thread *idle_thread;
+/* The queues of processes in THREAD_READY state, that is,
+   processes that are ready to run but not actually running, live
+   in each CPU's struct cpu, along with its idle thread, time
+   slice and statistics.  See threads/cpu.h. */
+/* 스레드_준비 상태의 프로세스, 즉 실행할 준비가 되었지만 실제로
+   실행되지 않는 프로세스의 대기열은 유휴 스레드, 타임 슬라이스,
+   통계와 함께 CPU마다 struct cpu에 있습니다. threads/cpu.h를
+   참고하세요. */
+
+/* Hierarchical timing wheel of sleeping threads.  The near
+   wheel has one slot per tick for the next WHEEL_NEAR_SIZE
+   ticks; each outer level covers WHEEL_LEVEL_BITS more bits of
+   the wake-up tick and is cascaded into the level below it when
+   that level wraps around.  Wake-ups farther away than every
+   level can hold wait in wheel_far.  Arming and expiring a sleep
+   are O(1) amortized. */
+/* 잠든 스레드를 위한 계층형 타이밍 휠입니다. near 휠은 앞으로
+   WHEEL_NEAR_SIZE 틱 동안 틱마다 슬롯 하나를 가지며, 바깥 레벨은
+   깨어날 틱의 상위 WHEEL_LEVEL_BITS 비트씩을 담당하다가 아래 레벨이
+   한 바퀴 돌 때 아래로 내려옵니다(cascade). 모든 레벨의 범위를
+   넘어서는 스레드는 wheel_far에서 기다립니다. sleep 등록과 만료가
+   모두 분할 상환 O(1)입니다. */
+#define WHEEL_NEAR_BITS 8
+#define WHEEL_NEAR_SIZE (1 << WHEEL_NEAR_BITS)
+#define WHEEL_NEAR_MASK (WHEEL_NEAR_SIZE - 1)
+#define WHEEL_LEVEL_BITS 6
+#define WHEEL_LEVEL_SIZE (1 << WHEEL_LEVEL_BITS)
+#define WHEEL_LEVEL_MASK (WHEEL_LEVEL_SIZE - 1)
+#define WHEEL_LEVELS 3
+#define WHEEL_SHIFT(LEVEL) (WHEEL_NEAR_BITS + (LEVEL) * WHEEL_LEVEL_BITS)
+
+static struct list wheel_near[WHEEL_NEAR_SIZE];
+static struct list wheel_outer[WHEEL_LEVELS][WHEEL_LEVEL_SIZE];
+static struct list wheel_far;
+static int64_t wheel_tick; /* Last tick expired by the wheel. */
+						   /* 휠이 마지막으로 처리한 틱. */
 
 /* Initial thread, the thread running init.c:main(). */
 /* 초기 스레드, init.c:main()을 실행하는 스레드. */
@@ -59,25 +88,28 @@ static struct thread *initial_thread;
 /* allocate_tid()에서 사용하는 락입니다. */
 static struct lock tid_lock;
 
+/* Tids of reaped threads, oldest first, in a ring.  allocate_tid()
+   reuses the oldest only once the ring is full, so a tid comes back
+   only after TID_CACHE_MAX - 1 later ones have been reaped.
+   Protected by tid_lock. */
+/* 회수된 스레드의 tid를 오래된 순서대로 담는 링. allocate_tid()는 링이
+   가득 찼을 때만 가장 오래된 tid를 재사용하므로, tid는 그 뒤로
+   TID_CACHE_MAX - 1개의 tid가 회수된 다음에야 돌아옵니다.
+   tid_lock으로 보호됩니다. */
+#define TID_CACHE_MAX 64
+static tid_t free_tids[TID_CACHE_MAX];
+static int free_tid_head; /* Index of the oldest tid. */
+						  /* 가장 오래된 tid의 인덱스. */
+static int free_tid_cnt;
+
 /* Thread destruction requests */
 /* 스레드 파괴 요청 */
 static struct list destruction_req;
 
-/* Statistics. */
-/* 통계. */
-static long long idle_ticks;   /* # of timer ticks spent idle. */
-							   /* 유휴 타이머 틱 수입니다. */
-static long long kernel_ticks; /* # of timer ticks in kernel threads. */
-							   /* 커널 스레드의 타이머 틱 수입니다. */
-static long long user_ticks;   /* # of timer ticks in user programs. */
-							   /* 사용자 프로그램의 타이머 틱 수입니다. */
-
 /* Scheduling. */
 /* 스케줄링. */
-#define TIME_SLICE 4		  /* # of timer ticks to give each thread. */
-							  /* 각 스레드에 부여할 타이머 틱 수입니다. */
-static unsigned thread_ticks; /* # of timer ticks since last yield. */
-							  /* 마지막 yield 이후 타이머 틱 횟수입니다. */
+#define TIME_SLICE 4 /* # of timer ticks to give each thread. */
+					 /* 각 스레드에 부여할 타이머 틱 수입니다. */
 
 /* If false (default), use round-robin scheduler.
    If true, use multi-level feedback queue scheduler.
@@ -87,16 +119,55 @@ static unsigned thread_ticks; /* # of timer ticks since last yield. */
    커널 명령줄 옵션 "-o mlfqs"로 제어합니다. */
 bool thread_mlfqs;
 
+/* If true, print the wakeup latency histogram at power-off. */
+/* true이면 전원을 끌 때 깨어남 지연 히스토그램을 출력합니다. */
+bool thread_sched_stats;
+
+/* List of all live threads, for looking a thread up by tid. */
+/* tid로 스레드를 찾기 위한 살아 있는 모든 스레드의 리스트. */
+static struct list all_list;
+
+/* MLFQS state.  load_avg is the system load average.  cpu_list
+   holds every thread whose recent_cpu or nice is nonzero; any
+   other thread is a fixed point of the per-second decay and keeps
+   priority PRI_MAX, so it is never visited.  dirty_list holds the
+   threads whose recent_cpu changed since the last priority
+   recomputation, which are the only ones it needs to touch. */
+/* MLFQS 상태. load_avg는 시스템 부하 평균입니다. cpu_list에는
+   recent_cpu나 nice가 0이 아닌 스레드만 들어 있으며, 나머지 스레드는
+   매초 감쇠해도 값이 변하지 않고 우선순위가 PRI_MAX로 고정되므로
+   방문하지 않습니다. dirty_list에는 마지막 우선순위 재계산 이후
+   recent_cpu가 바뀐 스레드만 들어 있으며, 재계산은 이들만 처리합니다. */
+#define PRI_RECALC_TICKS 4 /* # of timer ticks between priority updates. */
+						   /* 우선순위 재계산 사이의 타이머 틱 수. */
+static fixed_t load_avg;
+static struct list cpu_list;
+static struct list dirty_list;
+
+static void mlfqs_tick(struct thread *);
+static void mlfqs_decay(void);
+static void mlfqs_update_priority(struct thread *);
+static void mlfqs_activate(struct thread *);
+static void mlfqs_mark_dirty(struct thread *);
+
 static void kernel_thread(thread_func *, void *aux);
 
 static void idle(void *aux UNUSED);
 static struct thread *next_thread_to_run(void);
+static void ready_push(struct thread *);
+static void ready_remove(struct thread *);
+static int ready_max_priority(void);
+static void wheel_insert(struct thread *);
+static void wheel_cascade(int level);
 // TODO: Initializes data structure for priority donation.
 // TODO: 우선순위 기부를 위한 자료 구조를 초기화합니다.
 static void init_thread(struct thread *, const char *name, int priority);
 static void do_schedule(int status);
 static void schedule(void);
+static void account_switch(struct thread *curr, struct thread *next);
 static tid_t allocate_tid(void);
+static struct thread *thread_page_alloc(void);
+static void thread_page_free(void *);
 
 /* Returns true if T appears to point to a valid thread. */
 /* T가 유효한 스레드를 가리키는 것처럼 보이면 true를 반환합니다. */
@@ -121,34 +192,6 @@ static tid_t allocate_tid(void);
 // gdt는 thread_init 이후에 설정되므로 임시 gdt를 먼저 설정해야 합니다.
 static uint64_t gdt[3] = {0, 0x00af9a000000ffff, 0x00cf92000000ffff};
 
-bool local_tick(const struct list_elem *a, const struct list_elem *b, void *aux)
-{
-	struct thread *A = list_entry(a, struct thread, elem);
-	struct thread *B = list_entry(b, struct thread, elem);
-
-	if (A->tick <= B->tick)
-	{
-		return true;
-	}
-	else
-		return false;
-}
-
-bool larger(const struct list_elem *a, const struct list_elem *b, void *aux)
-{
-	struct thread *A = list_entry(a, struct thread, elem);
-	struct thread *B = list_entry(b, struct thread, elem);
-
-	if (A->priority > B->priority)
-	{
-		return true;
-	}
-	else
-	{
-		return false;
-	}
-}
-
 /* Initializes the threading system by transforming the code
    that's currently running into a thread.  This can't work in
    general and it is possible in this case only because loader.S
@@ -192,9 +235,19 @@ void thread_init(void)
 	/* 글로블 스레드 컨텍스트 초기화 */
 	// binary semaphore로 초기화 및 기능 구현, 공유 자원 소유권 초기화
 	lock_init(&tid_lock);
-	list_init(&ready_list);
-	list_init(&sleep_list);
+	cpu_init(&cpus[0], 0);
+	list_init(&cpu_list);
+	list_init(&dirty_list);
+	load_avg = 0;
+	for (int i = 0; i < WHEEL_NEAR_SIZE; i++)
+		list_init(&wheel_near[i]);
+	for (int level = 0; level < WHEEL_LEVELS; level++)
+		for (int i = 0; i < WHEEL_LEVEL_SIZE; i++)
+			list_init(&wheel_outer[level][i]);
+	list_init(&wheel_far);
+	wheel_tick = 0;
 	list_init(&destruction_req);
+	list_init(&all_list);
 
 	/* Set up a thread structure for the running thread. */
 	/* 실행 중인 스레드에 대한 스레드 구조를 설정합니다. */
@@ -234,43 +287,56 @@ void thread_start(void)
 void thread_tick(void)
 {
 	struct thread *t = thread_current();
+	struct cpu *c = this_cpu();
 
 	/* Update statistics. */
 	/* 통계 업데이트. */
-	if (t == idle_thread)
-		idle_ticks++;
+	t->run_ticks++;
+	if (t == c->idle_thread)
+		c->idle_ticks++;
 #ifdef USERPROG
 	else if (t->pml4 != NULL)
-		user_ticks++;
+		c->user_ticks++;
 #endif
 	else
-		kernel_ticks++;
+		c->kernel_ticks++;
+
+	if (thread_mlfqs)
+		mlfqs_tick(t);
 
 	/* Enforce preemption. */
 	/* 선점 적용. */
-	if (++thread_ticks >= TIME_SLICE)
+	if (++c->thread_ticks >= TIME_SLICE)
 		intr_yield_on_return();
 }
 
+/* Advances the timing wheel up to TICKS and readies every
+   thread whose wake-up tick has been reached.  Called from the
+   timer interrupt. */
+/* 타이밍 휠을 TICKS까지 진행시키며 깨어날 시간이 된 모든 스레드를
+   ready 상태로 만듭니다. 타이머 인터럽트에서 호출됩니다. */
 void thread_wakeup(int64_t ticks)
 {
-	if (list_empty(&sleep_list))
-		return;
-	enum intr_level old_level;
-	struct thread *to_wakeup = list_entry(list_front(&sleep_list), struct thread, elem);
-	old_level = intr_disable();
-	while (to_wakeup->tick <= ticks)
+	enum intr_level old_level = intr_disable();
+
+	while (wheel_tick < ticks)
 	{
+		wheel_tick++;
+		int slot = wheel_tick & WHEEL_NEAR_MASK;
+		if (slot == 0)
+			wheel_cascade(0);
 
-		list_pop_front(&sleep_list);
-		// list_push_back (&ready_list, &to_wakeup->elem);
-		list_insert_ordered(&ready_list, &to_wakeup->elem, (list_less_func *)larger, NULL);
-		to_wakeup->status = THREAD_READY;
-		if (list_empty(&sleep_list))
-			return;
-		to_wakeup = list_entry(list_front(&sleep_list), struct thread, elem);
+		struct list *bucket = &wheel_near[slot];
+		while (!list_empty(bucket))
+		{
+			struct thread *t = list_entry(list_pop_front(bucket), struct thread, elem);
+			ASSERT(t->tick <= wheel_tick);
+			ready_push(t);
+			t->status = THREAD_READY;
+			t->ready_since = ticks;
+			t->wakeup_cycles = rdtsc();
+		}
 	}
-	// printf("%lld \n", to_wakeup->wakeup_tick);
 	intr_set_level(old_level);
 }
 
@@ -278,9 +344,115 @@ void thread_wakeup(int64_t ticks)
 /* 스레드 통계를 출력합니다. */
 void thread_print_stats(void)
 {
+	long long idle_ticks = 0, kernel_ticks = 0, user_ticks = 0;
+
+	for (int i = 0; i < ncpu; i++)
+	{
+		idle_ticks += cpus[i].idle_ticks;
+		kernel_ticks += cpus[i].kernel_ticks;
+		user_ticks += cpus[i].user_ticks;
+	}
 	printf("Thread: %lld idle ticks, %lld kernel ticks, %lld user ticks\n",
 		   idle_ticks, kernel_ticks, user_ticks);
+
+	if (thread_sched_stats)
+	{
+		printf("Wakeup latency (cycles):\n");
+		for (int b = 0; b < SCHED_LATENCY_BUCKETS; b++)
+		{
+			uint64_t cnt = 0;
+			for (int i = 0; i < ncpu; i++)
+				cnt += cpus[i].wakeup_latency[b];
+			if (cnt != 0)
+				printf("  >= 2^%-2d: %llu\n", b, cnt);
+		}
+	}
+}
+
+/* Copies the scheduler statistics of the thread with the given
+   TID into *STAT.  Returns false if there is no such thread. */
+/* 주어진 TID를 가진 스레드의 스케줄러 통계를 *STAT에 복사합니다.
+   그런 스레드가 없으면 false를 반환합니다. */
+bool thread_get_sched_stat(tid_t tid, struct sched_stat *stat)
+{
+	bool found = false;
+
+	memset(stat, 0, sizeof *stat);
+
+	enum intr_level old_level = intr_disable();
+	for (struct list_elem *e = list_begin(&all_list); e != list_end(&all_list); e = list_next(e))
+	{
+		struct thread *t = list_entry(e, struct thread, all_elem);
+		if (t->tid != tid)
+			continue;
+
+		stat->voluntary_switches = t->voluntary_switches;
+		stat->involuntary_switches = t->involuntary_switches;
+		stat->run_ticks = t->run_ticks;
+		stat->ready_ticks = t->ready_ticks;
+		if (t->status == THREAD_READY)
+			stat->ready_ticks += timer_ticks() - t->ready_since;
+		found = true;
+		break;
+	}
+	for (int i = 0; i < ncpu; i++)
+	{
+		stat->ready_threads += cpus[i].ready_cnt;
+		for (int b = 0; b < SCHED_LATENCY_BUCKETS; b++)
+			stat->wakeup_latency[b] += cpus[i].wakeup_latency[b];
+	}
+	intr_set_level(old_level);
+
+	return found;
+}
+
+#ifdef USERPROG
+/* Copies the resource usage of the thread with the given TID
+   into *USAGE, counting its resident and page-table pages from
+   its page map, less the mappings of the shared zero page.
+   Returns false if there is no such thread. */
+/* 주어진 TID를 가진 스레드의 자원 사용량을 *USAGE에 복사하며, 상주
+   페이지와 페이지 테이블 페이지는 그 페이지 맵에서 세되 공유 0
+   페이지의 매핑은 뺍니다. 그런 스레드가 없으면 false를 반환합니다. */
+bool thread_get_rusage(tid_t tid, struct rusage *usage)
+{
+	bool found = false;
+
+	memset(usage, 0, sizeof *usage);
+
+	/* Interrupts stay off during the walk so that the page map
+	   cannot be destroyed under us. */
+	/* 순회 도중 페이지 맵이 파괴되지 않도록 인터럽트를 끈 채로 둡니다. */
+	enum intr_level old_level = intr_disable();
+	for (struct list_elem *e = list_begin(&all_list); e != list_end(&all_list); e = list_next(e))
+	{
+		struct thread *t = list_entry(e, struct thread, all_elem);
+		if (t->tid != tid)
+			continue;
+
+		usage->minor_faults = t->minor_faults;
+		usage->major_faults = t->major_faults;
+		usage->swapped_pages = t->swapped_pages;
+		usage->zero_pages = t->zero_pages;
+		usage->zero_page_hits = t->zero_page_hits;
+		usage->read_bytes = t->read_bytes;
+		usage->write_bytes = t->write_bytes;
+		if (t->pml4 != NULL)
+		{
+			size_t user_pages, table_pages;
+
+			pml4_count_pages(t->pml4, &user_pages, &table_pages);
+			usage->resident_pages = user_pages - t->zero_pages;
+			usage->page_table_pages = table_pages;
+		}
+		found = true;
+		break;
+	}
+	intr_set_level(old_level);
+
+	return found;
 }
+#endif
 
 /* Creates a new kernel thread named NAME with the given initial
    PRIORITY, which executes FUNCTION passing AUX as the argument,
@@ -315,16 +487,36 @@ tid_t thread_create(const char *name, int priority,
 					thread_func *function, void *aux)
 {
 	ASSERT(function != NULL);
-	struct thread *t = palloc_get_page(PAL_ZERO); /* allocating one page */
-												  /* 페이지 할당 */
+	struct thread *t = thread_page_alloc(); /* allocating one page */
+											/* 페이지 할당 */
 
 	if (t == NULL)
 	{
 		return TID_ERROR;
 	}
+#ifdef USERPROG
+	struct file **fdt = fdt_alloc();
+	if (fdt == NULL)
+	{
+		thread_page_free(t);
+		return TID_ERROR;
+	}
+#endif
 
 	init_thread(t, name, priority);		 /* initialize thread structure */
 										 /* `struct thread` 초기화 */
+	if (thread_mlfqs)
+	{
+		/* New threads inherit nice and recent_cpu from their parent. */
+		/* 새 스레드는 부모의 nice와 recent_cpu를 물려받습니다. */
+		struct thread *parent = thread_current();
+		enum intr_level old_level = intr_disable();
+		t->nice = parent->nice;
+		t->recent_cpu = parent->recent_cpu;
+		mlfqs_activate(t);
+		mlfqs_update_priority(t);
+		intr_set_level(old_level);
+	}
 	tid_t tid = t->tid = allocate_tid(); /* allocate tid */
 										 /* tid 할당 */
 
@@ -341,12 +533,24 @@ tid_t thread_create(const char *name, int priority,
 	t->tf.cs = SEL_KCSEG;
 	t->tf.eflags = FLAG_IF;
 
-	t->fdt = palloc_get_multiple(PAL_ZERO & PAL_ASSERT, FDT_PAGES);
+#ifdef USERPROG
+	t->fdt = fdt;
 	t->fdt[0] = STDIN_FILENO;
 	t->fdt[1] = STDOUT_FILENO;
+	t->fdt_end = 2;
+#endif
 
 	// fork일 때만 자식 프로세스를 고려하면 잠재적 문제가 생길 수 있을 것으로 예상
-	list_push_back(&thread_current()->children, &t->child_elem);
+#ifdef USERPROG
+	/* Dying children unlink themselves with interrupts off. */
+	/* 죽는 자식은 인터럽트를 끈 채 스스로 연결을 끊습니다. */
+	{
+		enum intr_level old_level = intr_disable();
+		t->parent = thread_current();
+		list_push_back(&t->parent->children, &t->child_elem);
+		intr_set_level(old_level);
+	}
+#endif
 
 	/* Add to run queue. */
 	thread_unblock(t);
@@ -410,9 +614,11 @@ void thread_unblock(struct thread *t)
 
 	old_level = intr_disable();
 	ASSERT(t->status == THREAD_BLOCKED);
-	list_insert_ordered(&ready_list, &t->elem, (list_less_func *)larger, NULL);
+	ready_push(t);
 
 	t->status = THREAD_READY;
+	t->ready_since = timer_ticks();
+	t->wakeup_cycles = rdtsc();
 	intr_set_level(old_level);
 }
 
@@ -467,12 +673,37 @@ void thread_exit(void)
 #ifdef USERPROG
 	process_exit();
 #endif
+	malloc_thread_exit();
 
 	/* Just set our status to dying and schedule another process.
 	   We will be destroyed during the call to schedule_tail(). */
 	/* 상태를 dying으로 설정하고 다른 프로세스를 예약하세요.
 	   schedule_tail()을 호출하는 동안 소멸됩니다. */
 	intr_disable();
+	struct thread *curr = thread_current();
+#ifdef USERPROG
+	/* No one waits for our children any more: free those that
+	   already exited and let the others free themselves.  If our
+	   parent cannot wait for us, leave its list; if it can, our page
+	   stays until it reaps us. */
+	/* 더 이상 자식을 기다릴 스레드가 없으므로 이미 종료된 자식은 해제하고
+	   나머지는 스스로 해제하게 합니다. 부모가 우리를 기다릴 수 없으면
+	   부모의 리스트에서 빠지고, 기다릴 수 있으면 부모가 회수할 때까지
+	   페이지를 남겨 둡니다. */
+	while (!list_empty(&curr->children))
+		thread_reap(list_entry(list_pop_front(&curr->children),
+							   struct thread, child_elem));
+	if (curr->parent != NULL && !curr->reapable)
+	{
+		list_remove(&curr->child_elem);
+		curr->parent = NULL;
+	}
+#endif
+	if (curr->cpu_active)
+		list_remove(&curr->cpu_elem);
+	if (curr->dirty)
+		list_remove(&curr->dirty_elem);
+	list_remove(&curr->all_elem);
 	do_schedule(THREAD_DYING);
 	NOT_REACHED();
 }
@@ -491,11 +722,11 @@ void thread_yield(void)
 	// running 상태인 thread를 지역 변수 curr에 할당
 	struct thread *curr = thread_current();
 
-	if (curr != idle_thread)
+	if (curr != this_cpu()->idle_thread)
 	{
-		// ready_list의 제일 뒤에 보냄
-		// list_push_back (&ready_list, &curr->elem);
-		list_insert_ordered(&ready_list, &curr->elem, (list_less_func *)larger, NULL);
+		// 같은 우선순위 큐의 제일 뒤에 보냄
+		ready_push(curr);
+		curr->ready_since = timer_ticks();
 	}
 
 	// ready 상태로 바꿔줌
@@ -505,6 +736,17 @@ void thread_yield(void)
 	intr_set_level(old_level);
 }
 
+/* Yields the CPU on the way out of an interrupt handler that
+   called intr_yield_on_return(), counting the switch, if there is
+   one, as involuntary. */
+/* intr_yield_on_return()을 호출한 인터럽트 처리기에서 나가는 길에
+   CPU를 양보하며, 전환이 일어나면 비자발적 전환으로 셉니다. */
+void thread_preempt(void)
+{
+	thread_current()->preempted = true;
+	thread_yield();
+}
+
 // 추후 Project1 완료 후 성능 Test를 위해 백업 - Hyeonwoo, 2024.03.06
 // void thread_yield(void)
 // {
@@ -595,17 +837,19 @@ void thread_yield(void)
 // 	}
 // }
 
+/* Blocks the current thread until timer tick TICKS. */
+/* 현재 스레드를 타이머 틱 TICKS까지 블록합니다. */
 void thread_sleep(int64_t ticks)
 {
 	struct thread *curr = thread_current();
 	enum intr_level old_level;
 	old_level = intr_disable();
-	if (curr != idle_thread)
+	if (curr != this_cpu()->idle_thread)
 	{
 		curr->status = THREAD_BLOCKED;
-		curr->tick = ticks;
-		// list_push_back (&sleep_list, &curr->elem);
-		list_insert_ordered(&sleep_list, &curr->elem, (list_less_func *)local_tick, NULL);
+		// 이미 처리한 틱이면 다음 틱에 깨웁니다.
+		curr->tick = ticks > wheel_tick ? ticks : wheel_tick + 1;
+		wheel_insert(curr);
 	}
 	schedule();
 	intr_set_level(old_level);
@@ -619,14 +863,56 @@ void thread_set_priority(int new_priority)
 	// TODO: Reorder the ready_list.
 	// TODO: 현재 스레드의 우선순위를 설정합니다.
 	// TODO: ready_list의 순서를 바꿉니다.
-	thread_current()->origin_priority = new_priority;
-	if (list_empty(&thread_current()->donations))
-		thread_current()->priority = new_priority;
+	struct thread *curr = thread_current();
+
+	/* The MLFQS scheduler computes priorities by itself. */
+	/* MLFQS 스케줄러는 우선순위를 스스로 계산합니다. */
+	if (thread_mlfqs)
+		return;
+
+	enum intr_level old_level = intr_disable();
 
-	if (!list_empty(&ready_list) && list_entry(list_front(&ready_list), struct thread, elem)->priority > new_priority)
+	curr->origin_priority = new_priority;
+	curr->priority = new_priority > donation_priority(curr) ? new_priority : donation_priority(curr);
+
+	bool preempt = ready_max_priority() > curr->priority;
+	intr_set_level(old_level);
+
+	if (preempt)
 		thread_yield();
 }
 
+/* Changes T's effective priority to PRIORITY.  If T is in the
+   ready queues, it is moved to the tail of the queue for its new
+   priority; if it waits on a semaphore or condition variable,
+   its key there is updated in place.  Used by priority donation
+   in synch.c and by the MLFQS scheduler. */
+/* T의 유효 우선순위를 PRIORITY로 바꿉니다. T가 ready 큐에 있다면
+   새 우선순위 큐의 맨 뒤로 옮기고, 세마포어나 조건 변수를 기다리고
+   있다면 그 대기 힙의 키를 제자리에서 갱신합니다. synch.c의 우선순위
+   기부와 MLFQS 스케줄러에서 사용합니다. */
+void thread_change_priority(struct thread *t, int priority)
+{
+	ASSERT(is_thread(t));
+	ASSERT(PRI_MIN <= priority && priority <= PRI_MAX);
+
+	enum intr_level old_level = intr_disable();
+	int old_priority = t->priority;
+	if (old_priority != priority)
+	{
+		if (t->status == THREAD_READY)
+		{
+			ready_remove(t);
+			t->priority = priority;
+			ready_push(t);
+		}
+		else
+			t->priority = priority;
+		waiter_priority_changed(t, old_priority);
+	}
+	intr_set_level(old_level);
+}
+
 /* Returns the current thread's priority. */
 /* 현재 스레드의 우선순위를 반환합니다. */
 int thread_get_priority(void)
@@ -636,33 +922,167 @@ int thread_get_priority(void)
 
 /* Sets the current thread's nice value to NICE. */
 /* 현재 스레드의 nice 값을 NICE로 설정합니다. */
-void thread_set_nice(int nice UNUSED)
+void thread_set_nice(int nice)
 {
-	/* TODO: Your implementation goes here */
+	struct thread *curr = thread_current();
+
+	if (nice < NICE_MIN)
+		nice = NICE_MIN;
+	else if (nice > NICE_MAX)
+		nice = NICE_MAX;
+
+	enum intr_level old_level = intr_disable();
+	curr->nice = nice;
+	mlfqs_activate(curr);
+	mlfqs_update_priority(curr);
+	bool preempt = ready_max_priority() > curr->priority;
+	intr_set_level(old_level);
+
+	if (preempt)
+		thread_yield();
 }
 
 /* Returns the current thread's nice value. */
 /* 현재 스레드의 nice 값을 반환합니다. */
 int thread_get_nice(void)
 {
-	/* TODO: Your implementation goes here */
-	return 0;
+	return thread_current()->nice;
 }
 
 /* Returns 100 times the system load average. */
 /* 시스템 부하 평균의 100배를 반환합니다. */
 int thread_get_load_avg(void)
 {
-	/* TODO: Your implementation goes here */
-	return 0;
+	enum intr_level old_level = intr_disable();
+	int result = fp_round(fp_mul_int(load_avg, 100));
+	intr_set_level(old_level);
+	return result;
 }
 
 /* Returns 100 times the current thread's recent_cpu value. */
 /* 현재 스레드의 recent_cpu 값의 100배를 반환합니다. */
 int thread_get_recent_cpu(void)
 {
-	/* TODO: Your implementation goes here */
-	return 0;
+	enum intr_level old_level = intr_disable();
+	int result = fp_round(fp_mul_int(thread_current()->recent_cpu, 100));
+	intr_set_level(old_level);
+	return result;
+}
+
+/* Per-tick MLFQS bookkeeping for the running thread T.  Called
+   from the timer interrupt. */
+/* 실행 중인 스레드 T에 대한 틱마다의 MLFQS 처리입니다.
+   타이머 인터럽트에서 호출됩니다. */
+static void mlfqs_tick(struct thread *t)
+{
+	int64_t ticks = timer_ticks();
+
+	if (t != this_cpu()->idle_thread)
+	{
+		t->recent_cpu = fp_add_int(t->recent_cpu, 1);
+		mlfqs_activate(t);
+		mlfqs_mark_dirty(t);
+	}
+
+	if (ticks % TIMER_FREQ == 0)
+		mlfqs_decay();
+
+	if (ticks % PRI_RECALC_TICKS == 0)
+	{
+		while (!list_empty(&dirty_list))
+		{
+			struct thread *d = list_entry(list_pop_front(&dirty_list), struct thread, dirty_elem);
+			d->dirty = false;
+			mlfqs_update_priority(d);
+		}
+		if (ready_max_priority() > t->priority)
+			intr_yield_on_return();
+	}
+}
+
+/* Updates load_avg and decays recent_cpu of every thread in
+   cpu_list, once per second. */
+/* 1초에 한 번 load_avg를 갱신하고 cpu_list에 있는 모든 스레드의
+   recent_cpu를 감쇠시킵니다. */
+static void mlfqs_decay(void)
+{
+	int ready_threads = 0;
+	for (int i = 0; i < ncpu; i++)
+		ready_threads += cpus[i].ready_cnt;
+	ready_threads += thread_current() != this_cpu()->idle_thread ? 1 : 0;
+
+	load_avg = fp_add(fp_div_int(fp_mul_int(load_avg, 59), 60),
+					  fp_div_int(fp_from_int(ready_threads), 60));
+
+	fixed_t twice_load = fp_mul_int(load_avg, 2);
+	fixed_t coef = fp_div(twice_load, fp_add_int(twice_load, 1));
+
+	struct list_elem *e = list_begin(&cpu_list);
+	while (e != list_end(&cpu_list))
+	{
+		struct thread *t = list_entry(e, struct thread, cpu_elem);
+		e = list_next(e);
+
+		t->recent_cpu = fp_add_int(fp_mul(coef, t->recent_cpu), t->nice);
+		if (t->recent_cpu == 0 && t->nice == 0)
+		{
+			list_remove(&t->cpu_elem);
+			t->cpu_active = false;
+		}
+		mlfqs_update_priority(t);
+	}
+}
+
+/* Recomputes T's priority from its recent_cpu and nice, moving T
+   to its new ready queue if it is ready.  Interrupts must be off. */
+/* recent_cpu와 nice로 T의 우선순위를 다시 계산하고, T가 ready 상태라면
+   새 ready 큐로 옮깁니다. 인터럽트가 꺼져 있어야 합니다. */
+static void mlfqs_update_priority(struct thread *t)
+{
+	ASSERT(intr_get_level() == INTR_OFF);
+
+	if (t == this_cpu()->idle_thread)
+		return;
+
+	int priority = PRI_MAX - fp_to_int(fp_div_int(t->recent_cpu, 4)) - t->nice * 2;
+	if (priority < PRI_MIN)
+		priority = PRI_MIN;
+	else if (priority > PRI_MAX)
+		priority = PRI_MAX;
+
+	t->origin_priority = priority;
+	if (t->priority != priority)
+		thread_change_priority(t, priority);
+}
+
+/* Adds T to cpu_list if its recent_cpu or nice is nonzero.
+   Interrupts must be off. */
+/* recent_cpu나 nice가 0이 아니면 T를 cpu_list에 추가합니다.
+   인터럽트가 꺼져 있어야 합니다. */
+static void mlfqs_activate(struct thread *t)
+{
+	ASSERT(intr_get_level() == INTR_OFF);
+
+	if (!t->cpu_active && (t->recent_cpu != 0 || t->nice != 0))
+	{
+		list_push_back(&cpu_list, &t->cpu_elem);
+		t->cpu_active = true;
+	}
+}
+
+/* Queues T for priority recomputation at the next update.
+   Interrupts must be off. */
+/* 다음 갱신 때 우선순위를 다시 계산하도록 T를 대기열에 넣습니다.
+   인터럽트가 꺼져 있어야 합니다. */
+static void mlfqs_mark_dirty(struct thread *t)
+{
+	ASSERT(intr_get_level() == INTR_OFF);
+
+	if (!t->dirty)
+	{
+		list_push_back(&dirty_list, &t->dirty_elem);
+		t->dirty = true;
+	}
 }
 
 /* Idle thread.  Executes when no other thread is ready to run.
@@ -686,7 +1106,7 @@ static void idle(void *idle_started_ UNUSED)
 {
 	struct semaphore *idle_started = idle_started_;
 
-	idle_thread = thread_current();
+	this_cpu()->idle_thread = thread_current();
 	sema_up(idle_started);
 
 	for (;;)
@@ -696,6 +1116,19 @@ static void idle(void *idle_started_ UNUSED)
 		intr_disable();
 		thread_block();
 
+		/* While nothing else is ready, zero free pages ahead of
+		   PAL_ZERO requests, one page at a time so that a thread
+		   woken meanwhile is not kept waiting. */
+		/* 다른 준비된 스레드가 없는 동안 PAL_ZERO 요청에 대비해 가용
+		   페이지를 0으로 채웁니다. 그동안 깨어난 스레드가 기다리지
+		   않도록 한 번에 한 페이지씩 처리합니다. */
+		intr_enable();
+		while (this_cpu()->ready_cnt == 0 && palloc_zero_idle())
+			continue;
+		intr_disable();
+		if (this_cpu()->ready_cnt > 0)
+			continue;
+
 		/* Re-enable interrupts and wait for the next one.
 
 		   The `sti' instruction disables interrupts until the
@@ -753,6 +1186,9 @@ static void init_thread(struct thread *t, const char *name, int priority)
 	strlcpy(t->name, name, sizeof t->name);
 	// for switching
 	t->tf.rsp = (uint64_t)t + PGSIZE - sizeof(void *);
+	// MLFQS에서는 nice와 recent_cpu가 0인 스레드의 우선순위가 PRI_MAX입니다.
+	if (thread_mlfqs)
+		priority = PRI_MAX;
 	t->priority = priority;
 	// 현재 대기하고 있는 락을 가리키는 포인터이므로,
 	// 초기에는 어떤 락에도 대기하지 않는 상태(NULL)로 설정
@@ -760,7 +1196,11 @@ static void init_thread(struct thread *t, const char *name, int priority)
 	t->next_fd = 3;
 	// for checking stackover flow
 	t->magic = THREAD_MAGIC;
-	list_init(&t->donations);
+	donation_init(t);
+
+	enum intr_level old_level = intr_disable();
+	list_push_back(&all_list, &t->all_elem);
+	intr_set_level(old_level);
 
 #ifdef USERPROG
 	list_init(&t->children);
@@ -782,12 +1222,136 @@ static void init_thread(struct thread *t, const char *name, int priority)
    실행 대기열이 비어 있으면 idle_thread를 반환합니다. */
 static struct thread *next_thread_to_run(void)
 {
-	if (list_empty(&ready_list))
-		// ready_list가 비어있을 때 반환
-		return idle_thread;
+	struct cpu *c = this_cpu();
+	struct thread *t;
+
+	spin_lock(&c->rq_lock);
+	if (c->ready_mask == 0)
+		// ready 큐가 모두 비어있을 때 반환
+		t = c->idle_thread;
 	else
-		// ready_list의 첫 스레드(요소) 반환
-		return list_entry(list_pop_front(&ready_list), struct thread, elem);
+	{
+		// 가장 높은 우선순위 큐의 첫 스레드(요소) 반환
+		int priority = 63 - __builtin_clzll(c->ready_mask);
+		t = list_entry(list_pop_front(&c->ready_queues[priority]), struct thread, elem);
+		c->ready_cnt--;
+		if (list_empty(&c->ready_queues[priority]))
+			c->ready_mask &= ~(1ULL << priority);
+	}
+	spin_unlock(&c->rq_lock);
+	return t;
+}
+
+/* Appends T to the tail of the run queue for its priority on the
+   running CPU.  Interrupts must be off. */
+/* T를 실행 중인 CPU에서 우선순위에 해당하는 실행 대기열의 맨 뒤에
+   넣습니다. 인터럽트가 꺼져 있어야 합니다. */
+static void ready_push(struct thread *t)
+{
+	struct cpu *c = this_cpu();
+
+	ASSERT(intr_get_level() == INTR_OFF);
+	ASSERT(PRI_MIN <= t->priority && t->priority <= PRI_MAX);
+
+	spin_lock(&c->rq_lock);
+	list_push_back(&c->ready_queues[t->priority], &t->elem);
+	c->ready_mask |= 1ULL << t->priority;
+	c->ready_cnt++;
+	spin_unlock(&c->rq_lock);
+}
+
+/* Removes T, which must be queued at its current priority, from
+   the run queues.  Interrupts must be off. */
+/* 현재 우선순위의 큐에 들어 있는 T를 실행 대기열에서 제거합니다.
+   인터럽트가 꺼져 있어야 합니다. */
+static void ready_remove(struct thread *t)
+{
+	struct cpu *c = this_cpu();
+
+	ASSERT(intr_get_level() == INTR_OFF);
+
+	spin_lock(&c->rq_lock);
+	list_remove(&t->elem);
+	c->ready_cnt--;
+	if (list_empty(&c->ready_queues[t->priority]))
+		c->ready_mask &= ~(1ULL << t->priority);
+	spin_unlock(&c->rq_lock);
+}
+
+/* Returns the highest priority that has a ready thread on the
+   running CPU, or PRI_MIN - 1 if its run queues are empty.  The
+   most significant set bit of ready_mask is found in one
+   instruction. */
+/* 실행 중인 CPU에서 ready 스레드가 있는 가장 높은 우선순위를 반환하고,
+   실행 대기열이 비어 있으면 PRI_MIN - 1을 반환합니다. ready_mask에서
+   가장 높은 켜진 비트를 명령어 하나로 찾습니다. */
+static int ready_max_priority(void)
+{
+	uint64_t mask = this_cpu()->ready_mask;
+
+	if (mask == 0)
+		return PRI_MIN - 1;
+	return 63 - __builtin_clzll(mask);
+}
+
+/* Files sleeping thread T into the wheel slot for T->tick,
+   which must not be earlier than wheel_tick.  Interrupts must
+   be off. */
+/* 잠든 스레드 T를 T->tick에 해당하는 휠 슬롯에 넣습니다. T->tick은
+   wheel_tick보다 이르면 안 됩니다. 인터럽트가 꺼져 있어야 합니다. */
+static void wheel_insert(struct thread *t)
+{
+	ASSERT(intr_get_level() == INTR_OFF);
+	ASSERT(t->tick >= wheel_tick);
+
+	int64_t delta = t->tick - wheel_tick;
+
+	if (delta < WHEEL_NEAR_SIZE)
+	{
+		list_push_back(&wheel_near[t->tick & WHEEL_NEAR_MASK], &t->elem);
+		return;
+	}
+	for (int level = 0; level < WHEEL_LEVELS; level++)
+		if (delta < (1LL << WHEEL_SHIFT(level + 1)))
+		{
+			int slot = (t->tick >> WHEEL_SHIFT(level)) & WHEEL_LEVEL_MASK;
+			list_push_back(&wheel_outer[level][slot], &t->elem);
+			return;
+		}
+	list_push_back(&wheel_far, &t->elem);
+}
+
+/* Moves the threads in LEVEL's current slot down to the finer
+   levels, after first cascading LEVEL + 1 if LEVEL has just
+   wrapped around.  Interrupts must be off. */
+/* LEVEL이 방금 한 바퀴 돌았다면 먼저 LEVEL + 1을 내려보낸 뒤, LEVEL의
+   현재 슬롯에 있는 스레드들을 더 세밀한 레벨로 옮깁니다.
+   인터럽트가 꺼져 있어야 합니다. */
+static void wheel_cascade(int level)
+{
+	int slot = (wheel_tick >> WHEEL_SHIFT(level)) & WHEEL_LEVEL_MASK;
+	struct list moved;
+
+	if (slot == 0)
+	{
+		if (level + 1 < WHEEL_LEVELS)
+			wheel_cascade(level + 1);
+		else
+		{
+			list_init(&moved);
+			while (!list_empty(&wheel_far))
+				list_push_back(&moved, list_pop_front(&wheel_far));
+			while (!list_empty(&moved))
+				wheel_insert(list_entry(list_pop_front(&moved), struct thread, elem));
+		}
+	}
+
+	struct list *bucket = &wheel_outer[level][slot];
+	list_init(&moved);
+	while (!list_empty(bucket))
+		list_push_back(&moved, list_pop_front(bucket));
+	while (!list_empty(&moved))
+		wheel_insert(list_entry(list_pop_front(&moved), struct thread, elem));
 }
 
 /* Use iretq to launch the thread */
@@ -916,13 +1480,53 @@ static void do_schedule(int status)
 	while (!list_empty(&destruction_req))
 	{
 		struct thread *victim = list_entry(list_pop_front(&destruction_req), struct thread, elem);
-		palloc_free_page(victim);
+#ifdef USERPROG
+		/* Its parent may still read it, and frees it when it reaps it. */
+		/* 부모가 아직 읽을 수 있으므로 부모가 회수할 때 해제합니다. */
+		if (victim->parent != NULL)
+		{
+			victim->zombie = true;
+			continue;
+		}
+#endif
+		thread_page_free(victim);
 	}
 
 	thread_current()->status = status;
 	schedule();
 }
 
+/* Updates the scheduler statistics for a switch from CURR to
+   NEXT: CURR's switch count, the ticks NEXT waited ready and, if
+   NEXT was just woken, its wakeup latency. */
+/* CURR에서 NEXT로의 전환에 대한 스케줄러 통계를 갱신합니다. CURR의
+   전환 횟수, NEXT가 ready로 기다린 틱, 그리고 NEXT가 방금 깨어났다면
+   깨어남 지연을 기록합니다. */
+static void account_switch(struct thread *curr, struct thread *next)
+{
+	if (curr != next)
+	{
+		if (curr->preempted)
+			curr->involuntary_switches++;
+		else
+			curr->voluntary_switches++;
+	}
+	curr->preempted = false;
+
+	if (next == this_cpu()->idle_thread)
+		return;
+	next->ready_ticks += timer_ticks() - next->ready_since;
+	if (next->wakeup_cycles != 0)
+	{
+		uint64_t cycles = rdtsc() - next->wakeup_cycles;
+		int bucket = cycles != 0 ? 63 - __builtin_clzll(cycles) : 0;
+		if (bucket >= SCHED_LATENCY_BUCKETS)
+			bucket = SCHED_LATENCY_BUCKETS - 1;
+		this_cpu()->wakeup_latency[bucket]++;
+		next->wakeup_cycles = 0;
+	}
+}
+
 // context switching
 /* OS에서 context는 CPU가 해당 프로세스를 실행하기 위한 해당 프로세스의
  * 정보들입니다. 이 Context는 프로세스의 PCB에 저장됩니다. Context Swithcing
@@ -946,7 +1550,8 @@ static void schedule(void)
 
 	/* Start new time slice. */
 	/* 새 타임슬라이스 시작. */
-	thread_ticks = 0;
+	this_cpu()->thread_ticks = 0;
+	account_switch(curr, next);
 
 #ifdef USERPROG
 	/* Activate the new address space. */
@@ -989,14 +1594,149 @@ static void schedule(void)
 static tid_t allocate_tid(void)
 {
 	static tid_t next_tid = 1;
+	tid_t tid;
 
 	lock_acquire(&tid_lock);
-	tid_t tid = ++next_tid;
+	if (free_tid_cnt == TID_CACHE_MAX)
+	{
+		tid = free_tids[free_tid_head];
+		free_tid_head = (free_tid_head + 1) % TID_CACHE_MAX;
+		free_tid_cnt--;
+	}
+	else
+		tid = ++next_tid;
 	lock_release(&tid_lock);
 
 	return tid;
 }
 
+/* Makes TID available to allocate_tid() again.  Called once
+   nothing can refer to TID any more, that is, after the parent
+   has reaped the thread that had it.  Tids that do not fit in
+   the bounded ring are simply never reused. */
+/* TID를 allocate_tid()가 다시 쓸 수 있게 합니다. 더 이상 아무것도
+   TID를 참조할 수 없을 때, 즉 부모가 그 TID를 가진 스레드를 회수한
+   뒤에 호출합니다. 크기가 제한된 링에 들어가지 못한 tid는 다시 쓰지
+   않습니다. */
+void thread_release_tid(tid_t tid)
+{
+	ASSERT(tid != TID_ERROR);
+
+	lock_acquire(&tid_lock);
+	if (free_tid_cnt < TID_CACHE_MAX)
+		free_tids[(free_tid_head + free_tid_cnt++) % TID_CACHE_MAX] = tid;
+	lock_release(&tid_lock);
+}
+
+#ifdef USERPROG
+/* Drops the parent's claim on CHILD, which the caller has already
+   removed from the parent's children list.  Frees CHILD's page if
+   it has exited, otherwise CHILD frees it itself when it does.
+   Must be called with interrupts off.  CHILD may not be touched
+   afterward. */
+/* 부모가 CHILD에 대해 가진 권리를 포기합니다. 호출자는 이미 CHILD를
+   부모의 자식 리스트에서 제거했어야 합니다. CHILD가 종료했으면 그
+   페이지를 해제하고, 아니면 CHILD가 종료할 때 스스로 해제합니다.
+   인터럽트가 꺼진 상태에서 호출해야 하며, 이후 CHILD에 접근하면 안
+   됩니다. */
+void thread_reap(struct thread *child)
+{
+	ASSERT(intr_get_level() == INTR_OFF);
+
+	child->parent = NULL;
+	if (child->zombie)
+		thread_page_free(child);
+}
+#endif
+
+/* Returns a page for a new thread, from this CPU's cache of dead
+   threads' pages if it has one.  init_thread() clears the
+   struct thread, and the stack needs no clearing, so unlike a
+   fresh page a cached one is not zeroed. */
+/* 새 스레드를 위한 페이지를 반환합니다. 이 CPU에 죽은 스레드의
+   페이지 캐시가 있으면 거기서 가져옵니다. init_thread()가 struct
+   thread를 지우고 스택은 지울 필요가 없으므로, 캐시된 페이지는 새
+   페이지와 달리 0으로 채우지 않습니다. */
+static struct thread *thread_page_alloc(void)
+{
+	void *page = NULL;
+
+	enum intr_level old_level = intr_disable();
+	struct cpu *c = this_cpu();
+	if (c->thread_page_cnt > 0)
+		page = c->thread_pages[--c->thread_page_cnt];
+	intr_set_level(old_level);
+
+	return page != NULL ? page : palloc_get_page(0);
+}
+
+/* Returns thread page PAGE to this CPU's cache, or to the page
+   allocator if the cache is full. */
+/* 스레드 페이지 PAGE를 이 CPU의 캐시에, 캐시가 가득 찼으면 페이지
+   할당자에 돌려줍니다. */
+static void thread_page_free(void *page)
+{
+	enum intr_level old_level = intr_disable();
+	struct cpu *c = this_cpu();
+	if (c->thread_page_cnt < THREAD_CACHE_MAX)
+	{
+		c->thread_pages[c->thread_page_cnt++] = page;
+		page = NULL;
+	}
+	intr_set_level(old_level);
+
+	if (page != NULL)
+		palloc_free_page(page);
+}
+
+#ifdef USERPROG
+/* Returns an all-NULL file descriptor table of FDT_PAGES pages,
+   from this CPU's cache if it has one, or NULL if memory is
+   exhausted. */
+/* 모든 항목이 NULL인 FDT_PAGES 페이지 크기의 파일 디스크립터 테이블을
+   반환합니다. 이 CPU의 캐시에 있으면 거기서 가져오며, 메모리가
+   부족하면 NULL을 반환합니다. */
+struct file **fdt_alloc(void)
+{
+	struct file **fdt = NULL;
+
+	enum intr_level old_level = intr_disable();
+	struct cpu *c = this_cpu();
+	if (c->fdt_cnt > 0)
+		fdt = c->fdts[--c->fdt_cnt];
+	intr_set_level(old_level);
+
+	return fdt != NULL ? fdt : palloc_get_multiple(PAL_ZERO, FDT_PAGES);
+}
+
+/* Frees file descriptor table FDT, none of whose entries at or
+   past END were ever set.  Only the first END entries are
+   cleared before FDT goes back to this CPU's cache. */
+/* END 이후의 항목은 한 번도 설정된 적이 없는 파일 디스크립터 테이블
+   FDT를 해제합니다. 이 CPU의 캐시로 돌려주기 전에 처음 END개의
+   항목만 지웁니다. */
+void fdt_free(struct file **fdt, int end)
+{
+	ASSERT(0 <= end && end <= FDT_SIZE);
+
+	if (fdt == NULL)
+		return;
+	memset(fdt, 0, end * sizeof *fdt);
+
+	enum intr_level old_level = intr_disable();
+	struct cpu *c = this_cpu();
+	if (c->fdt_cnt < FDT_CACHE_MAX)
+	{
+		c->fdts[c->fdt_cnt++] = fdt;
+		fdt = NULL;
+	}
+	intr_set_level(old_level);
+
+	if (fdt != NULL)
+		palloc_free_multiple(fdt, FDT_PAGES);
+}
+#endif
+
 bool compare_priority(const struct list_elem *a_, const struct list_elem *b_,
 					  void *aux UNUSED)
 {
@@ -1008,6 +1748,6 @@ bool compare_priority(const struct list_elem *a_, const struct list_elem *b_,
 
 void thread_try_yield(void)
 {
-	if (!list_empty(&ready_list) && thread_current() != idle_thread && !intr_context())
+	if (this_cpu()->ready_mask != 0 && thread_current() != this_cpu()->idle_thread && !intr_context())
 		thread_yield();
 }
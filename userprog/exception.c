@@ -204,9 +204,19 @@ static void page_fault(struct intr_frame *f)
 	user = (f->error_code & PF_U) != 0;
 
 #ifdef VM
-	/* For project 3 and later. */
+	/* For project 3 and later.  A fault is major if the handler
+	   counted it so because it had to read the page from disk;
+	   otherwise it is minor. */
+	/* 프로젝트 3 이후용. 처리기가 디스크에서 페이지를 읽어야 해서
+	   major로 센 오류는 major이고, 그 밖에는 minor입니다. */
+	struct thread *curr = thread_current();
+	uint64_t major_faults = curr->major_faults;
 	if (vm_try_handle_fault(f, fault_addr, user, write, not_present))
+	{
+		if (curr->major_faults == major_faults)
+			curr->minor_faults++;
 		return;
+	}
 #endif
 
 	/* Count page faults. */
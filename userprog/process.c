@@ -11,6 +11,7 @@
 #include "threads/flags.h"
 #include "threads/init.h"
 #include "threads/interrupt.h"
+#include "threads/malloc.h"
 #include "threads/mmu.h"
 #include "threads/palloc.h"
 #include "threads/thread.h"
@@ -24,6 +25,7 @@
 #endif
 
 static void process_cleanup(void);
+static void print_rusage(void);
 static bool load(const char *file_name, struct intr_frame *if_);
 static void initd(void *f_name);
 static void __do_fork(void *);
@@ -31,6 +33,10 @@ static void __do_fork(void *);
 // main thread (tid == 1)
 static struct thread *main_thread;
 
+/* If true, print_rusage() runs at every process exit. */
+/* true이면 모든 프로세스 종료 시 print_rusage()를 실행합니다. */
+bool process_rusage;
+
 /* General process initializer for initd and other process. */
 /* initd 및 기타 프로세스를 위한 일반 프로세스 초기화 프로그램입니다. */
 static void process_init(void)
@@ -85,6 +91,9 @@ tid_t process_create_initd(const char *file_name)
 /* 첫 번째 사용자 프로세스를 실행하는 스레드 함수입니다. */
 static void initd(void *f_name)
 {
+	/* 부모가 기다릴 수 있으므로 종료 후에도 회수될 때까지 남는다 */
+	thread_current()->reapable = true;
+
 #ifdef VM
 	supplemental_page_table_init(&thread_current()->spt);
 #endif
@@ -116,6 +125,9 @@ struct thread *get_child_by_tid(struct thread *curr, tid_t child_tid)
 {
 	struct thread *child = NULL;
 
+	/* 죽는 자식이 리스트에서 스스로 빠지므로 인터럽트를 끄고 순회 */
+	enum intr_level old_level = intr_disable();
+
 	/* 해당 자식 프로세스를 찾기 위해 현재 프로세스의 자식 리스트를 순회 */
 	for (struct list_elem *e = list_begin(&curr->children); e != list_end(&curr->children); e = list_next(e))
 	{
@@ -127,6 +139,7 @@ struct thread *get_child_by_tid(struct thread *curr, tid_t child_tid)
 			break;
 		}
 	}
+	intr_set_level(old_level);
 
 	return child;
 }
@@ -319,6 +332,9 @@ static void __do_fork(void *aux)
 	struct intr_frame *parent_if = &parent->parent_if;
 	bool succ = true;
 
+	/* 부모가 기다릴 수 있으므로 종료 후에도 회수될 때까지 남는다 */
+	current->reapable = true;
+
 	/* 1. CPU 컨텍스트를 로컬 스택으로 읽습니다. */
 	memcpy(&if_, parent_if, sizeof(struct intr_frame));
 
@@ -424,7 +440,8 @@ static void __do_fork(void *aux)
 	current->fdt[0] = parent->fdt[0];
 	current->fdt[1] = parent->fdt[1];
 
-	while (idx < FDT_SIZE)
+	/* 부모가 사용한 적 있는 fd까지만 복제하면 된다 */
+	while (idx < parent->fdt_end)
 	{
 		if (parent->fdt[idx] != NULL)
 		{
@@ -433,6 +450,7 @@ static void __do_fork(void *aux)
 
 		idx++;
 	}
+	current->fdt_end = parent->fdt_end;
 
 	// lock_release(&filesys_lock);
 
@@ -583,16 +601,22 @@ int process_wait(tid_t child_tid)
 	/* 자식 프로세스가 종료될 때까지 대기 */
 	sema_down(&child->child_wait_sema);
 
-	/* 자식 프로세스를 부모의 자식 리스트에서 제거 */
-	list_remove(&child->child_elem);
+	int status = child->exit_status;
 
-	/* 자식 프로세스의 메모리를 해제 */
-	// palloc_free_page(child);
+	/* 자식 프로세스를 부모의 자식 리스트에서 제거하고 회수한다.
+	 * 이미 죽은 자식이면 여기서 페이지가 해제되므로 이후 child에 접근하지 않는다 */
+	enum intr_level old_level = intr_disable();
+	list_remove(&child->child_elem);
+	thread_reap(child);
+	intr_set_level(old_level);
 
 	// sema_up(&child->exit_sema);
 
+	/* 회수한 자식의 tid는 이제 다른 스레드가 재사용할 수 있다 */
+	thread_release_tid(child_tid);
+
 	/* 자식 프로세스의 종료 상태를 반환 */
-	return child->exit_status;
+	return status;
 }
 
 /* Exit the process. This function is called by thread_exit (). */
@@ -620,15 +644,39 @@ void process_exit(void)
 	file_close(curr->loading_file);
 	curr->loading_file = NULL;
 
-	palloc_free_multiple(curr->fdt, FDT_PAGES);
+	fdt_free(curr->fdt, curr->fdt_end);
 	curr->fdt = NULL;
 
+	/* 페이지 맵이 사라지기 전에 자원 사용량을 출력 */
+	if (process_rusage && curr->pml4 != NULL)
+		print_rusage();
+
 	/* 프로세스의 리소스를 정리하기 위해 process_cleanup() 함수 호출 */
 	process_cleanup();
 
 	sema_up(&curr->child_wait_sema);
 }
 
+/* Prints the resource usage of the current process as a table. */
+/* 현재 프로세스의 자원 사용량을 표로 출력합니다. */
+static void print_rusage(void)
+{
+	struct rusage usage;
+
+	if (!thread_get_rusage(thread_tid(), &usage))
+		return;
+	printf("%s: rusage\n", thread_name());
+	printf("  %-18s %10llu\n", "minor faults", usage.minor_faults);
+	printf("  %-18s %10llu\n", "major faults", usage.major_faults);
+	printf("  %-18s %10llu\n", "resident pages", usage.resident_pages);
+	printf("  %-18s %10llu\n", "page table pages", usage.page_table_pages);
+	printf("  %-18s %10llu\n", "swapped pages", usage.swapped_pages);
+	printf("  %-18s %10llu\n", "zero pages", usage.zero_pages);
+	printf("  %-18s %10llu\n", "zero page hits", usage.zero_page_hits);
+	printf("  %-18s %10llu\n", "file bytes read", usage.read_bytes);
+	printf("  %-18s %10llu\n", "file bytes written", usage.write_bytes);
+}
+
 /* Free the current process's resources. */
 /* 현재 프로세스의 리소스를 해제합니다. */
 // static void process_cleanup(void)
@@ -1044,6 +1092,8 @@ static bool validate_segment(const struct Phdr *phdr, struct file *file)
 /* load() helpers. */
 /* load() 헬퍼. */
 static bool install_page(void *upage, void *kpage, bool writable);
+static bool load_large_page(struct file *file, uint8_t *upage,
+							uint32_t read_bytes, bool writable);
 
 /* Loads a segment starting at offset OFS in FILE at address
  * UPAGE.  In total, READ_BYTES + ZERO_BYTES bytes of virtual
@@ -1092,6 +1142,20 @@ static bool load_segment(struct file *file, off_t ofs, uint8_t *upage,
 		size_t page_read_bytes = read_bytes < PGSIZE ? read_bytes : PGSIZE;
 		size_t page_zero_bytes = PGSIZE - page_read_bytes;
 
+		/* Map whole 2 MB stretches that start on a 2 MB boundary
+		 * with one large page when possible. */
+		/* 2 MB 경계에서 시작하는 2 MB 구간 전체는 가능하면 대형 페이지
+		 * 하나로 매핑합니다. */
+		if (lpg_ofs(upage) == 0 && read_bytes + zero_bytes >= LPGSIZE &&
+			load_large_page(file, upage, read_bytes, writable))
+		{
+			size_t large_read_bytes = read_bytes < LPGSIZE ? read_bytes : LPGSIZE;
+			read_bytes -= large_read_bytes;
+			zero_bytes -= LPGSIZE - large_read_bytes;
+			upage += LPGSIZE;
+			continue;
+		}
+
 		/* Get a page of memory. */
 		/* 메모리 페이지를 가져옵니다. */
 		uint8_t *kpage = palloc_get_page(PAL_USER);
@@ -1125,6 +1189,39 @@ static bool load_segment(struct file *file, off_t ofs, uint8_t *upage,
 	return true;
 }
 
+/* Loads the 2 MB at UPAGE of a segment like load_segment(), from
+ * the current position of FILE, into one large page: the first
+ * READ_BYTES bytes, at most 2 MB, come from FILE and the rest is
+ * zeroed.  Returns false, leaving FILE's position unchanged, if
+ * the user pool has no free 2 MB-aligned block or anything else
+ * fails, so that the caller can fall back to 4 kB pages. */
+/* load_segment()처럼 세그먼트의 UPAGE부터 2 MB를 FILE의 현재
+ * 위치에서 대형 페이지 하나로 로드합니다. 처음 READ_BYTES 바이트(최대
+ * 2 MB)는 FILE에서 읽고 나머지는 0으로 채웁니다. 사용자 풀에 2 MB
+ * 정렬된 가용 블록이 없거나 다른 이유로 실패하면 FILE의 위치를 바꾸지
+ * 않고 false를 반환하여, 호출자가 4 kB 페이지로 대신 로드할 수 있게
+ * 합니다. */
+static bool load_large_page(struct file *file, uint8_t *upage,
+							uint32_t read_bytes, bool writable)
+{
+	size_t large_read_bytes = read_bytes < LPGSIZE ? read_bytes : LPGSIZE;
+	off_t pos = file_tell(file);
+	uint8_t *kpage = palloc_get_multiple(PAL_USER, LPGCNT);
+
+	if (kpage == NULL)
+		return false;
+	if (lpg_ofs(vtop(kpage)) == 0 &&
+		file_read(file, kpage, large_read_bytes) == (int)large_read_bytes)
+	{
+		memset(kpage + large_read_bytes, 0, LPGSIZE - large_read_bytes);
+		if (pml4_set_large_page(thread_current()->pml4, upage, kpage, writable))
+			return true;
+	}
+	file_seek(file, pos);
+	palloc_free_multiple(kpage, LPGCNT);
+	return false;
+}
+
 /* Create a minimal stack by mapping a zeroed page at the USER_STACK */
 /* USER_STACK에서 제로화된 페이지를 매핑하여 최소 스택을 생성합니다. */
 static bool setup_stack(struct intr_frame *if_)
@@ -1179,12 +1276,31 @@ static bool install_page(void *upage, void *kpage, bool writable)
  * If you want to implement the function for only project 2, implement it on the
  * upper block. */
 
+/* Where lazy_load_segment() finds a page's contents. */
+/* lazy_load_segment()가 페이지의 내용을 찾는 곳. */
+struct segment_page
+{
+	struct file *file;	/* Executable. */
+						/* 실행 파일. */
+	off_t ofs;			/* Offset of the page's bytes in FILE. */
+						/* FILE에서 페이지 바이트의 오프셋. */
+	size_t read_bytes;	/* Bytes to read; the rest stays zero. */
+						/* 읽을 바이트 수. 나머지는 0으로 남습니다. */
+};
+
+/* Reads PAGE's part of a segment, as described by the
+ * struct segment_page AUX, and frees AUX. */
+/* struct segment_page AUX가 설명하는 세그먼트의 PAGE 부분을 읽고
+ * AUX를 해제합니다. */
 static bool
 lazy_load_segment(struct page *page, void *aux)
 {
-	/* TODO: Load the segment from the file */
-	/* TODO: This called when the first page fault occurs on address VA. */
-	/* TODO: VA is available when calling this function. */
+	struct segment_page *sp = aux;
+	bool success = file_read_at(sp->file, page->frame->kva, sp->read_bytes,
+								sp->ofs) == (off_t)sp->read_bytes;
+
+	free(sp);
+	return success;
 }
 
 /* Loads a segment starting at offset OFS in FILE at address
@@ -1217,16 +1333,31 @@ load_segment(struct file *file, off_t ofs, uint8_t *upage,
 		size_t page_read_bytes = read_bytes < PGSIZE ? read_bytes : PGSIZE;
 		size_t page_zero_bytes = PGSIZE - page_read_bytes;
 
-		/* TODO: Set up aux to pass information to the lazy_load_segment. */
-		void *aux = NULL;
-		if (!vm_alloc_page_with_initializer(VM_ANON, upage,
-											writable, lazy_load_segment, aux))
+		/* Pages with nothing to read need no loader: they are
+		 * zeroed when they are first touched. */
+		/* 읽을 것이 없는 페이지는 로더가 필요 없습니다. 처음 접근할 때
+		 * 0으로 채워집니다. */
+		struct segment_page *aux = NULL;
+		if (page_read_bytes > 0)
+		{
+			aux = malloc(sizeof *aux);
+			if (aux == NULL)
+				return false;
+			*aux = (struct segment_page){file, ofs, page_read_bytes};
+		}
+		if (!vm_alloc_page_with_initializer(VM_ANON, upage, writable,
+											aux != NULL ? lazy_load_segment : NULL,
+											aux))
+		{
+			free(aux);
 			return false;
+		}
 
 		/* Advance. */
 		read_bytes -= page_read_bytes;
 		zero_bytes -= page_zero_bytes;
 		upage += PGSIZE;
+		ofs += page_read_bytes;
 	}
 	return true;
 }
@@ -1238,10 +1369,12 @@ setup_stack(struct intr_frame *if_)
 	bool success = false;
 	void *stack_bottom = (void *)(((uint8_t *)USER_STACK) - PGSIZE);
 
-	/* TODO: Map the stack on stack_bottom and claim the page immediately.
-	 * TODO: If success, set the rsp accordingly.
-	 * TODO: You should mark the page is stack. */
-	/* TODO: Your code goes here */
+	if (vm_alloc_page(VM_ANON, stack_bottom, true) &&
+		vm_claim_page(stack_bottom))
+	{
+		if_->rsp = USER_STACK;
+		success = true;
+	}
 
 	return success;
 }
@@ -23,6 +23,7 @@ void syscall_handler(struct intr_frame *);
 // static bool is_valid_user_region(const void *uaddr, size_t len);
 
 void check_address(uintptr_t addr);
+void check_buffer(const void *buffer, size_t size, bool writable);
 int add_file_to_fdt(struct file *file);
 void remove_file_from_fdt(int fd);
 struct file *get_file_from_fd(int fd);
@@ -41,6 +42,8 @@ int write(int fd, const void *buffer, unsigned size);
 void seek(int fd, unsigned position);
 unsigned tell(int fd);
 void close(int fd);
+int sched_stat(tid_t tid, struct sched_stat *stat);
+int getrusage(tid_t tid, struct rusage *usage);
 
 /* System call.
  *
@@ -155,6 +158,12 @@ void syscall_handler(struct intr_frame *f)
 	case SYS_CLOSE:
 		close(f->R.rdi);
 		break;
+	case SYS_SCHED_STAT:
+		f->R.rax = sched_stat(f->R.rdi, (struct sched_stat *)f->R.rsi);
+		break;
+	case SYS_GETRUSAGE:
+		f->R.rax = getrusage(f->R.rdi, (struct rusage *)f->R.rsi);
+		break;
 	default:
 		thread_exit();
 		break;
@@ -184,7 +193,16 @@ void check_address(uintptr_t addr)
 		exit(-1);
 	}
 
+	/* With virtual memory, a page that is not loaded yet is
+	   brought in by the page fault handler when it is touched. */
+	/* 가상 메모리에서는 아직 로드되지 않은 페이지를 접근할 때 페이지
+	   오류 처리기가 가져옵니다. */
+#ifdef VM
+	if (pml4_get_page(thread_current()->pml4, (void *)addr) == NULL &&
+		spt_find_page(&thread_current()->spt, (void *)addr) == NULL)
+#else
 	if (pml4_get_page(thread_current()->pml4, (void *)addr) == NULL)
+#endif
 	{
 		exit(-1);
 	}
@@ -205,6 +223,53 @@ void check_address(uintptr_t addr)
 	}
 }
 
+/* is_writable_user_page - 사용자가 UPAGE에 쓸 수 있는지 확인한다.
+ * 가상 메모리에서는 아직 로드되지 않았거나 copy-on-write로 공유 중인
+ * 페이지도 보조 페이지 테이블로 판단한다.
+ */
+static bool is_writable_user_page(const void *upage)
+{
+	struct thread *curr = thread_current();
+
+#ifdef VM
+	struct page *page = spt_find_page(&curr->spt, (void *)upage);
+	if (page != NULL)
+	{
+		return page->writable;
+	}
+#endif
+	uint64_t *pte = pml4e_walk(curr->pml4, (uint64_t)upage, 0);
+	return pte != NULL && (*pte & PTE_P) && is_writable(pte);
+}
+
+/* check_buffer - BUFFER부터 SIZE 바이트가 걸친 모든 페이지가 유효한
+ * 사용자 페이지인지, WRITABLE이면 쓸 수 있는지도 확인한다. 아니면
+ * 프로세스를 종료한다.
+ */
+void check_buffer(const void *buffer, size_t size, bool writable)
+{
+	uintptr_t start = (uintptr_t)buffer;
+	uintptr_t end = start + size - 1;
+
+	if (size == 0)
+	{
+		return;
+	}
+	if (end < start || !is_user_vaddr(start) || !is_user_vaddr(end))
+	{
+		exit(-1);
+	}
+
+	for (uintptr_t page = (uintptr_t)pg_round_down(start); page <= end; page += PGSIZE)
+	{
+		check_address(page < start ? start : page);
+		if (writable && !is_writable_user_page((void *)page))
+		{
+			exit(-1);
+		}
+	}
+}
+
 void halt()
 {
 	
@@ -367,6 +432,7 @@ int filesize(int fd)
 int read(int fd, void *buffer, unsigned size)
 {
 	check_address(buffer);
+	check_buffer(buffer, size, true);
 
 	struct file *_file = get_file_from_fd(fd);
 
@@ -387,7 +453,24 @@ int read(int fd, void *buffer, unsigned size)
 		return byte;
 	}
 
-	return file_read(_file, buffer, size);
+	/* The file system reads into BUFFER while it holds a disk
+	   channel's lock, and a fault there would need the disk
+	   again, so every page of BUFFER is brought in first. */
+	/* 파일 시스템은 디스크 채널의 락을 잡은 채로 BUFFER에 읽어
+	   들이며, 그때 오류가 나면 디스크가 다시 필요하므로 BUFFER의 모든
+	   페이지를 먼저 가져옵니다. */
+#ifdef VM
+	if (!vm_pin_buffer(buffer, size, true))
+	{
+		exit(-1);
+	}
+#endif
+	byte = file_read(_file, buffer, size);
+#ifdef VM
+	vm_unpin_buffer(buffer, size);
+#endif
+	thread_current()->read_bytes += byte;
+	return byte;
 }
 
 /* write - fd로 열린 파일에 buffer에서 size 바이트를 쓴다.
@@ -400,6 +483,7 @@ int read(int fd, void *buffer, unsigned size)
 int write(int fd, const void *buffer, unsigned size)
 {
 	check_address(buffer);
+	check_buffer(buffer, size, false);
 
 	if (fd == 0)
 	{
@@ -419,7 +503,20 @@ int write(int fd, const void *buffer, unsigned size)
 		return -1;
 	}
 
-	return file_write(_file, buffer, size);
+	/* As in read(), BUFFER must not fault under the disk lock. */
+	/* read()에서처럼 BUFFER는 디스크 락을 잡은 동안 오류를 내면 안 됩니다. */
+#ifdef VM
+	if (!vm_pin_buffer(buffer, size, false))
+	{
+		exit(-1);
+	}
+#endif
+	int written = file_write(_file, buffer, size);
+#ifdef VM
+	vm_unpin_buffer(buffer, size);
+#endif
+	thread_current()->write_bytes += written;
+	return written;
 }
 
 /* 열린 파일 fd에서 읽거나 쓸 다음 바이트를 파일 시작부터 바이트 단위로 표시되는
@@ -470,6 +567,52 @@ void close(int fd)
 	remove_file_from_fdt(fd);
 }
 
+/* tid가 TID인 스레드의 스케줄러 통계 스냅샷을 STAT에 복사한다. TID가 0이면
+ * 호출한 스레드의 통계를 복사한다. 그런 스레드가 없으면 -1을, 성공하면 0을
+ * 반환한다. */
+int sched_stat(tid_t tid, struct sched_stat *stat)
+{
+	struct sched_stat snapshot;
+
+	check_buffer(stat, sizeof *stat, true);
+
+	if (tid == 0)
+	{
+		tid = thread_tid();
+	}
+
+	if (!thread_get_sched_stat(tid, &snapshot))
+	{
+		return -1;
+	}
+
+	memcpy(stat, &snapshot, sizeof snapshot);
+	return 0;
+}
+
+/* tid가 TID인 프로세스의 자원 사용량을 USAGE에 복사한다. TID가 0이면 호출한
+ * 프로세스의 사용량을 복사한다. 그런 프로세스가 없으면 -1을, 성공하면 0을
+ * 반환한다. */
+int getrusage(tid_t tid, struct rusage *usage)
+{
+	struct rusage snapshot;
+
+	check_buffer(usage, sizeof *usage, true);
+
+	if (tid == 0)
+	{
+		tid = thread_tid();
+	}
+
+	if (!thread_get_rusage(tid, &snapshot))
+	{
+		return -1;
+	}
+
+	memcpy(usage, &snapshot, sizeof snapshot);
+	return 0;
+}
+
 // file을 fdt에 추가하고 fd를 반환한다.
 int add_file_to_fdt(struct file *file)
 {
@@ -487,6 +630,10 @@ int add_file_to_fdt(struct file *file)
 	}
 
 	t->fdt[fd] = file;
+	if (fd >= t->fdt_end)
+	{
+		t->fdt_end = fd + 1;
+	}
 
 	return fd;
 }
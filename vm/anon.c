@@ -1,7 +1,11 @@
 /* anon.c: Implementation of page for non-disk image (a.k.a. anonymous page). */
 
 #include "vm/vm.h"
+#include <bitmap.h>
+#include <stdio.h>
 #include "devices/disk.h"
+#include "threads/malloc.h"
+#include "threads/synch.h"
 
 /* DO NOT MODIFY BELOW LINE */
 static struct disk *swap_disk;
@@ -17,11 +21,72 @@ static const struct page_operations anon_ops = {
 	.type = VM_ANON,
 };
 
+/* Swap slots.
+
+   The swap disk is divided into page-sized slots.  A page keeps
+   its slot when it is read back in, so that it can be evicted
+   again without writing it as long as it stays clean.  A dirty
+   page gets a fresh slot each time it is written out, so that the
+   pages evicted together can be given adjacent slots and written
+   with one transfer; they are then likely to be read back
+   together, which swap-in does by reading ahead the neighbouring
+   slots that hold other pages of the same process. */
+/* 스왑 슬롯.
+
+   스왑 디스크는 페이지 크기의 슬롯으로 나뉩니다. 페이지는 다시 읽혀
+   들어올 때도 슬롯을 유지하여, 깨끗한 동안에는 쓰지 않고 다시 내쫓길
+   수 있습니다. dirty 페이지는 써 내보낼 때마다 새 슬롯을 받으므로,
+   함께 내쫓기는 페이지들이 인접한 슬롯을 받아 한 번의 전송으로 쓰일 수
+   있습니다. 그러면 이들은 함께 다시 읽힐 가능성이 높으며, 스왑 인은
+   같은 프로세스의 다른 페이지를 담은 이웃 슬롯을 미리 읽어 이를
+   처리합니다. */
+#define SLOT_SECTORS (PGSIZE / DISK_SECTOR_SIZE) /* Sectors per slot. */
+                                                 /* 슬롯당 섹터 수. */
+static struct bitmap *swap_slots;	/* Slots in use. */
+static struct page **slot_pages;	/* Page in each slot in use. */
+static size_t slot_cursor;			/* Where slot_alloc() looks first. */
+static struct lock swap_lock;		/* Protects the slot data above. */
+
+/* Swap statistics. */
+/* 스왑 통계. */
+static uint64_t pages_written;		/* Pages written out. */
+static uint64_t write_cnt;			/* Transfers that wrote them. */
+static uint64_t pages_read;			/* Pages read in, not ahead. */
+static uint64_t pages_read_ahead;	/* Pages read ahead. */
+static uint64_t read_cnt;			/* Transfers that read them. */
+
+static size_t slot_alloc (struct page **pages, size_t cnt);
+static void slot_free (struct page *page);
+static void slot_transfer (size_t slot, void *const kvas[], size_t cnt,
+                           bool write);
+
 /* Initialize the data for anonymous pages */
+/* 익명 페이지를 위한 데이터를 초기화합니다. */
 void
 vm_anon_init (void) {
-	/* TODO: Set up the swap_disk. */
-	swap_disk = NULL;
+	size_t slot_cnt;
+
+	/* Without a swap disk, dirty anonymous pages cannot be
+	 * evicted. */
+	/* 스왑 디스크가 없으면 dirty 익명 페이지를 내쫓을 수 없습니다. */
+	swap_disk = disk_get (1, 1);
+	slot_cnt = swap_disk != NULL ? disk_size (swap_disk) / SLOT_SECTORS : 0;
+	swap_slots = bitmap_create (slot_cnt);
+	slot_pages = calloc (slot_cnt, sizeof *slot_pages);
+	if (swap_slots == NULL || (slot_cnt > 0 && slot_pages == NULL))
+		PANIC ("swap slot table creation failed");
+	lock_init (&swap_lock);
+}
+
+/* Prints swap statistics. */
+/* 스왑 통계를 출력합니다. */
+void
+vm_anon_print_stats (void) {
+	printf ("Swap: %zu of %zu slots in use, %llu pages written in %llu "
+	        "transfers, %llu read in %llu (%llu read ahead)\n",
+	        bitmap_count (swap_slots, 0, bitmap_size (swap_slots), true),
+	        bitmap_size (swap_slots), pages_written, write_cnt,
+	        pages_read + pages_read_ahead, read_cnt, pages_read_ahead);
 }
 
 /* Initialize the file mapping */
@@ -29,24 +94,243 @@ bool
 anon_initializer (struct page *page, enum vm_type type, void *kva) {
 	/* Set up the handler */
 	page->operations = &anon_ops;
+	page->anon.slot = SWAP_SLOT_NONE;
 
-	struct anon_page *anon_page = &page->anon;
+	/* The frame comes zeroed from vm_get_frame(). */
+	/* 프레임은 vm_get_frame()에서 0으로 채워진 채로 옵니다. */
+	return true;
 }
 
 /* Swap in the page by read contents from the swap disk. */
+/* A page without a slot was never written out and is zero, as
+   the frame already is.  Up to SWAP_CLUSTER - 1 neighbouring slots
+   holding pages of the same process that are not in memory are
+   read in by the same transfer, into frames that are free without
+   evicting anything, starting with the slots that follow. */
+/* 스왑 디스크에서 내용을 읽어 페이지를 스왑 인합니다.
+   슬롯이 없는 페이지는 써 내보낸 적이 없으므로 0이며, 프레임도 이미
+   그렇습니다. 같은 프로세스의 메모리에 없는 페이지를 담은 이웃 슬롯을
+   뒤따르는 슬롯부터 SWAP_CLUSTER - 1개까지, 아무것도 내쫓지 않고 얻을
+   수 있는 프레임으로 같은 전송에서 함께 읽어 들입니다. */
 static bool
 anon_swap_in (struct page *page, void *kva) {
-	struct anon_page *anon_page = &page->anon;
+	size_t slot = page->anon.slot;
+	struct page *near[2 * SWAP_CLUSTER - 1];
+	void *kvas[SWAP_CLUSTER];
+	size_t first, last, lo, hi, cnt, i;
+
+	page->dirty = false;
+	if (slot == SWAP_SLOT_NONE)
+		return true;
+
+	/* Find the neighbours, NEAR[I] being the page in slot LO + I.
+	   They stay allocated, since they belong to PAGE's owner, which
+	   is either running this or waiting for it.  Another process's
+	   eviction may still move one to another slot once swap_lock is
+	   released, so vm_claim_frame_for_readahead() checks the slot
+	   again before a neighbour is read. */
+	/* 이웃을 찾습니다. NEAR[I]는 슬롯 LO + I의 페이지입니다. 이웃은
+	   PAGE의 소유자에게 속하는데, 소유자는 이 코드를 실행하고 있거나
+	   이를 기다리고 있으므로 해제되지 않습니다. 하지만 swap_lock을 놓은
+	   뒤 다른 프로세스의 내쫓기가 이웃을 다른 슬롯으로 옮길 수 있으므로,
+	   vm_claim_frame_for_readahead()가 이웃을 읽기 전에 슬롯을 다시
+	   확인합니다. */
+	lo = slot >= SWAP_CLUSTER - 1 ? slot - (SWAP_CLUSTER - 1) : 0;
+	hi = slot + SWAP_CLUSTER - 1;
+	if (hi >= bitmap_size (swap_slots))
+		hi = bitmap_size (swap_slots) - 1;
+	lock_acquire (&swap_lock);
+	for (i = lo; i <= hi; i++) {
+		struct page *p = slot_pages[i];
+		near[i - lo] =
+			p != NULL && p != page && p->owner == page->owner ? p : NULL;
+	}
+	lock_release (&swap_lock);
+
+	/* Claim frames for them, forward and then back, up to the
+	   first one that is not there or cannot be had. */
+	/* 앞쪽, 그다음 뒤쪽 순으로, 없거나 얻을 수 없는 첫 이웃 전까지
+	   이웃을 위한 프레임을 확보합니다. */
+	first = last = slot;
+	while (last - first + 1 < SWAP_CLUSTER && last < hi
+	       && near[last + 1 - lo] != NULL
+	       && vm_claim_frame_for_readahead (near[last + 1 - lo], last + 1))
+		last++;
+	while (last - first + 1 < SWAP_CLUSTER && first > lo
+	       && near[first - 1 - lo] != NULL
+	       && vm_claim_frame_for_readahead (near[first - 1 - lo], first - 1))
+		first--;
+
+	cnt = last - first + 1;
+	for (i = first; i <= last; i++)
+		kvas[i - first] = i == slot ? kva : near[i - lo]->frame->kva;
+	slot_transfer (first, kvas, cnt, false);
+	read_cnt++;
+	pages_read++;
+	pages_read_ahead += cnt - 1;
+
+	for (i = first; i <= last; i++)
+		if (i != slot) {
+			near[i - lo]->dirty = false;
+			vm_readahead_done (near[i - lo]);
+		}
+	return true;
 }
 
 /* Swap out the page by writing contents to the swap disk. */
+/* Only a dirty page is written; a clean one already has its
+   contents in its slot, or is zero.  Returns false if the swap
+   disk is full. */
+/* 스왑 디스크에 내용을 써서 페이지를 스왑 아웃합니다.
+   dirty 페이지만 씁니다. 깨끗한 페이지는 이미 슬롯에 내용이 있거나
+   0입니다. 스왑 디스크가 가득 차면 거짓을 반환합니다. */
 static bool
 anon_swap_out (struct page *page) {
+	if (!page->dirty)
+		return true;
+	return anon_swap_out_cluster (&page, 1);
+}
+
+/* Writes out the CNT dirty anonymous pages in PAGES, which must
+   be unmapped and have frames, into adjacent slots with as few
+   transfers as the free slots allow.  Returns false if the swap
+   disk is full. */
+/* 매핑이 해제되었고 프레임이 있어야 하는 PAGES의 dirty 익명 페이지
+   CNT개를, 가용 슬롯이 허락하는 한 적은 전송으로 인접한 슬롯에
+   써 내보냅니다. 스왑 디스크가 가득 차면 거짓을 반환합니다. */
+bool
+anon_swap_out_cluster (struct page *pages[], size_t cnt) {
+	void *kvas[SWAP_CLUSTER];
+	size_t done, i;
+
+	ASSERT (cnt <= SWAP_CLUSTER);
+
+	lock_acquire (&swap_lock);
+	for (i = 0; i < cnt; i++)
+		slot_free (pages[i]);
+	lock_release (&swap_lock);
+
+	for (done = 0; done < cnt; ) {
+		size_t slot, run;
+
+		lock_acquire (&swap_lock);
+		run = slot_alloc (pages + done, cnt - done);
+		lock_release (&swap_lock);
+		if (run == 0)
+			return false;
+
+		slot = pages[done]->anon.slot;
+		for (i = 0; i < run; i++)
+			kvas[i] = pages[done + i]->frame->kva;
+		slot_transfer (slot, kvas, run, true);
+		write_cnt++;
+		pages_written += run;
+
+		for (i = 0; i < run; i++)
+			pages[done + i]->dirty = false;
+		done += run;
+	}
+	return true;
+}
+
+/* Gives the first of the CNT pages in PAGES, and as many of the
+   rest as possible, adjacent slots: CNT of them if a long enough
+   run is free, otherwise half as many, and so on.  Returns the
+   number of pages given slots, 0 if the swap disk is full.  The
+   caller must hold swap_lock.
+
+   Slots are handed out next-fit from slot_cursor, so successive
+   clusters land one after another on the disk and the search
+   does not rescan the slots in use near the start every time. */
+/* PAGES에 있는 CNT개의 페이지 중 첫 번째와 나머지 중 가능한 한 많은
+   페이지에 인접한 슬롯을 줍니다. 충분히 긴 구간이 비어 있으면 CNT개,
+   아니면 그 절반, 이런 식으로 줄여 갑니다. 슬롯을 받은 페이지 수를
+   반환하며, 스왑 디스크가 가득 차면 0을 반환합니다. 호출자는
+   swap_lock을 잡고 있어야 합니다.
+
+   슬롯은 slot_cursor부터 next-fit으로 나눠 주므로, 이어지는
+   클러스터가 디스크에 차례로 놓이고 검색이 매번 앞쪽의 사용 중인
+   슬롯을 다시 훑지 않습니다. */
+static size_t
+slot_alloc (struct page **pages, size_t cnt) {
+	size_t run, slot, i;
+
+	ASSERT (lock_held_by_current_thread (&swap_lock));
+
+	for (run = cnt; run > 0; run /= 2) {
+		slot = bitmap_scan_and_flip_next_fit (swap_slots, &slot_cursor, run,
+		                                      false);
+		if (slot != BITMAP_ERROR) {
+			for (i = 0; i < run; i++) {
+				pages[i]->anon.slot = slot + i;
+				slot_pages[slot + i] = pages[i];
+				pages[i]->owner->swapped_pages++;
+			}
+			return run;
+		}
+	}
+	return 0;
+}
+
+/* Frees PAGE's slot, if it has one.  The caller must hold
+   swap_lock. */
+/* PAGE에 슬롯이 있으면 해제합니다. 호출자는 swap_lock을 잡고 있어야
+   합니다. */
+static void
+slot_free (struct page *page) {
 	struct anon_page *anon_page = &page->anon;
+
+	ASSERT (lock_held_by_current_thread (&swap_lock));
+
+	if (anon_page->slot != SWAP_SLOT_NONE) {
+		bitmap_reset (swap_slots, anon_page->slot);
+		slot_pages[anon_page->slot] = NULL;
+		anon_page->slot = SWAP_SLOT_NONE;
+		page->owner->swapped_pages--;
+	}
+}
+
+/* Returns true if swap slot SLOT holds the contents of PAGE. */
+/* 스왑 슬롯 SLOT에 PAGE의 내용이 있으면 참을 반환합니다. */
+bool
+anon_slot_holds (size_t slot, struct page *page) {
+	bool holds;
+
+	lock_acquire (&swap_lock);
+	holds = page->anon.slot == slot && slot_pages[slot] == page;
+	lock_release (&swap_lock);
+	return holds;
+}
+
+/* Reads or, if WRITE is true, writes the CNT slots starting at
+   SLOT from or to the pages at KVAS[0] through KVAS[CNT - 1],
+   with one disk transfer. */
+/* SLOT부터 CNT개의 슬롯을 KVAS[0]부터 KVAS[CNT - 1]까지의 페이지로
+   읽거나, WRITE가 참이면 그 페이지에서 씁니다. 디스크 전송은 한 번만
+   합니다. */
+static void
+slot_transfer (size_t slot, void *const kvas[], size_t cnt, bool write) {
+	void *sectors[SWAP_CLUSTER * SLOT_SECTORS];
+	size_t i;
+
+	ASSERT (cnt <= SWAP_CLUSTER);
+
+	for (i = 0; i < cnt * SLOT_SECTORS; i++)
+		sectors[i] = (uint8_t *) kvas[i / SLOT_SECTORS]
+		             + i % SLOT_SECTORS * DISK_SECTOR_SIZE;
+	if (write)
+		disk_write_multiple (swap_disk, slot * SLOT_SECTORS,
+		                     (const void *const *) sectors, cnt * SLOT_SECTORS);
+	else
+		disk_read_multiple (swap_disk, slot * SLOT_SECTORS, sectors,
+		                    cnt * SLOT_SECTORS);
 }
 
 /* Destroy the anonymous page. PAGE will be freed by the caller. */
+/* 익명 페이지를 파괴합니다. PAGE는 호출자가 해제합니다. */
 static void
 anon_destroy (struct page *page) {
-	struct anon_page *anon_page = &page->anon;
+	lock_acquire (&swap_lock);
+	slot_free (page);
+	lock_release (&swap_lock);
 }
@@ -8,6 +8,7 @@
  * function.
  * */
 
+#include "threads/malloc.h"
 #include "vm/vm.h"
 #include "vm/uninit.h"
 
@@ -60,9 +61,16 @@ uninit_initialize (struct page *page, void *kva) {
  * to other page objects, it is possible to have uninit pages when the process
  * exit, which are never referenced during the execution.
  * PAGE will be freed by the caller. */
+/* The AUX of a page with an INIT callback is a malloc()'d block
+ * that belongs to the page: INIT frees it once the page is loaded,
+ * and this frees it if the page never is. */
+/* INIT 콜백이 있는 페이지의 AUX는 페이지가 소유하는 malloc()된
+ * 블록입니다. 페이지가 로드되면 INIT이 해제하고, 끝내 로드되지
+ * 않으면 여기서 해제합니다. */
 static void
 uninit_destroy (struct page *page) {
-	struct uninit_page *uninit UNUSED = &page->uninit;
-	/* TODO: Fill this function.
-	 * TODO: If you don't have anything to do, just return. */
+	struct uninit_page *uninit = &page->uninit;
+
+	if (uninit->init != NULL)
+		free (uninit->aux);
 }
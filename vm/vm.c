@@ -1,9 +1,116 @@
 /* vm.c: Generic interface for virtual memory objects. */
 
+#include <stdio.h>
+#include <string.h>
 #include "threads/malloc.h"
+#include "threads/mmu.h"
+#include "threads/slab.h"
+#include "threads/synch.h"
 #include "vm/vm.h"
 #include "vm/inspect.h"
 
+/* Caches of struct page and struct frame. */
+/* struct page와 struct frame의 캐시. */
+static struct kmem_cache *vm_page_cache;
+static struct kmem_cache *frame_cache;
+
+/* Frame table.
+
+   Every user pool frame that holds a page is on frame_table,
+   which clock_hand sweeps to pick the frames to evict.  A frame
+   is pinned while it is being loaded or copied, so that it is
+   not picked from under the thread that is filling it.
+
+   fork() shares each resident page's frame between the parent
+   and the child instead of copying it, and maps it read-only in
+   both; the frame's ref_cnt counts its pages.  The first write
+   through either mapping faults into vm_handle_wp(), which gives
+   the writer a copy of its own, or, if the writer's page is the
+   last one left on the frame, just makes its mapping writable.
+
+   frame_lock protects the table, the page and frame links, and
+   the pin counts, and is held across an eviction, disk writes
+   included: a process that faults on a page being written out
+   waits for it in vm_get_frame() and then reads it back. */
+/* 프레임 테이블.
+
+   페이지를 담은 사용자 풀의 모든 프레임은 frame_table에 있으며,
+   clock_hand가 이를 돌며 내쫓을 프레임을 고릅니다. 프레임은 로드나
+   복사 중에 고정되어, 그것을 채우는 스레드 몰래 선택되지 않습니다.
+
+   fork()는 메모리에 있는 각 페이지의 프레임을 복사하는 대신 부모와
+   자식이 공유하게 하고 양쪽에 읽기 전용으로 매핑합니다. 프레임의
+   ref_cnt가 그 페이지 수를 셉니다. 어느 쪽 매핑으로든 처음 쓰면
+   vm_handle_wp()로 오류가 들어가며, 이 함수는 쓰는 쪽에 자기만의
+   사본을 주거나, 쓰는 쪽의 페이지가 프레임에 남은 마지막 페이지이면
+   그 매핑을 쓰기 가능하게만 바꿉니다.
+
+   frame_lock은 테이블, 페이지와 프레임 간 연결, 고정 횟수를
+   보호하며, 디스크 쓰기를 포함한 내쫓기 동안 계속 잡혀 있습니다.
+   써 내보내는 중인 페이지에서 오류를 낸 프로세스는 vm_get_frame()에서
+   이를 기다린 뒤 다시 읽어 들입니다. */
+static struct list frame_table;
+static struct list_elem *clock_hand; /* Next frame to examine. */
+static struct lock frame_lock;
+
+/* Eviction statistics. */
+/* 내쫓기 통계. */
+static uint64_t clean_victims;	/* Victims that needed no writing. */
+static uint64_t dirty_victims;	/* Victims written out first. */
+static uint64_t scan_total;		/* Frames examined to find them. */
+static uint64_t scan_max;		/* Most frames examined for one. */
+
+/* Copy-on-write statistics. */
+/* copy-on-write 통계. */
+static uint64_t cow_shared;		/* Frames shared by fork(). */
+static uint64_t cow_copied;		/* Write faults that copied a frame. */
+static uint64_t cow_reused;		/* Write faults by the last sharer. */
+
+/* The shared zero page.
+
+   A read fault on an anonymous page that was never written maps
+   zero_kva read-only instead of giving the page a frame of its
+   own, so that sparse arrays and untouched stack read as zeros
+   without using memory.  The page keeps no frame while it maps
+   the zero page, and is left out of the frame table; its first
+   write faults into vm_handle_wp(), which claims it a zeroed
+   frame as usual. */
+/* 공유 0 페이지.
+
+   한 번도 쓰이지 않은 익명 페이지에서 읽기 오류가 나면 페이지에
+   자기만의 프레임을 주는 대신 zero_kva를 읽기 전용으로 매핑하여,
+   희소 배열과 건드리지 않은 스택이 메모리를 쓰지 않고 0으로 읽히게
+   합니다. 0 페이지를 매핑한 동안 페이지에는 프레임이 없으며 프레임
+   테이블에도 들어가지 않습니다. 처음 쓸 때 vm_handle_wp()로 오류가
+   들어가며, 여기서 평소처럼 0으로 채운 프레임을 확보합니다. */
+static void *zero_kva;
+static uint64_t zero_hits;		/* Faults that mapped the zero page. */
+
+/* Large pages.
+
+   A write fault on an anonymous page that was never written
+   brings in the whole 2 MB-aligned region around it with one
+   large page, if every page of the region is in the table, reads
+   as zeros and has the same permissions, and the user pool stays
+   at least half free.  Each 4 kB part still gets a struct frame
+   of its own, so eviction, fork and exit handle the parts one by
+   one as usual: the first of them to unmap or write-protect a
+   single page splits the mapping.  Until then the parts share one
+   accessed and one dirty bit, so after a split a part that was
+   never written may be written to swap once. */
+/* 대형 페이지.
+
+   한 번도 쓰이지 않은 익명 페이지에서 쓰기 오류가 나면, 그 주위의
+   2 MB 정렬 영역의 모든 페이지가 테이블에 있고 0으로 읽히며 권한이
+   같고 사용자 풀이 절반 이상 비어 있는 채로 남으면, 영역 전체를 대형
+   페이지 하나로 가져옵니다. 각 4 kB 부분은 여전히 자기만의 struct
+   frame을 가지므로 내쫓기, fork, 종료는 평소처럼 부분을 하나씩
+   처리합니다. 그중 처음으로 한 페이지의 매핑을 해제하거나 쓰기 보호하는
+   쪽이 매핑을 분할합니다. 그때까지 부분들은 접근 비트와 dirty 비트를
+   하나씩 공유하므로, 분할 뒤에는 한 번도 쓰이지 않은 부분이 스왑에 한
+   번 쓰일 수 있습니다. */
+static uint64_t large_claims;	/* Regions brought in as large pages. */
+
 /* Initializes the virtual memory subsystem by invoking each subsystem's
  * intialize codes. */
 void vm_init(void)
@@ -16,6 +123,32 @@ void vm_init(void)
 	register_inspect_intr();
 	/* DO NOT MODIFY UPPER LINES. */
 	/* TODO: Your code goes here. */
+	vm_page_cache = kmem_cache_create("page", sizeof(struct page), 0, NULL);
+	frame_cache = kmem_cache_create("frame", sizeof(struct frame), 0, NULL);
+	if (vm_page_cache == NULL || frame_cache == NULL)
+		PANIC("vm object cache creation failed");
+	list_init(&frame_table);
+	clock_hand = list_end(&frame_table);
+	lock_init(&frame_lock);
+	zero_kva = palloc_get_page(PAL_ASSERT | PAL_ZERO);
+}
+
+/* Prints eviction, copy-on-write and zero page statistics. */
+/* 내쫓기, copy-on-write, 0 페이지 통계를 출력합니다. */
+void vm_print_stats(void)
+{
+	uint64_t victims = clean_victims + dirty_victims;
+
+	printf("Frames: %zu in use, %llu evicted (%llu clean, %llu dirty), "
+		   "%llu examined per eviction (max %llu)\n",
+		   list_size(&frame_table), victims, clean_victims, dirty_victims,
+		   victims != 0 ? scan_total / victims : 0, scan_max);
+	printf("Copy-on-write: %llu pages shared, %llu copied, "
+		   "%llu reused by the last sharer\n",
+		   cow_shared, cow_copied, cow_reused);
+	printf("Zero page: %llu faults mapped it\n", zero_hits);
+	printf("Large pages: %llu regions mapped with one\n", large_claims);
+	vm_anon_print_stats();
 }
 
 /* Get the type of the page. This function is useful if you want to know the
@@ -38,6 +171,19 @@ page_get_type(struct page *page)
 static struct frame *vm_get_victim(void);
 static bool vm_do_claim_page(struct page *page);
 static struct frame *vm_evict_frame(void);
+static struct page **spt_slot(struct supplemental_page_table *spt,
+							  const void *va, bool create);
+static void spt_free_page(struct page *page);
+static bool page_pin(struct page *page);
+static void page_unpin(struct page *page);
+static struct frame *frame_create(void *kva);
+static void frame_free(struct frame *frame);
+static void frame_attach(struct frame *frame, struct page *page);
+static void frame_detach(struct page *page);
+static bool page_reads_as_zero(struct page *page);
+static void page_unmap_zero(struct page *page);
+static bool vm_claim_large_page(struct page *page);
+static bool vm_handle_wp(struct page *page);
 
 /* Create the pending page object with initializer. If you want to create a
  * page, do not create it directly and make it through this function or
@@ -53,78 +199,763 @@ bool vm_alloc_page_with_initializer(enum vm_type type, void *upage, bool writabl
 	/* Check wheter the upage is already occupied or not. */
 	if (spt_find_page(spt, upage) == NULL)
 	{
-		/* TODO: Create the page, fetch the initialier according to the VM type,
-		 * TODO: and then create "uninit" page struct by calling uninit_new. You
-		 * TODO: should modify the field after calling the uninit_new. */
+		bool (*initializer)(struct page *, enum vm_type, void *);
+		struct page *page;
+
+		switch (VM_TYPE(type))
+		{
+		case VM_ANON:
+			initializer = anon_initializer;
+			break;
+		case VM_FILE:
+			initializer = file_backed_initializer;
+			break;
+		default:
+			goto err;
+		}
 
-		/* TODO: Insert the page into the spt. */
+		page = kmem_cache_alloc(vm_page_cache);
+		if (page == NULL)
+			goto err;
+		uninit_new(page, upage, init, type, aux, initializer);
+		page->owner = thread_current();
+		page->writable = writable;
+
+		if (!spt_insert_page(spt, page))
+		{
+			kmem_cache_free(vm_page_cache, page);
+			goto err;
+		}
+		return true;
 	}
 err:
 	return false;
 }
 
+/* Returns the slot for the page at VA in SPT's leaf nodes, or a
+   null pointer if there is none.  If CREATE is true, allocates
+   the missing nodes on the way down instead, and returns a null
+   pointer only if memory runs out. */
+/* SPT의 리프 노드에서 VA의 페이지가 들어갈 슬롯을 반환하며, 없으면 널
+   포인터를 반환합니다. CREATE가 참이면 내려가는 길에 없는 노드를
+   대신 할당하고, 메모리가 부족할 때만 널 포인터를 반환합니다. */
+static struct page **
+spt_slot(struct supplemental_page_table *spt, const void *va, bool create)
+{
+	static const unsigned shifts[SPT_LEVELS] = {PML4SHIFT, PDPESHIFT,
+												 PDXSHIFT, PTXSHIFT};
+	void ***link = &spt->root;
+	int level;
+
+	for (level = 0;; level++)
+	{
+		void **node = *link;
+		if (node == NULL)
+		{
+			if (!create || (node = palloc_get_page(PAL_ZERO)) == NULL)
+				return NULL;
+			*link = node;
+		}
+
+		void **entry = &node[((uint64_t)va >> shifts[level]) & (SPT_FANOUT - 1)];
+		if (level == SPT_LEVELS - 1)
+			return (struct page **)entry;
+		link = (void ***)entry;
+	}
+}
+
 /* Find VA from spt and return page. On error, return NULL. */
+/* spt에서 VA를 찾아 페이지를 반환합니다. 오류 시 NULL을 반환합니다. */
 struct page *
-spt_find_page(struct supplemental_page_table *spt UNUSED, void *va UNUSED)
+spt_find_page(struct supplemental_page_table *spt, void *va)
 {
-	struct page *page = NULL;
-	/* TODO: Fill this function. */
+	struct page **slot;
 
-	return page;
+	if (!is_user_vaddr(va))
+		return NULL;
+	slot = spt_slot(spt, va, false);
+	return slot != NULL ? *slot : NULL;
 }
 
 /* Insert PAGE into spt with validation. */
-bool spt_insert_page(struct supplemental_page_table *spt UNUSED,
-					 struct page *page UNUSED)
+/* 검증을 거쳐 PAGE를 spt에 삽입합니다. */
+bool spt_insert_page(struct supplemental_page_table *spt,
+					 struct page *page)
 {
-	int succ = false;
-	/* TODO: Fill this function. */
+	struct page **slot;
 
-	return succ;
+	if (pg_ofs(page->va) != 0 || !is_user_vaddr(page->va))
+		return false;
+	slot = spt_slot(spt, page->va, true);
+	if (slot == NULL || *slot != NULL)
+		return false;
+	*slot = page;
+	return true;
 }
 
+/* Removes PAGE from SPT and frees it.  The nodes above it stay
+   until the table is killed. */
+/* PAGE를 SPT에서 제거하고 해제합니다. 그 위의 노드는 테이블이
+   제거될 때까지 남습니다. */
 void spt_remove_page(struct supplemental_page_table *spt, struct page *page)
 {
+	struct page **slot = spt_slot(spt, page->va, false);
+
+	ASSERT(slot != NULL && *slot == page);
+	*slot = NULL;
+	spt_free_page(page);
+}
+
+/* Frees PAGE along with the frame it holds, if any, unless the
+   frame is still shared with other pages. */
+/* PAGE를 그것이 잡고 있는 프레임이 있으면 함께 해제합니다. 단,
+   프레임을 아직 다른 페이지와 공유하고 있으면 프레임은 남깁니다. */
+static void
+spt_free_page(struct page *page)
+{
+	struct frame *frame;
+
+	lock_acquire(&frame_lock);
+	frame = page->frame;
+	if (frame != NULL)
+	{
+		pml4_clear_page(page->owner->pml4, page->va);
+		frame_detach(page);
+		if (frame->ref_cnt == 0)
+			frame_free(frame);
+	}
+	else
+		page_unmap_zero(page);
+	lock_release(&frame_lock);
+
 	vm_dealloc_page(page);
-	return true;
+}
+
+/* Returns a new frame for the user pool page KVA, added to the
+   frame table, or a null pointer if memory runs out.  The caller
+   must hold frame_lock. */
+/* 사용자 풀 페이지 KVA를 위한 새 프레임을 프레임 테이블에 추가하여
+   반환하며, 메모리가 부족하면 널 포인터를 반환합니다. 호출자는
+   frame_lock을 잡고 있어야 합니다. */
+static struct frame *
+frame_create(void *kva)
+{
+	struct frame *frame;
+
+	ASSERT(lock_held_by_current_thread(&frame_lock));
+
+	frame = kmem_cache_alloc(frame_cache);
+	if (frame == NULL)
+		return NULL;
+	frame->kva = kva;
+	list_init(&frame->pages);
+	frame->ref_cnt = 0;
+	frame->pin_cnt = 0;
+
+	/* Insert just behind the hand, to be examined last. */
+	/* 바늘 바로 뒤에 넣어 가장 나중에 살펴보게 합니다. */
+	list_insert(clock_hand, &frame->elem);
+	return frame;
+}
+
+/* Removes FRAME from the frame table and frees it.  The caller
+   must hold frame_lock. */
+/* FRAME을 프레임 테이블에서 제거하고 해제합니다. 호출자는
+   frame_lock을 잡고 있어야 합니다. */
+static void
+frame_free(struct frame *frame)
+{
+	ASSERT(lock_held_by_current_thread(&frame_lock));
+	ASSERT(frame->ref_cnt == 0);
+
+	if (clock_hand == &frame->elem)
+		clock_hand = list_next(clock_hand);
+	list_remove(&frame->elem);
+	palloc_free_page(frame->kva);
+	kmem_cache_free(frame_cache, frame);
+}
+
+/* Adds PAGE to the pages sharing FRAME.  The caller must hold
+   frame_lock. */
+/* PAGE를 FRAME을 공유하는 페이지에 추가합니다. 호출자는 frame_lock을
+   잡고 있어야 합니다. */
+static void
+frame_attach(struct frame *frame, struct page *page)
+{
+	ASSERT(lock_held_by_current_thread(&frame_lock));
+	ASSERT(page->frame == NULL);
+
+	list_push_back(&frame->pages, &page->frame_elem);
+	frame->ref_cnt++;
+	page->frame = frame;
+}
+
+/* Removes PAGE from the pages sharing its frame, which the caller
+   frees if that leaves its ref_cnt at zero.  The caller must hold
+   frame_lock. */
+/* PAGE를 그 프레임을 공유하는 페이지에서 제거합니다. 그 결과 ref_cnt가
+   0이 되면 호출자가 프레임을 해제합니다. 호출자는 frame_lock을 잡고
+   있어야 합니다. */
+static void
+frame_detach(struct page *page)
+{
+	ASSERT(lock_held_by_current_thread(&frame_lock));
+	ASSERT(page->frame != NULL && page->frame->ref_cnt > 0);
+
+	list_remove(&page->frame_elem);
+	page->frame->ref_cnt--;
+	page->frame = NULL;
+}
+
+/* Returns true if FRAME was accessed since the last call, and
+   clears the accessed bits of its mappings.  A frame is mapped
+   only by its pages' user addresses: the kernel reaches it
+   through its kva only to fill or copy it, while it is pinned. */
+/* FRAME이 지난번 호출 이후 접근되었으면 참을 반환하고, 그 매핑들의
+   접근 비트를 지웁니다. 프레임은 페이지들의 사용자 주소로만
+   매핑됩니다. 커널은 고정된 동안 프레임을 채우거나 복사할 때만 kva로
+   접근합니다. */
+static bool
+frame_test_and_clear_accessed(struct frame *frame)
+{
+	bool accessed = false;
+	struct list_elem *e;
+
+	for (e = list_begin(&frame->pages); e != list_end(&frame->pages);
+		 e = list_next(e))
+	{
+		struct page *page = list_entry(e, struct page, frame_elem);
+
+		if (pml4_is_accessed(page->owner->pml4, page->va))
+		{
+			pml4_set_accessed(page->owner->pml4, page->va, false);
+			accessed = true;
+		}
+	}
+	return accessed;
+}
+
+/* Returns true if PAGE, which is in memory, holds changes that
+   must be written out before its frame can be reused. */
+/* 메모리에 있는 PAGE에 그 프레임을 다시 쓰기 전에 써 내보내야 하는
+   변경이 있으면 참을 반환합니다. */
+static bool
+page_is_dirty(struct page *page)
+{
+	return page->dirty || pml4_is_dirty(page->owner->pml4, page->va);
+}
+
+/* Returns true if FRAME holds changes that must be written out,
+   for any of its pages, before it can be reused. */
+/* FRAME을 다시 쓰기 전에 그 페이지 중 어느 하나를 위해서라도 써
+   내보내야 하는 변경이 있으면 참을 반환합니다. */
+static bool
+frame_is_dirty(struct frame *frame)
+{
+	struct list_elem *e;
+
+	for (e = list_begin(&frame->pages); e != list_end(&frame->pages);
+		 e = list_next(e))
+		if (page_is_dirty(list_entry(e, struct page, frame_elem)))
+			return true;
+	return false;
 }
 
 /* Get the struct frame, that will be evicted. */
+/* Sweeps the CLOCK hand over the frame table, clearing accessed
+   bits, and returns the first frame that was not accessed since
+   the hand last passed it and is clean.  Unaccessed dirty frames
+   are passed over, but the first one is taken if two sweeps find
+   no clean frame.  Returns a null pointer if every frame is
+   pinned.  The caller must hold frame_lock. */
+/* 내쫓을 struct frame을 가져옵니다.
+   CLOCK 바늘로 프레임 테이블을 훑으며 접근 비트를 지우고, 바늘이
+   지난번 지나간 뒤로 접근되지 않았고 깨끗한 첫 프레임을 반환합니다.
+   접근되지 않은 dirty 프레임은 건너뛰지만, 두 바퀴를 돌아도 깨끗한
+   프레임이 없으면 그중 첫 번째를 고릅니다. 모든 프레임이 고정되어
+   있으면 널 포인터를 반환합니다. 호출자는 frame_lock을 잡고 있어야
+   합니다. */
 static struct frame *
 vm_get_victim(void)
 {
-	struct frame *victim = NULL;
-	/* TODO: The policy for eviction is up to you. */
+	struct frame *victim = NULL, *dirty = NULL;
+	size_t scan_limit = 2 * list_size(&frame_table);
+	size_t scanned;
+
+	ASSERT(lock_held_by_current_thread(&frame_lock));
 
+	for (scanned = 0; scanned < scan_limit && victim == NULL; scanned++)
+	{
+		struct frame *frame;
+
+		if (clock_hand == list_end(&frame_table))
+			clock_hand = list_begin(&frame_table);
+		frame = list_entry(clock_hand, struct frame, elem);
+		clock_hand = list_next(clock_hand);
+
+		if (frame->pin_cnt > 0 || frame_test_and_clear_accessed(frame))
+			continue;
+		if (!frame_is_dirty(frame))
+			victim = frame;
+		else if (dirty == NULL)
+			dirty = frame;
+	}
+	if (victim == NULL)
+		victim = dirty;
+
+	if (victim != NULL)
+	{
+		scan_total += scanned;
+		if (scanned > scan_max)
+			scan_max = scanned;
+	}
 	return victim;
 }
 
 /* Evict one page and return the corresponding frame.
  * Return NULL on error.*/
+/* Evicts up to SWAP_CLUSTER frames at once, so that the dirty
+ * anonymous pages among them can be written out together, and
+ * returns the first frame; the rest go back to the user pool for
+ * the faults that follow.  Every page sharing a frame is evicted
+ * with it, into a slot of its own.  The pages are unmapped before
+ * they are written out, so that their owners cannot change them
+ * in the meantime; an owner that faults on one waits on
+ * frame_lock until it is out.  The returned frame stays on the
+ * frame table.  The caller must hold frame_lock. */
+/* 페이지 하나를 내쫓고 해당 프레임을 반환합니다. 오류 시 NULL을
+ * 반환합니다.
+ * 한 번에 최대 SWAP_CLUSTER개의 프레임을 내쫓아 그중 dirty 익명
+ * 페이지를 함께 써 내보낼 수 있게 하고, 첫 프레임을 반환합니다.
+ * 나머지는 뒤따를 오류를 위해 사용자 풀로 돌아갑니다. 프레임을
+ * 공유하는 모든 페이지가 함께, 각자의 슬롯으로 내쫓깁니다. 페이지는 써
+ * 내보내기 전에 매핑을 해제하여 그동안 소유자가 바꿀 수 없게 합니다.
+ * 소유자가 그중 하나에서 오류를 내면 페이지가 나갈 때까지 frame_lock에서
+ * 기다립니다. 반환된 프레임은 프레임 테이블에 남습니다. 호출자는
+ * frame_lock을 잡고 있어야 합니다. */
 static struct frame *
 vm_evict_frame(void)
 {
-	struct frame *victim UNUSED = vm_get_victim();
-	/* TODO: swap out the victim and return the evicted frame. */
+	struct frame *victims[SWAP_CLUSTER];
+	struct page *anon_pages[SWAP_CLUSTER];
+	size_t victim_cnt, anon_cnt = 0, i;
+	struct list_elem *e;
 
-	return NULL;
+	for (victim_cnt = 0; victim_cnt < SWAP_CLUSTER; victim_cnt++)
+	{
+		struct frame *victim = vm_get_victim();
+
+		if (victim == NULL)
+			break;
+		victim->pin_cnt++;
+		victims[victim_cnt] = victim;
+		if (frame_is_dirty(victim))
+			dirty_victims++;
+		else
+			clean_victims++;
+
+		for (e = list_begin(&victim->pages); e != list_end(&victim->pages);
+			 e = list_next(e))
+		{
+			struct page *page = list_entry(e, struct page, frame_elem);
+
+			page->dirty = page_is_dirty(page);
+			pml4_clear_page(page->owner->pml4, page->va);
+
+			if (page->dirty && VM_TYPE(page->operations->type) == VM_ANON)
+			{
+				anon_pages[anon_cnt++] = page;
+				if (anon_cnt == SWAP_CLUSTER)
+				{
+					if (!anon_swap_out_cluster(anon_pages, anon_cnt))
+						PANIC("out of swap space");
+					anon_cnt = 0;
+				}
+			}
+			else if (!swap_out(page))
+				PANIC("out of swap space");
+		}
+	}
+	if (victim_cnt == 0)
+		return NULL;
+	if (anon_cnt > 0 && !anon_swap_out_cluster(anon_pages, anon_cnt))
+		PANIC("out of swap space");
+
+	for (i = 0; i < victim_cnt; i++)
+	{
+		while (!list_empty(&victims[i]->pages))
+			frame_detach(list_entry(list_front(&victims[i]->pages),
+									struct page, frame_elem));
+		if (i > 0)
+			frame_free(victims[i]);
+	}
+	return victims[0];
 }
 
 /* palloc() and get frame. If there is no available page, evict the page
  * and return it. This always return valid address. That is, if the user pool
  * memory is full, this function evicts the frame to get the available memory
  * space.*/
+/* The frame is zeroed and pinned; the caller unpins it once it
+ * has filled it. */
+/* palloc()으로 프레임을 가져옵니다. 가용 페이지가 없으면 페이지를
+ * 내쫓고 그 프레임을 반환합니다. 항상 유효한 주소를 반환합니다.
+ * 프레임은 0으로 채워지고 고정되어 있으며, 호출자가 채운 뒤 고정을
+ * 풉니다. */
 static struct frame *
 vm_get_frame(void)
 {
-	struct frame *frame = NULL;
-	/* TODO: Fill this function. */
+	struct frame *frame;
+	void *kva;
+
+	lock_acquire(&frame_lock);
+	kva = palloc_get_page(PAL_USER | PAL_ZERO);
+	if (kva != NULL)
+	{
+		frame = frame_create(kva);
+		if (frame == NULL)
+			PANIC("out of memory for frame table");
+	}
+	else
+	{
+		frame = vm_evict_frame();
+		if (frame == NULL)
+			PANIC("out of memory: every frame is pinned");
+		memset(frame->kva, 0, PGSIZE);
+	}
+	frame->pin_cnt = 1;
+	lock_release(&frame_lock);
 
 	ASSERT(frame != NULL);
-	ASSERT(frame->page == NULL);
+	ASSERT(frame->ref_cnt == 0);
 	return frame;
 }
 
+/* Gives PAGE, which is about to be read ahead from swap slot
+   SLOT, a pinned frame if PAGE is not in memory, SLOT still holds
+   its contents and a frame is free without evicting anything.
+   Returns true if it did.  Evictions, which move pages between
+   slots, run under frame_lock, so neither can change until the
+   frame is pinned. */
+/* 곧 스왑 슬롯 SLOT에서 미리 읽을 PAGE가 메모리에 없고, SLOT에 아직
+   그 내용이 있으며, 아무것도 내쫓지 않고 얻을 수 있는 프레임이
+   있으면, PAGE에 고정된 프레임을 줍니다. 주었으면 참을 반환합니다.
+   페이지를 슬롯 사이에서 옮기는 내쫓기는 frame_lock 아래에서
+   실행되므로, 프레임이 고정될 때까지 어느 쪽도 바뀔 수 없습니다. */
+bool vm_claim_frame_for_readahead(struct page *page, size_t slot)
+{
+	struct frame *frame = NULL;
+	void *kva;
+
+	lock_acquire(&frame_lock);
+	if (page->frame == NULL && anon_slot_holds(slot, page) &&
+		(kva = palloc_get_page(PAL_USER)) != NULL)
+	{
+		frame = frame_create(kva);
+		if (frame != NULL)
+		{
+			frame_attach(frame, page);
+			frame->pin_cnt = 1;
+		}
+		else
+			palloc_free_page(kva);
+	}
+	lock_release(&frame_lock);
+	return frame != NULL;
+}
+
+/* Maps PAGE, whose frame vm_claim_frame_for_readahead() pinned
+   and which has been read into it, and unpins the frame.  The
+   page is left unaccessed, so that it goes first if it is not
+   used. */
+/* vm_claim_frame_for_readahead()가 프레임을 고정했고 그 프레임으로
+   읽혀 들어온 PAGE를 매핑하고 프레임 고정을 풉니다. 페이지는 접근되지
+   않은 상태로 남아, 쓰이지 않으면 먼저 내쫓깁니다. */
+void vm_readahead_done(struct page *page)
+{
+	if (!pml4_set_page(page->owner->pml4, page->va, page->frame->kva,
+					   page->writable))
+	{
+		struct frame *frame = page->frame;
+
+		lock_acquire(&frame_lock);
+		frame_detach(page);
+		frame_free(frame);
+		lock_release(&frame_lock);
+		return;
+	}
+	page_unpin(page);
+}
+
+/* Makes sure PAGE is in memory and pins its frame.  A frame stays
+   pinned until each page_pin() on it is matched by a
+   page_unpin(). */
+/* PAGE가 메모리에 있게 하고 그 프레임을 고정합니다. 프레임은 그에 대한
+   각 page_pin()이 page_unpin()과 짝을 이룰 때까지 고정된 채로
+   남습니다. */
+static bool
+page_pin(struct page *page)
+{
+	for (;;)
+	{
+		lock_acquire(&frame_lock);
+		if (page->frame != NULL)
+		{
+			page->frame->pin_cnt++;
+			lock_release(&frame_lock);
+			return true;
+		}
+		lock_release(&frame_lock);
+
+		/* It may be evicted again before it can be pinned. */
+		/* 고정하기 전에 다시 내쫓길 수 있습니다. */
+		if (!vm_do_claim_page(page))
+			return false;
+	}
+}
+
+/* Unpins PAGE's frame. */
+/* PAGE의 프레임 고정을 풉니다. */
+static void
+page_unpin(struct page *page)
+{
+	lock_acquire(&frame_lock);
+	ASSERT(page->frame->pin_cnt > 0);
+	page->frame->pin_cnt--;
+	lock_release(&frame_lock);
+}
+
+/* Like page_pin(), but also makes sure that PAGE, which must be
+   writable, is mapped writable, giving it a frame of its own if
+   it shares one copy-on-write. */
+/* page_pin()과 같지만, 쓸 수 있어야 하는 PAGE가 쓰기 가능하게
+   매핑되어 있게도 합니다. copy-on-write로 프레임을 공유하고 있으면
+   자기만의 프레임을 줍니다. */
+static bool
+page_pin_writable(struct page *page)
+{
+	uint64_t *pte;
+	bool ok;
+
+	ASSERT(page->writable);
+
+	for (;;)
+	{
+		if (!page_pin(page))
+			return false;
+		lock_acquire(&frame_lock);
+		pte = pml4e_walk(page->owner->pml4, (uint64_t)page->va, 0);
+		ok = pte != NULL && (*pte & PTE_P) && is_writable(pte);
+		lock_release(&frame_lock);
+		if (ok)
+			return true;
+		page_unpin(page);
+		if (!vm_handle_wp(page))
+			return false;
+	}
+}
+
+/* Brings every page of the current process that the SIZE bytes
+   at BUFFER span into memory and pins it, so that the kernel can
+   reach the buffer without faulting, for example while a file
+   operation holds a disk channel's lock.  If WRITE, the pages are
+   made writable too, which each of them must be.  Returns false,
+   with nothing left pinned, if a page is not in the table. */
+/* BUFFER부터 SIZE 바이트가 걸친 현재 프로세스의 모든 페이지를
+   메모리로 가져와 고정하여, 예를 들어 파일 작업이 디스크 채널의 락을
+   잡고 있는 동안에도 커널이 오류 없이 버퍼에 접근할 수 있게 합니다.
+   WRITE이면 페이지를 쓰기 가능하게도 만들며, 각 페이지는 쓸 수 있는
+   페이지여야 합니다. 테이블에 없는 페이지가 있으면 아무것도 고정하지
+   않은 채로 false를 반환합니다. */
+bool vm_pin_buffer(const void *buffer, size_t size, bool write)
+{
+	struct supplemental_page_table *spt = &thread_current()->spt;
+	uint8_t *start = pg_round_down(buffer);
+	uint8_t *end = (uint8_t *)buffer + size;
+	uint8_t *va;
+
+	if (size == 0)
+		return true;
+	for (va = start; va < end; va += PGSIZE)
+	{
+		struct page *page = spt_find_page(spt, va);
+
+		if (page == NULL ||
+			!(write ? page_pin_writable(page) : page_pin(page)))
+		{
+			vm_unpin_buffer(start, va - start);
+			return false;
+		}
+	}
+	return true;
+}
+
+/* Unpins the pages that vm_pin_buffer() pinned for the SIZE bytes
+   at BUFFER. */
+/* vm_pin_buffer()가 BUFFER부터 SIZE 바이트를 위해 고정한 페이지들의
+   고정을 풉니다. */
+void vm_unpin_buffer(const void *buffer, size_t size)
+{
+	struct supplemental_page_table *spt = &thread_current()->spt;
+	uint8_t *end = (uint8_t *)buffer + size;
+	uint8_t *va;
+
+	if (size == 0)
+		return;
+	for (va = pg_round_down(buffer); va < end; va += PGSIZE)
+		page_unpin(spt_find_page(spt, va));
+}
+
+/* Returns true if bringing PAGE into memory means reading it from
+   disk. */
+/* PAGE를 메모리로 가져오려면 디스크에서 읽어야 하면 참을
+   반환합니다. */
+static bool
+page_on_disk(struct page *page)
+{
+	switch (VM_TYPE(page->operations->type))
+	{
+	case VM_UNINIT:
+		return page->uninit.init != NULL;
+	case VM_ANON:
+		return page->anon.slot != SWAP_SLOT_NONE;
+	default:
+		return true;
+	}
+}
+
+/* Returns true if PAGE is an anonymous page that was never
+   written, so that it reads as zeros until its first write. */
+/* PAGE가 한 번도 쓰이지 않은 익명 페이지여서 처음 쓰기 전까지 0으로
+   읽히면 참을 반환합니다. */
+static bool
+page_reads_as_zero(struct page *page)
+{
+	return page_get_type(page) == VM_ANON && !page_on_disk(page);
+}
+
+/* Maps the shared zero page read-only at PAGE's address, if PAGE
+   has no frame and reads as zeros.  Returns true if it did. */
+/* PAGE에 프레임이 없고 0으로 읽히면 PAGE의 주소에 공유 0 페이지를
+   읽기 전용으로 매핑합니다. 매핑했으면 참을 반환합니다. */
+static bool
+page_map_zero(struct page *page)
+{
+	bool ok;
+
+	lock_acquire(&frame_lock);
+	ok = page->frame == NULL && page_reads_as_zero(page) &&
+		 pml4_set_page(page->owner->pml4, page->va, zero_kva, false);
+	if (ok)
+	{
+		zero_hits++;
+		page->owner->zero_page_hits++;
+		page->owner->zero_pages++;
+	}
+	lock_release(&frame_lock);
+	return ok;
+}
+
+/* Removes the mapping of the shared zero page at PAGE's address,
+   if there is one.  PAGE must have no frame. */
+/* PAGE의 주소에 공유 0 페이지의 매핑이 있으면 제거합니다. PAGE에는
+   프레임이 없어야 합니다. */
+static void
+page_unmap_zero(struct page *page)
+{
+	uint64_t *pml4 = page->owner->pml4;
+
+	ASSERT(page->frame == NULL);
+
+	if (page_reads_as_zero(page) && pml4_get_page(pml4, page->va) == zero_kva)
+	{
+		pml4_clear_page(pml4, page->va);
+		page->owner->zero_pages--;
+	}
+}
+
+/* Brings PAGE, which a write faulted on, into memory along with
+   the rest of the 2 MB region around it under one large page, as
+   described at the top of this file.  Returns true if it did. */
+/* 쓰기 오류가 난 PAGE를 그 주위의 2 MB 영역 나머지와 함께, 이 파일
+   위쪽에서 설명한 대로 대형 페이지 하나로 메모리에 가져옵니다.
+   가져왔으면 참을 반환합니다. */
+static bool
+vm_claim_large_page(struct page *page)
+{
+	struct supplemental_page_table *spt = &page->owner->spt;
+	uint64_t *pml4 = page->owner->pml4;
+	uint8_t *base = (uint8_t *)page->va - lpg_ofs(page->va);
+	uint64_t *pde = pml4e_walk_pde(pml4, (uint64_t)base, 0);
+	size_t free_cnt, total, cnt, i;
+	uint8_t *kva;
+	bool ok;
+
+	if (pde != NULL && (*pde & PTE_P))
+		return false;
+
+	lock_acquire(&frame_lock);
+	for (i = 0; i < LPGCNT; i++)
+	{
+		struct page *p = spt_find_page(spt, base + i * PGSIZE);
+
+		if (p == NULL || p->frame != NULL || !page_reads_as_zero(p) ||
+			p->writable != page->writable)
+		{
+			lock_release(&frame_lock);
+			return false;
+		}
+	}
+	free_cnt = palloc_user_free_cnt(&total);
+	kva = free_cnt >= LPGCNT + total / 2
+			  ? palloc_get_multiple(PAL_USER | PAL_ZERO, LPGCNT)
+			  : NULL;
+	if (kva == NULL || lpg_ofs(vtop(kva)) != 0)
+	{
+		palloc_free_multiple(kva, LPGCNT);
+		lock_release(&frame_lock);
+		return false;
+	}
+
+	/* Nothing is read in: every page of the region reads as
+	   zeros, so swap_in() only gives an uninitialized one its
+	   anonymous type. */
+	/* 아무것도 읽어 들이지 않습니다. 영역의 모든 페이지가 0으로
+	   읽히므로, swap_in()은 초기화되지 않은 페이지에 익명 타입만
+	   줍니다. */
+	for (cnt = 0; cnt < LPGCNT; cnt++)
+	{
+		struct page *p = spt_find_page(spt, base + cnt * PGSIZE);
+		struct frame *frame = frame_create(kva + cnt * PGSIZE);
+
+		if (frame == NULL)
+			break;
+		frame_attach(frame, p);
+		swap_in(p, frame->kva);
+	}
+	ok = cnt == LPGCNT &&
+		 pml4_set_large_page(pml4, base, kva, page->writable);
+	if (ok)
+	{
+		pml4_set_accessed(pml4, page->va, true);
+		large_claims++;
+	}
+	else
+	{
+		for (i = 0; i < cnt; i++)
+		{
+			struct page *p = spt_find_page(spt, base + i * PGSIZE);
+			struct frame *frame = p->frame;
+
+			frame_detach(p);
+			frame_free(frame);
+		}
+		palloc_free_multiple(kva + cnt * PGSIZE, LPGCNT - cnt);
+	}
+	lock_release(&frame_lock);
+	return ok;
+}
+
 /* Growing the stack. */
 static void
 vm_stack_growth(void *addr UNUSED)
@@ -132,21 +963,113 @@ vm_stack_growth(void *addr UNUSED)
 }
 
 /* Handle the fault on write_protected page */
+/* Resolves a write fault on PAGE, which may be written but is
+   mapped read-only because its frame is shared copy-on-write or
+   because it maps the shared zero page.  If no other page is left
+   on the frame, the mapping is just made writable; otherwise PAGE
+   gets a copy of the frame of its own, or a zeroed frame in place
+   of the zero page.
+   The old frame is pinned while it is copied, and cannot change
+   meanwhile, since every page still on it is mapped read-only. */
+/* 쓰기 보호된 페이지의 오류를 처리합니다.
+   쓸 수 있지만 프레임을 copy-on-write로 공유하고 있거나 공유 0
+   페이지를 매핑하고 있어 읽기 전용으로 매핑된 PAGE에서 난 쓰기 오류를
+   해결합니다. 프레임에 다른 페이지가 남아 있지 않으면 매핑을 쓰기
+   가능하게만 바꾸고, 아니면 PAGE에 자기만의 프레임 사본을, 0 페이지
+   대신에는 0으로 채운 프레임을 줍니다. 복사하는 동안 이전 프레임은 고정되며,
+   그 위의 모든 페이지가 읽기 전용으로 매핑되어 있으므로 그동안 바뀌지
+   않습니다. */
 static bool
-vm_handle_wp(struct page *page UNUSED)
+vm_handle_wp(struct page *page)
 {
+	uint64_t *pml4 = page->owner->pml4;
+	struct frame *old, *new;
+	bool ok;
+
+	lock_acquire(&frame_lock);
+	old = page->frame;
+	if (old == NULL)
+	{
+		/* PAGE maps the zero page, or was evicted since the fault;
+		   either way, it needs a frame. */
+		/* PAGE가 0 페이지를 매핑하고 있거나 오류 이후 내쫓겼습니다.
+		   어느 쪽이든 프레임이 필요합니다. */
+		lock_release(&frame_lock);
+		return vm_do_claim_page(page);
+	}
+	if (old->ref_cnt == 1)
+	{
+		ok = pml4_set_writable(pml4, page->va, true);
+		if (ok)
+			cow_reused++;
+		lock_release(&frame_lock);
+		return ok;
+	}
+	old->pin_cnt++;
+	lock_release(&frame_lock);
+
+	new = vm_get_frame();
+	memcpy(new->kva, old->kva, PGSIZE);
+
+	lock_acquire(&frame_lock);
+	page->dirty = page_is_dirty(page);
+	pml4_clear_page(pml4, page->va);
+	frame_detach(page);
+	old->pin_cnt--;
+	if (old->ref_cnt == 0)
+		frame_free(old);
+	frame_attach(new, page);
+	cow_copied++;
+	lock_release(&frame_lock);
+
+	if (!pml4_set_page(pml4, page->va, new->kva, true))
+	{
+		lock_acquire(&frame_lock);
+		frame_detach(page);
+		frame_free(new);
+		lock_release(&frame_lock);
+		return false;
+	}
+	pml4_set_accessed(pml4, page->va, true);
+	page_unpin(page);
+	return true;
 }
 
 /* Return true on success */
-bool vm_try_handle_fault(struct intr_frame *f UNUSED, void *addr UNUSED,
-						 bool user UNUSED, bool write UNUSED, bool not_present UNUSED)
+/* 성공하면 참을 반환합니다. */
+bool vm_try_handle_fault(struct intr_frame *f UNUSED, void *addr,
+						 bool user UNUSED, bool write, bool not_present)
 {
-	struct supplemental_page_table *spt UNUSED = &thread_current()->spt;
-	struct page *page = NULL;
-	/* TODO: Validate the fault */
-	/* TODO: Your code goes here */
+	struct thread *curr = thread_current();
+	struct page *page;
+	bool major;
 
-	return vm_do_claim_page(page);
+	/* Only faults on pages that are in the table but not yet in
+	   memory, and writes to pages shared copy-on-write, can be
+	   handled. */
+	/* 테이블에 있지만 아직 메모리에 없는 페이지의 오류와
+	   copy-on-write로 공유된 페이지에 대한 쓰기만 처리할 수 있습니다. */
+	if (addr == NULL)
+		return false;
+	page = spt_find_page(&curr->spt, addr);
+	if (page == NULL || (write && !page->writable))
+		return false;
+	if (!not_present)
+		return write && vm_handle_wp(page);
+	if (!write && page_map_zero(page))
+		return true;
+	if (write && vm_claim_large_page(page))
+		return true;
+
+	/* A page whose contents have to be read in makes the fault
+	   major. */
+	/* 내용을 읽어 들여야 하는 페이지는 오류를 major로 만듭니다. */
+	major = page_on_disk(page);
+	if (!vm_do_claim_page(page))
+		return false;
+	if (major)
+		curr->major_faults++;
+	return true;
 }
 
 /* Free the page.
@@ -154,50 +1077,189 @@ bool vm_try_handle_fault(struct intr_frame *f UNUSED, void *addr UNUSED,
 void vm_dealloc_page(struct page *page)
 {
 	destroy(page);
-	free(page);
+	kmem_cache_free(vm_page_cache, page);
 }
 
 /* Claim the page that allocate on VA. */
-bool vm_claim_page(void *va UNUSED)
+/* VA에 할당된 페이지를 확보합니다. */
+bool vm_claim_page(void *va)
 {
-	struct page *page = NULL;
-	/* TODO: Fill this function */
+	struct page *page = spt_find_page(&thread_current()->spt, va);
 
+	if (page == NULL || page->frame != NULL)
+		return false;
 	return vm_do_claim_page(page);
 }
 
-/* Claim the PAGE and set up the mmu. */
+/* Claim the PAGE and set up the mmu.  Pages read in from the
+   executable are marked dirty, since nothing backs them.  A
+   mapping of the zero page is replaced. */
+/* PAGE를 확보하고 MMU를 설정합니다. 실행 파일에서 읽어 온 페이지는
+   뒷받침하는 저장소가 없으므로 dirty로 표시합니다. 0 페이지의 매핑은
+   대체됩니다. */
 static bool
 vm_do_claim_page(struct page *page)
 {
 	struct frame *frame = vm_get_frame();
+	bool loaded = VM_TYPE(page->operations->type) == VM_UNINIT &&
+				  page->uninit.init != NULL;
 
 	/* Set links */
-	frame->page = page;
-	page->frame = frame;
+	lock_acquire(&frame_lock);
+	page_unmap_zero(page);
+	frame_attach(frame, page);
+	lock_release(&frame_lock);
 
-	/* TODO: Insert page table entry to map page's VA to frame's PA. */
+	if (!swap_in(page, frame->kva) ||
+		!pml4_set_page(page->owner->pml4, page->va, frame->kva,
+					   page->writable))
+	{
+		lock_acquire(&frame_lock);
+		frame_detach(page);
+		frame_free(frame);
+		lock_release(&frame_lock);
+		return false;
+	}
+	if (loaded)
+		page->dirty = true;
 
-	return swap_in(page, frame->kva);
+	/* Count the fault that brought the page in as an access, so
+	   that the page is not evicted before the access is retried. */
+	/* 페이지를 가져온 오류를 접근으로 쳐서, 접근을 다시 시도하기 전에
+	   페이지가 내쫓기지 않게 합니다. */
+	pml4_set_accessed(page->owner->pml4, page->va, true);
+	page_unpin(page);
+	return true;
 }
 
 /* Initialize new supplemental page table */
 /* 새 보조 페이지 테이블 초기화 */
-void supplemental_page_table_init(struct supplemental_page_table *spt UNUSED)
+void supplemental_page_table_init(struct supplemental_page_table *spt)
+{
+	spt->root = NULL;
+}
+
+/* Copies PAGE, from the parent's table, into the current
+   thread's table.  A page that is still to be read from a file
+   or swap is read in for the parent first, so that the child
+   never depends on the parent's loader state; one that still
+   reads as zeros, even if it maps the zero page, stays lazy in
+   both.  The child's page then shares
+   the parent's frame, and both are mapped read-only until one of
+   them writes.  The parent's PTE keeps its dirty bit, so the
+   parent's page still knows whether its slot is stale; the
+   child's has no slot and is marked dirty. */
+/* 부모의 테이블에 있는 PAGE를 현재 스레드의 테이블로 복사합니다.
+   아직 파일이나 스왑에서 읽어야 하는 페이지는 먼저 부모 쪽에서 읽어
+   들여, 자식이 부모의 로더 상태에 기대지 않게 합니다. 아직 0으로
+   읽히는 페이지는 0 페이지를 매핑하고 있더라도 양쪽 모두에서 지연된
+   채로 남습니다. 그다음
+   자식의 페이지는 부모의 프레임을 공유하며, 어느 한쪽이 쓸 때까지
+   양쪽 모두 읽기 전용으로 매핑됩니다. 부모의 PTE는 dirty 비트를
+   유지하므로 부모의 페이지는 자기 슬롯이 낡았는지 여전히 알 수
+   있습니다. 자식의 페이지는 슬롯이 없으며 dirty로 표시됩니다. */
+static bool
+spt_copy_page(struct page *src)
+{
+	struct page *dst;
+	struct frame *frame;
+
+	if (VM_TYPE(src->operations->type) == VM_UNINIT &&
+		src->uninit.init == NULL)
+		return vm_alloc_page(src->uninit.type, src->va, src->writable);
+	if (src->frame == NULL && page_reads_as_zero(src))
+		return vm_alloc_page(VM_ANON, src->va, src->writable);
+
+	if (!vm_alloc_page(page_get_type(src), src->va, src->writable))
+		return false;
+	dst = spt_find_page(&thread_current()->spt, src->va);
+	if (!page_pin(src))
+		return false;
+	frame = src->frame;
+
+	/* DST has no initializer, so this only gives it SRC's type;
+	   the shared frame is left as it is. */
+	/* DST에는 초기화 함수가 없으므로 이것은 DST에 SRC의 타입만 줄 뿐,
+	   공유하는 프레임은 그대로 둡니다. */
+	if (!swap_in(dst, frame->kva) ||
+		!pml4_set_page(dst->owner->pml4, dst->va, frame->kva, false))
+	{
+		page_unpin(src);
+		return false;
+	}
+	if (src->writable)
+		pml4_set_writable(src->owner->pml4, src->va, false);
+
+	lock_acquire(&frame_lock);
+	frame_attach(frame, dst);
+	dst->dirty = true;
+	cow_shared++;
+	lock_release(&frame_lock);
+
+	page_unpin(src);
+	return true;
+}
+
+/* Copies the pages below NODE, which is at LEVEL in the parent's
+   table, visiting only the subtrees that are populated. */
+/* 부모 테이블의 LEVEL 단계에 있는 NODE 아래의 페이지를 복사하며,
+   채워진 하위 트리만 방문합니다. */
+static bool
+spt_copy_node(void **node, int level)
 {
+	size_t i;
+
+	for (i = 0; i < SPT_FANOUT; i++)
+		if (node[i] != NULL)
+		{
+			bool ok = level == SPT_LEVELS - 1
+						  ? spt_copy_page(node[i])
+						  : spt_copy_node(node[i], level + 1);
+			if (!ok)
+				return false;
+		}
+	return true;
 }
 
-/* Copy supplemental page table from src to dst */
-bool supplemental_page_table_copy(struct supplemental_page_table *dst UNUSED,
-								  struct supplemental_page_table *src UNUSED)
+/* Copy supplemental page table from src to dst.  DST must be
+   the current thread's table. */
+/* src의 보조 페이지 테이블을 dst로 복사합니다. DST는 현재 스레드의
+   테이블이어야 합니다. */
+bool supplemental_page_table_copy(struct supplemental_page_table *dst,
+								  struct supplemental_page_table *src)
 {
+	ASSERT(dst == &thread_current()->spt);
+
+	return src->root == NULL || spt_copy_node(src->root, 0);
+}
+
+/* Frees NODE, which is at LEVEL, and everything below it,
+   visiting only the subtrees that are populated. */
+/* LEVEL 단계에 있는 NODE와 그 아래의 모든 것을 해제하며, 채워진
+   하위 트리만 방문합니다. */
+static void
+spt_free_node(void **node, int level)
+{
+	size_t i;
+
+	for (i = 0; i < SPT_FANOUT; i++)
+		if (node[i] != NULL)
+		{
+			if (level == SPT_LEVELS - 1)
+				spt_free_page(node[i]);
+			else
+				spt_free_node(node[i], level + 1);
+		}
+	palloc_free_page(node);
 }
 
-/* Free the resource hold by the supplemental page table */
-/* 보조 페이지 테이블로 리소스 보유를 해제합니다. */
-void supplemental_page_table_kill(struct supplemental_page_table *spt UNUSED)
+/* Free the resource hold by the supplemental page table.  The
+   table is left empty and may be used again. */
+/* 보조 페이지 테이블로 리소스 보유를 해제합니다. 테이블은 비어 있는
+   상태로 남아 다시 쓸 수 있습니다. */
+void supplemental_page_table_kill(struct supplemental_page_table *spt)
 {
-	/* TODO: Destroy all the supplemental_page_table hold by thread and
-	 * TODO: writeback all the modified contents to the storage. */
-	/* TODO: 스레드별로 모든 supplemental_page_table 홀드를 삭제하고 수정된 모든 내용을 스토리지에 다시 씁니다. */
+	if (spt->root != NULL)
+		spt_free_node(spt->root, 0);
+	spt->root = NULL;
 }